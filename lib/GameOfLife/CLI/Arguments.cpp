@@ -3,6 +3,7 @@
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <stdexcept>
 
 #include "File/Utils.h"
 
@@ -31,6 +32,12 @@ namespace GameOfLife::CLI {
             return {"", "", 1000, 100, false, true, false, false, false, false, false, true, '1', '0', ' '};
         }
 
+        // Check for benchmarks
+        if (argc == 2 && (strcmp(argv[1], "-b") == 0 || strcmp(argv[1], "--benchmark") == 0)) {
+            return {"", "", 1000, 100, false, true, false, false, false, false, false, false, '1', '0', ' ',
+                Engine::STANDARD, 0, 512, true};
+        }
+
         // Check for the minimum number of arguments
         if (argc < 3) {
             printHelp();
@@ -63,6 +70,19 @@ namespace GameOfLife::CLI {
         char aliveChar = '1';
         char deadChar = '0';
         char separator = ' ';
+        Engine engine = Engine::STANDARD;
+        int stepExponent = 0;
+        int memoryLimit = 512;
+        std::optional<Game::IsotropicRule> rule;
+        std::optional<Game::LargerThanLifeRule> rangeRule;
+        std::optional<Game::GenerationsRule> generationsRule;
+        std::optional<Game::LeniaRule> leniaRule;
+        int maxPeriod = 64;
+        Game::Topology topology = Game::Topology::TORUS;
+        int blockDepth = 1;
+        int tileCache = 0;
+        std::optional<std::pair<float, float>> stochastic;
+        uint64_t seed = 0;
 
         // Parse the arguments
         for (int i = 1; i < argc; i++) {
@@ -84,6 +104,21 @@ namespace GameOfLife::CLI {
                     i++;
                 }
             }
+            if (arg == "-l" || arg == "--max-period") {
+                if (i + 1 < argc) {
+                    try {
+                        maxPeriod = std::stoi(argv[i + 1]);
+                    } catch ([[maybe_unused]] std::invalid_argument &e) {
+                        std::cerr << "Invalid maximum period: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    if (maxPeriod < 0) {
+                        std::cerr << "Invalid maximum period: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    i++;
+                }
+            }
             if (arg == "-x" || arg == "--delay") {
                 if (i + 1 < argc) {
                     try {
@@ -110,6 +145,17 @@ namespace GameOfLife::CLI {
             if (arg == "-w" || arg == "--warp") {
                 warp = true;
             }
+            if (arg == "-o" || arg == "--topology") {
+                if (i + 1 < argc) {
+                    if (!parseTopology(argv[i + 1], topology)) {
+                        std::cerr << "Invalid topology: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    // A plane does not wrap, the other topologies do
+                    warp = topology != Game::Topology::PLANE;
+                    i++;
+                }
+            }
             if (arg == "-y" || arg == "--dynamic") {
                 dynamic = true;
             }
@@ -151,11 +197,121 @@ namespace GameOfLife::CLI {
                     i++;
                 }
             }
+
+            // Engine argument
+            if (arg == "-n" || arg == "--engine") {
+                if (i + 1 < argc) {
+                    if (!parseEngine(argv[i + 1], engine)) {
+                        std::cerr << "Invalid engine: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    i++;
+                }
+            }
+            if (arg == "-k" || arg == "--step-exponent") {
+                if (i + 1 < argc) {
+                    try {
+                        stepExponent = std::stoi(argv[i + 1]);
+                    } catch ([[maybe_unused]] std::invalid_argument &e) {
+                        std::cerr << "Invalid step exponent: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    if (stepExponent < 0 || stepExponent > 59) {
+                        std::cerr << "Invalid step exponent: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    i++;
+                }
+            }
+            if (arg == "-r" || arg == "--rule") {
+                if (i + 1 < argc) {
+                    Game::IsotropicRule parsed;
+                    Game::LargerThanLifeRule parsedRange;
+                    Game::GenerationsRule parsedGenerations;
+                    Game::LeniaRule parsedLenia;
+                    if (parseRule(argv[i + 1], parsed))
+                        rule = parsed;
+                    else if (parseRule(argv[i + 1], parsedRange))
+                        rangeRule = parsedRange;
+                    else if (parseRule(argv[i + 1], parsedGenerations))
+                        generationsRule = parsedGenerations;
+                    else if (parseRule(argv[i + 1], parsedLenia))
+                        leniaRule = parsedLenia;
+                    else {
+                        std::cerr << "Invalid rule: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    i++;
+                }
+            }
+            if (arg == "-c" || arg == "--stochastic") {
+                if (i + 1 < argc) {
+                    std::pair<float, float> probabilities;
+                    if (!parseStochastic(argv[i + 1], probabilities)) {
+                        std::cerr << "Invalid probabilities: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    stochastic = probabilities;
+                    i++;
+                }
+            }
+            if (arg == "-z" || arg == "--seed") {
+                if (i + 1 < argc) {
+                    try {
+                        seed = std::stoull(argv[i + 1]);
+                    } catch ([[maybe_unused]] std::exception &e) {
+                        std::cerr << "Invalid seed: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    i++;
+                }
+            }
+            if (arg == "-j" || arg == "--block-depth") {
+                if (i + 1 < argc) {
+                    try {
+                        blockDepth = std::string(argv[i + 1]) == "auto" ? 0 : std::stoi(argv[i + 1]);
+                    } catch ([[maybe_unused]] std::invalid_argument &e) {
+                        std::cerr << "Invalid block depth: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    if (blockDepth < 0 || blockDepth > 64) {
+                        std::cerr << "Invalid block depth: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    i++;
+                }
+            }
+            if (arg == "-q" || arg == "--tile-cache") {
+                if (i + 1 < argc) {
+                    try {
+                        tileCache = std::stoi(argv[i + 1]);
+                    } catch ([[maybe_unused]] std::invalid_argument &e) {
+                        std::cerr << "Invalid tile cache size: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    if (tileCache < 0) {
+                        std::cerr << "Invalid tile cache size: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    i++;
+                }
+            }
+            if (arg == "-m" || arg == "--memory-limit") {
+                if (i + 1 < argc) {
+                    try {
+                        memoryLimit = std::stoi(argv[i + 1]);
+                    } catch ([[maybe_unused]] std::invalid_argument &e) {
+                        std::cerr << "Invalid memory limit: " << argv[i + 1] << std::endl;
+                        return {};
+                    }
+                    i++;
+                }
+            }
         }
 
         // Return the parsed arguments
         return {inputFile, outputFolder, generations, delay, highPerformance, endIfStatic, interactive,
-            warp, dynamic, verbose, GUI, false, aliveChar, deadChar, separator};
+            warp, dynamic, verbose, GUI, false, aliveChar, deadChar, separator, engine, stepExponent, memoryLimit, false, rule, rangeRule, generationsRule, stochastic, seed, leniaRule, maxPeriod, topology, blockDepth, tileCache};
     }
 
     /**
@@ -224,6 +380,17 @@ namespace GameOfLife::CLI {
         std::cin >> guiStr;
         bool GUI = guiStr == "y";
 
+        Engine engine = Engine::STANDARD;
+        if (highPerformance) {
+            std::cout << "Engine (standard/packed/hashlife/tiled/frontier/incremental): ";
+            std::string engineStr;
+            std::cin >> engineStr;
+            if (!parseEngine(engineStr, engine)) {
+                std::cerr << "Invalid engine: " << engineStr << std::endl;
+                return {};
+            }
+        }
+
         // Clear the input buffer
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
 
@@ -240,7 +407,7 @@ namespace GameOfLife::CLI {
         std::getline(std::cin, separator);
 
         Arguments interactiveArguments(filePath, outputFolder, maxGenerations, delay, highPerformance,
-            endIfStatic, true, warp, dynamic, verbose, GUI, false, aliveChar[0], deadChar[0], separator[0]);
+            endIfStatic, true, warp, dynamic, verbose, GUI, false, aliveChar[0], deadChar[0], separator[0], engine);
 
         return interactiveArguments;
     }
@@ -255,15 +422,252 @@ namespace GameOfLife::CLI {
         std::cout << "  -g, --generations <n>\t\tNumber of generations to simulate (default: 1000)\n";
         std::cout << "  -x, --delay <ms>\t\tDelay between generations in milliseconds (default: 100)\n";
         // std::cout << "  -p, --high-performance\tUse high performance mode\n";
-        std::cout << "  -s, --end-if-static\t\tEnd simulation if the grid is static or does not evolve\n";
+        std::cout << "  -s, --end-if-static\t\tEnd simulation if the grid is static or repeats itself\n";
+        std::cout << "  -l, --max-period <n>\t\tLongest period detected, in generations, 0 to disable (default: 64)\n";
         std::cout << "  -w, --wrap\t\t\tWarp around the grid (toroidal grid)\n";
+        std::cout << "  -o, --topology <name>\t\tHow the edges are joined: plane, torus, klein, cross (default: plane, torus with -w),\n";
+        std::cout << "\t\t\t\tklein and cross run on the standard, frontier and incremental engines\n";
         std::cout << "  -y, --dynamic\t\t\tDynamic grid size (takes priority on wrap)\n";
         std::cout << "  -v, --verbose\t\t\tDisplay extended informations\n";
         std::cout << "  -a, --alive-char <c>\t\tCharacter to represent alive cells (default: 1, unused if file is .cells or .rle)\n";
         std::cout << "  -d, --dead-char <c>\t\tCharacter to represent dead cells (default: 0, unused if file is .cells or .rle)\n";
         std::cout << "  -e, --separator <c>\t\tCharacter to separate cells (default: space, unused if file is .cells or .rle)\n";
+        std::cout << "  -n, --engine <name>\t\tGrid engine for .cells and .rle files: standard, packed, hashlife, tiled, frontier, incremental (default: standard)\n";
+        std::cout << "  -r, --rule <rule>\t\tRule in B/S (B36/S23) or Hensel (B2n3/S23-q) notation, or by name: conway, highlife,\n";
+        std::cout << "\t\t\t\tseeds, daynight, lifewithoutdeath, maze, or Larger than Life (R5,C0,M1,S34..58,B34..45,NM),\n";
+        std::cout << "\t\t\t\tor Generations (B2/S/C3, briansbrain, starwars) or LifeHistory,\n";
+        std::cout << "\t\t\t\tor Lenia (R=13;T=10;m=0.15;s=0.015;b=1, lenia)\n";
+        std::cout << "\t\t\t\t(default: rule of the RLE file, else B3/S23)\n";
+        std::cout << "  -k, --step-exponent <k>\tHashLife engine: advance 2^k generations per step (default: 0)\n";
+        std::cout << "  -m, --memory-limit <MB>\tHashLife engine: node cache size before garbage collection (default: 512)\n";
+        std::cout << "  -j, --block-depth <k|auto>\tPacked engine: advance k generations per step, each cache-sized band of the grid\n";
+        std::cout << "\t\t\t\tbeing read once for the k generations (default: 1, auto blocks the grids larger than the cache)\n";
+        std::cout << "  -q, --tile-cache <n>\t\tTiled engine: cache the next state of up to n tiles with their border, so\n";
+        std::cout << "\t\t\t\toscillating tiles are looked up instead of computed, 1 KiB per tile (default: 0, disabled)\n";
+        std::cout << "  -c, --stochastic <b>[,<s>]\tKeep each birth with probability b and each survival with probability s\n";
+        std::cout << "\t\t\t\t(default: 1), runs on the packed engine\n";
+        std::cout << "  -z, --seed <n>\t\t\tSeed of the stochastic mode, a seed gives the same run on any machine (default: 0)\n";
         std::cout << "  -i, --interactive\t\tInteractive mode (overwrites other options)\n";
         std::cout << "  -u, --user-interface\t\t\tStart the GUI (some options will carry over)\n";
         std::cout << "  -t, --unit-tests\t\tRun the unit tests\n";
+        std::cout << "  -b, --benchmark\t\tRun the benchmarks\n";
+    }
+
+    /**
+     * Parse the name of a topology.
+     *
+     * @param name The topology name
+     * @param topology The parsed topology, to be set by the function
+     * @return True if the name is a known topology, false otherwise
+     */
+    bool Arguments::parseTopology(const std::string &name, Game::Topology &topology) {
+        if (name == "plane") {
+            topology = Game::Topology::PLANE;
+            return true;
+        }
+        if (name == "torus") {
+            topology = Game::Topology::TORUS;
+            return true;
+        }
+        if (name == "klein") {
+            topology = Game::Topology::KLEIN_BOTTLE;
+            return true;
+        }
+        if (name == "cross") {
+            topology = Game::Topology::CROSS_SURFACE;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Parse the name of a grid engine.
+     *
+     * @param name The engine name
+     * @param engine The parsed engine, to be set by the function
+     * @return True if the name is a known engine, false otherwise
+     */
+    bool Arguments::parseEngine(const std::string &name, Engine &engine) {
+        if (name == "standard") {
+            engine = Engine::STANDARD;
+            return true;
+        }
+        if (name == "packed") {
+            engine = Engine::PACKED;
+            return true;
+        }
+        if (name == "hashlife") {
+            engine = Engine::HASHLIFE;
+            return true;
+        }
+        if (name == "tiled") {
+            engine = Engine::TILED;
+            return true;
+        }
+        if (name == "frontier") {
+            engine = Engine::FRONTIER;
+            return true;
+        }
+        if (name == "incremental") {
+            engine = Engine::INCREMENTAL;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Parse the name of a rule, its B/S or S/B notation, or its Hensel notation.
+     *
+     * @param name The rule name
+     * @param rule The parsed rule, to be set by the function
+     * @return True if the name is a valid rule, false otherwise
+     */
+    bool Arguments::parseRule(const std::string &name, Game::IsotropicRule &rule) {
+        try {
+            rule = Game::IsotropicRule::parse(name);
+            return true;
+        } catch (const std::invalid_argument &) {
+            return false;
+        }
+    }
+
+    /**
+     * Parse the probabilities of the stochastic mode, a birth probability and an optional survival probability.
+     *
+     * @param text The probabilities, separated by a comma
+     * @param probabilities The birth and survival probabilities, to be set by the function
+     * @return True if both probabilities are numbers in [0, 1], false otherwise
+     */
+    bool Arguments::parseStochastic(const std::string &text, std::pair<float, float> &probabilities) {
+        const size_t comma = text.find(',');
+        try {
+            size_t end;
+            const std::string birth = text.substr(0, comma);
+            probabilities.first = std::stof(birth, &end);
+            if (end != birth.size())
+                return false;
+            probabilities.second = 1;
+            if (comma != std::string::npos) {
+                const std::string survival = text.substr(comma + 1);
+                probabilities.second = std::stof(survival, &end);
+                if (end != survival.size())
+                    return false;
+            }
+        } catch (const std::exception &) {
+            return false;
+        }
+        return probabilities.first >= 0 && probabilities.first <= 1 &&
+            probabilities.second >= 0 && probabilities.second <= 1;
+    }
+
+    /**
+     * Parse a rule in Larger than Life notation.
+     *
+     * @param name The rule notation
+     * @param rule The parsed rule, to be set by the function
+     * @return True if the notation is a valid Larger than Life rule, false otherwise
+     */
+    bool Arguments::parseRule(const std::string &name, Game::LargerThanLifeRule &rule) {
+        try {
+            rule = Game::LargerThanLifeRule::parse(name);
+            return true;
+        } catch (const std::invalid_argument &) {
+            return false;
+        }
+    }
+
+    /**
+     * Parse a multi-state rule, in Generations notation or LifeHistory.
+     *
+     * @param name The rule notation
+     * @param rule The parsed rule, to be set by the function
+     * @return True if the notation is a valid multi-state rule, false otherwise
+     */
+    bool Arguments::parseRule(const std::string &name, Game::GenerationsRule &rule) {
+        try {
+            rule = Game::GenerationsRule::parse(name);
+            return true;
+        } catch (const std::invalid_argument &) {
+            return false;
+        }
+    }
+
+    /**
+     * Parse a rule in Lenia notation.
+     *
+     * @param name The rule notation
+     * @param rule The parsed rule, to be set by the function
+     * @return True if the notation is a valid Lenia rule, false otherwise
+     */
+    bool Arguments::parseRule(const std::string &name, Game::LeniaRule &rule) {
+        try {
+            rule = Game::LeniaRule::parse(name);
+            return true;
+        } catch (const std::invalid_argument &) {
+            return false;
+        }
+    }
+
+    /**
+     * Get the rule to simulate: the rule given on the command line, else the rule of the input file, else B3/S23.
+     *
+     * @param fileRule The rule of the input file, empty if there is none
+     * @return The rule to simulate
+     */
+    Game::IsotropicRule Arguments::resolveRule(const std::string &fileRule) const {
+        if (rule)
+            return *rule;
+        Game::IsotropicRule parsed;
+        if (!fileRule.empty() && !parseRule(fileRule, parsed))
+            std::cerr << "Unsupported rule " << fileRule << ", using B3/S23" << std::endl;
+        return parsed;
+    }
+
+    /**
+     * Get the Larger than Life rule to simulate, if any: the rule given on the command line, else the rule of the input
+     * file. Such a rule runs on the Larger than Life engine, whatever the requested engine.
+     *
+     * @param fileRule The rule of the input file, empty if there is none
+     * @return The Larger than Life rule, or nothing if the rule to simulate is a Life-like rule
+     */
+    std::optional<Game::LargerThanLifeRule> Arguments::resolveRangeRule(const std::string &fileRule) const {
+        if (rangeRule || rule || generationsRule || leniaRule)
+            return rangeRule;
+        Game::LargerThanLifeRule parsed;
+        if (!fileRule.empty() && parseRule(fileRule, parsed))
+            return parsed;
+        return std::nullopt;
+    }
+
+    /**
+     * Get the multi-state rule to simulate, if any: the rule given on the command line, else the rule of the input
+     * file. Such a rule runs on the Generations engine, whatever the requested engine.
+     *
+     * @param fileRule The rule of the input file, empty if there is none
+     * @return The multi-state rule, or nothing if the rule to simulate has two states
+     */
+    std::optional<Game::GenerationsRule> Arguments::resolveGenerationsRule(const std::string &fileRule) const {
+        if (generationsRule || rule || rangeRule || leniaRule)
+            return generationsRule;
+        Game::GenerationsRule parsed;
+        if (!fileRule.empty() && parseRule(fileRule, parsed) && (parsed.getStates() > 2 || parsed.isHistory()))
+            return parsed;
+        return std::nullopt;
+    }
+
+    /**
+     * Get the Lenia rule to simulate, if any: the rule given on the command line, else the rule of the input file.
+     * Such a rule runs on the Lenia engine, whatever the requested engine.
+     *
+     * @param fileRule The rule of the input file, empty if there is none
+     * @return The Lenia rule, or nothing if the rule to simulate has discrete states
+     */
+    std::optional<Game::LeniaRule> Arguments::resolveLeniaRule(const std::string &fileRule) const {
+        if (leniaRule || rule || rangeRule || generationsRule)
+            return leniaRule;
+        Game::LeniaRule parsed;
+        if (!fileRule.empty() && parseRule(fileRule, parsed))
+            return parsed;
+        return std::nullopt;
     }
 }
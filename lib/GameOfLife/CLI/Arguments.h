@@ -1,9 +1,26 @@
 #ifndef ARGUMENTS_H
 #define ARGUMENTS_H
+#include <cstdint>
+#include <optional>
 #include <string>
 #include <utility>
 
+#include "Game/Rules.h"
+#include "Game/Topology.h"
+
 namespace GameOfLife::CLI {
+    /**
+     * Grid implementation used by the high performance mode.
+     */
+    enum class Engine {
+        STANDARD,
+        PACKED,
+        HASHLIFE,
+        TILED,
+        FRONTIER,
+        INCREMENTAL
+    };
+
     /**
      * Represents the command line arguments.
      */
@@ -27,6 +44,21 @@ namespace GameOfLife::CLI {
         char deadChar;
         char separator;
 
+        Engine engine;
+        int stepExponent;
+        int memoryLimit;
+        bool benchmarks;
+        std::optional<Game::IsotropicRule> rule;
+        std::optional<Game::LargerThanLifeRule> rangeRule;
+        std::optional<Game::GenerationsRule> generationsRule;
+        std::optional<Game::LeniaRule> leniaRule;
+        int maxPeriod;
+        Game::Topology topology;
+        int blockDepth;
+        int tileCache;
+        std::optional<std::pair<float, float>> stochastic;
+        uint64_t seed;
+
         bool valid;
 
         Arguments() : valid(false) {};
@@ -34,14 +66,28 @@ namespace GameOfLife::CLI {
     public:
         Arguments(std::string  inputFile, std::string  outputFolder, const int generations = 1000, const int delay = 100,
                 const bool highPerformance = false, const bool endIfStatic = true, const bool interactive = false, bool warp = false, bool dynamic = false, bool verbose = false, bool GUI = false, bool unitTests = false,
-                const char aliveChar = '1', const char deadChar = '0', const char separator = ' ') :
+                const char aliveChar = '1', const char deadChar = '0', const char separator = ' ', const Engine engine = Engine::STANDARD,
+                const int stepExponent = 0, const int memoryLimit = 512, const bool benchmarks = false, std::optional<Game::IsotropicRule> rule = std::nullopt,
+                std::optional<Game::LargerThanLifeRule> rangeRule = std::nullopt,
+                std::optional<Game::GenerationsRule> generationsRule = std::nullopt,
+                std::optional<std::pair<float, float>> stochastic = std::nullopt, const uint64_t seed = 0,
+                std::optional<Game::LeniaRule> leniaRule = std::nullopt, const int maxPeriod = 64,
+                const Game::Topology topology = Game::Topology::TORUS, const int blockDepth = 1,
+                const int tileCache = 0) :
                 inputFile(std::move(inputFile)), outputFolder(std::move(outputFolder)), generations(generations), delay(delay),
                 highPerformance(highPerformance), endIfStatic(endIfStatic), interactive(interactive), warp(warp), dynamic(dynamic), verbose(verbose), GUI(GUI), unitTests(unitTests),
-                aliveChar(aliveChar), deadChar(deadChar), separator(separator), valid(true) {}
+                aliveChar(aliveChar), deadChar(deadChar), separator(separator), engine(engine), stepExponent(stepExponent), memoryLimit(memoryLimit), benchmarks(benchmarks), rule(rule), rangeRule(rangeRule), generationsRule(generationsRule), leniaRule(std::move(leniaRule)), maxPeriod(maxPeriod), topology(topology), blockDepth(blockDepth), tileCache(tileCache), stochastic(stochastic), seed(seed), valid(true) {}
 
         static Arguments parse(int argc, char *argv[]);
         static Arguments interactiveParse();
         static void printHelp();
+        static bool parseEngine(const std::string &name, Engine &engine);
+        static bool parseTopology(const std::string &name, Game::Topology &topology);
+        static bool parseRule(const std::string &name, Game::IsotropicRule &rule);
+        static bool parseRule(const std::string &name, Game::LargerThanLifeRule &rule);
+        static bool parseRule(const std::string &name, Game::GenerationsRule &rule);
+        static bool parseRule(const std::string &name, Game::LeniaRule &rule);
+        static bool parseStochastic(const std::string &text, std::pair<float, float> &probabilities);
 
         std::string getInputFile() { return inputFile; }
         std::string getOutputFolder() { return outputFolder; }
@@ -50,17 +96,36 @@ namespace GameOfLife::CLI {
 
         [[nodiscard]] bool isHighPerformance() const { return highPerformance; }
         [[nodiscard]] bool doEndIfStatic() const { return endIfStatic; }
+        [[nodiscard]] int getMaxPeriod() const { return maxPeriod; }
         [[nodiscard]] bool isInteractive() const { return interactive; }
         [[nodiscard]] bool doWarp() const { return warp; }
+        [[nodiscard]] Game::Topology getTopology() const { return topology; }
         [[nodiscard]] bool isDynamic() const { return dynamic; }
         [[nodiscard]] bool isVerbose() const { return verbose; }
         [[nodiscard]] bool isGUI() const { return GUI; }
         [[nodiscard]] bool doUnitTests() const { return unitTests; }
+        [[nodiscard]] bool doBenchmarks() const { return benchmarks; }
 
         [[nodiscard]] char getAliveChar() const { return aliveChar; }
         [[nodiscard]] char getDeadChar() const { return deadChar; }
         [[nodiscard]] char getSeparator() const { return separator; }
 
+        [[nodiscard]] Engine getEngine() const { return engine; }
+        [[nodiscard]] int getStepExponent() const { return stepExponent; }
+        [[nodiscard]] int getMemoryLimit() const { return memoryLimit; }
+        [[nodiscard]] int getBlockDepth() const { return blockDepth; }
+        [[nodiscard]] int getTileCache() const { return tileCache; }
+        [[nodiscard]] std::optional<Game::IsotropicRule> getRule() const { return rule; }
+        [[nodiscard]] std::optional<Game::LargerThanLifeRule> getRangeRule() const { return rangeRule; }
+        [[nodiscard]] std::optional<Game::GenerationsRule> getGenerationsRule() const { return generationsRule; }
+        [[nodiscard]] std::optional<Game::LeniaRule> getLeniaRule() const { return leniaRule; }
+        [[nodiscard]] std::optional<std::pair<float, float>> getStochastic() const { return stochastic; }
+        [[nodiscard]] uint64_t getSeed() const { return seed; }
+        [[nodiscard]] Game::IsotropicRule resolveRule(const std::string &fileRule) const;
+        [[nodiscard]] std::optional<Game::LargerThanLifeRule> resolveRangeRule(const std::string &fileRule) const;
+        [[nodiscard]] std::optional<Game::GenerationsRule> resolveGenerationsRule(const std::string &fileRule) const;
+        [[nodiscard]] std::optional<Game::LeniaRule> resolveLeniaRule(const std::string &fileRule) const;
+
         [[nodiscard]] bool isValid() const { return valid; }
     };
 
@@ -3,14 +3,23 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <thread>
+#include <type_traits>
 
 #include "Arguments.h"
 #include "File/ExtendedParser.h"
 #include "File/Parser.h"
 #include "File/Writer.h"
+#include "Game/CycleDetector.h"
 #include "Game/ExtendedGrid.h"
+#include "Game/GenerationsGrid.h"
 #include "Game/Grid.h"
+#include "Game/HashLifeGrid.h"
+#include "Game/HighPerformanceGrid.h"
+#include "Game/LargerThanLifeGrid.h"
+#include "Game/LeniaGrid.h"
+#include "Game/TiledGrid.h"
 
 namespace GameOfLife::CLI {
     /**
@@ -59,12 +68,9 @@ namespace GameOfLife::CLI {
         // Create the grid
         Game::ExtendedGrid grid(cells, rows, cols, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, args.isDynamic());
         grid.setFormatConfig(formatConfig);
+        grid.setRule(args.resolveRule(""));
 
-        // Create the array for static grid detection
-        std::vector<std::vector<std::vector<Game::Cell>>> bulk;
-        bulk.reserve(2);
-
-        simulate<Game::ExtendedGrid, Game::Cell>(grid, args, false, bulk, outputFormat);
+        simulate<Game::ExtendedGrid, Game::Cell>(grid, args, false, outputFormat);
     }
 
     /**
@@ -81,8 +87,9 @@ namespace GameOfLife::CLI {
         int rows = 0;
         int cols = 0;
         std::vector<std::vector<bool>> cells;
+        std::string fileRule;
         if (args.getInputFile().ends_with(".rle")) {
-            cells = File::Parser::parseRLE(args.getInputFile(), rows, cols);
+            cells = File::Parser::parseRLE(args.getInputFile(), rows, cols, fileRule);
             outputFormat = File::OutputFormat::RLE;
         }
         else if (args.getInputFile().ends_with(".cells")) {
@@ -94,15 +101,99 @@ namespace GameOfLife::CLI {
             return;
         }
 
-        // Create the grid
-        Game::Grid grid(cells, rows, cols, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, args.isDynamic());
-        grid.setFormatConfig(formatConfig);
+        // Larger than Life rules only run on their own engine
+        if (const auto rangeRule = args.resolveRangeRule(fileRule)) {
+            Game::LargerThanLifeGrid grid(cells, rows, cols, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, args.isDynamic());
+            grid.setFormatConfig(formatConfig);
+            grid.setRule(*rangeRule);
+
+            simulate<Game::LargerThanLifeGrid, bool>(grid, args, true, outputFormat);
+            return;
+        }
+
+        // Multi-state rules only run on their own engine, from the states of the file
+        if (const auto generationsRule = args.resolveGenerationsRule(fileRule)) {
+            std::vector states(rows, std::vector<uint8_t>(cols));
+            if (outputFormat == File::OutputFormat::RLE)
+                states = File::Parser::parseStatesRLE(args.getInputFile(), rows, cols, fileRule);
+            else {
+                for (int i = 0; i < rows; i++) {
+                    std::copy(cells[i].begin(), cells[i].end(), states[i].begin());
+                }
+            }
+            Game::GenerationsGrid grid(states, rows, cols, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, args.isDynamic());
+            grid.setRule(*generationsRule);
+            simulate<Game::GenerationsGrid, uint8_t>(grid, args, true, outputFormat);
+            return;
+        }
 
-        // Create the array for static grid detection
-        std::vector<std::vector<std::vector<bool>>> bulk;
-        bulk.reserve(2);
+        // Lenia rules only run on their own engine, the states of the file being the levels of the cells
+        if (const auto leniaRule = args.resolveLeniaRule(fileRule)) {
+            std::vector values(rows, std::vector<float>(cols));
+            if (outputFormat == File::OutputFormat::RLE)
+                values = Game::LeniaGrid::getValues(File::Parser::parseStatesRLE(args.getInputFile(), rows, cols, fileRule));
+            else {
+                for (int i = 0; i < rows; i++) {
+                    std::copy(cells[i].begin(), cells[i].end(), values[i].begin());
+                }
+            }
+            Game::LeniaGrid grid(values, rows, cols, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, args.isDynamic());
+            grid.setFormatConfig(formatConfig);
+            grid.setRule(*leniaRule);
+            simulate<Game::LeniaGrid, float>(grid, args, true, outputFormat);
+            return;
+        }
+
+        // The rule given on the command line overrides the rule of the file
+        const Game::IsotropicRule rule = args.resolveRule(fileRule);
+
+        // Create the grid with the requested engine
+        // Only the packed engine runs stochastic rules, and only the standard grid joins its edges with a twist
+        const bool twisted = args.doWarp() && args.getTopology() != Game::Topology::TORUS;
+        if (twisted && args.getStochastic())
+            std::cerr << "Stochastic rules run on a torus" << std::endl;
+        if ((args.getEngine() == Engine::PACKED && !twisted) || args.getStochastic()) {
+            Game::HighPerformanceGrid grid(cells, rows, cols, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, args.isDynamic());
+            grid.setFormatConfig(formatConfig);
+            grid.setRule(rule);
+            if (const auto stochastic = args.getStochastic())
+                grid.setStochastic(stochastic->first, stochastic->second, args.getSeed());
+            grid.setBlockDepth(args.getBlockDepth());
 
-        simulate<Game::Grid, bool>(grid, args, true, bulk, outputFormat);
+            simulate<Game::HighPerformanceGrid, bool>(grid, args, true, outputFormat);
+            return;
+        }
+        if (args.getEngine() == Engine::HASHLIFE && !twisted) {
+            Game::HashLifeGrid grid(cells, rows, cols);
+            grid.setFormatConfig(formatConfig);
+            grid.setStepExponent(args.getStepExponent());
+            grid.setMemoryLimit(static_cast<size_t>(args.getMemoryLimit()) << 20);
+            grid.setRule(rule);
+
+            simulate<Game::HashLifeGrid, bool>(grid, args, true, outputFormat);
+            return;
+        }
+        if (args.getEngine() == Engine::TILED && !twisted) {
+            Game::TiledGrid grid(cells, rows, cols);
+            grid.setFormatConfig(formatConfig);
+            grid.setRule(rule);
+            grid.setCacheCapacity(args.getTileCache());
+
+            simulate<Game::TiledGrid, bool>(grid, args, true, outputFormat);
+            return;
+        }
+
+        // The standard grid grows in amortized constant time, so a dynamic grid is not capped
+        Game::Grid grid(cells, rows, cols, std::numeric_limits<int>::max(), std::numeric_limits<int>::max(), args.isDynamic());
+        grid.setFormatConfig(formatConfig);
+        grid.setRule(rule);
+        grid.setTopology(args.getTopology());
+        if (args.getEngine() == Engine::FRONTIER)
+            grid.setStepMode(Game::StepMode::FRONTIER);
+        if (args.getEngine() == Engine::INCREMENTAL)
+            grid.setStepMode(Game::StepMode::INCREMENTAL);
+
+        simulate<Game::Grid, bool>(grid, args, true, outputFormat);
     }
 
     /**
@@ -113,60 +204,144 @@ namespace GameOfLife::CLI {
      * @param grid Grid
      * @param args Arguments
      * @param canBeRLE Can the grid be written in RLE?
-     * @param bulk Bulk array for static grid detection
      * @param outputFormat Output format
      */
     template<typename TGrid, typename T>
-    void Main::simulate(TGrid &grid, Arguments &args, const bool canBeRLE, std::vector<std::vector<std::vector<T>>> &bulk,
-        const File::OutputFormat outputFormat) {
-        // Get rows and cols
-        const int rows = grid.getRows();
-        const int cols = grid.getCols();
-
+    void Main::simulate(TGrid &grid, Arguments &args, const bool canBeRLE, const File::OutputFormat outputFormat) {
         const auto now = std::chrono::system_clock::now();
 
+        // Hash of the grid, updated with the cells changed by each step, and the hashes of the last generations
+        // Continuous and stochastic grids do not repeat themselves exactly, so they are not checked
+        uint64_t maxPeriod = args.getMaxPeriod();
+        if constexpr (std::is_same_v<T, float>)
+            maxPeriod = 0;
+        if constexpr (requires { grid.isStochastic(); }) {
+            if (grid.isStochastic())
+                maxPeriod = 0;
+        }
+
+        // A step that advances more generations than the longest period cannot show it, so the grid is not hashed
+        // on every step for nothing. Shorter steps only show a multiple of the period, reported as such
+        uint64_t stepGenerations = 1;
+        if constexpr (requires { grid.getStepExponent(); })
+            stepGenerations = uint64_t{1} << grid.getStepExponent();
+        if constexpr (requires { grid.getEffectiveBlockDepth(); }) {
+            // A growing grid is stepped one generation at a time
+            if (!args.isDynamic() || args.doWarp())
+                stepGenerations = grid.getEffectiveBlockDepth();
+        }
+        if (stepGenerations > maxPeriod)
+            maxPeriod = 0;
+        Game::CycleDetector detector(maxPeriod, stepGenerations);
+        detector.track(grid);
+        const auto describe = [](const Game::CycleDetector::Cycle &found) {
+            return std::to_string(found.period) + (found.exact ? "" : " or a divisor of it");
+        };
+        uint64_t skippedGenerations = 0;
+        const auto getGeneration = [&grid, &skippedGenerations](const int step) -> uint64_t {
+            // Grids that can skip generations keep their own count
+            if constexpr (requires { grid.getGeneration(); })
+                return grid.getGeneration() + skippedGenerations;
+            else
+                return step;
+        };
+        detector.push(getGeneration(0));
+        std::optional<Game::CycleDetector::Cycle> cycle;
+        uint64_t cycleGeneration = 0;
+        std::optional<Game::CycleDetector::Cycle> skipped;
+        double savedSeconds = 0;
+
         // Simulation loop
         int i = 0;
         for (i = 0; i < args.getGenerations(); i++) {
-            // Step the grid and push the cells to the bulk list
+            // Step the grid and update its hash
             grid.step(args.doWarp(), true);
-            bulk.push_back(grid.getCells());
+            detector.update(grid);
+            uint64_t generation = getGeneration(i + 1);
+            const auto period = detector.push(generation);
+            if (period && !cycle) {
+                cycle = period;
+                cycleGeneration = generation;
+            }
+
+            // Once a period is confirmed, the grid at the last generation is the grid of the same phase, moved by the
+            // displacement of every skipped period: whole periods are skipped, the remaining steps are simulated
+            if (const auto confirmed = detector.confirm(grid)) {
+                const int repetitions = (args.getGenerations() - (i + 1)) / static_cast<int>(confirmed->steps);
+                if (repetitions > 0) {
+                    const double elapsed = std::chrono::duration<double>(std::chrono::system_clock::now() - now).count();
+                    savedSeconds = elapsed / (i + 1) * repetitions * static_cast<double>(confirmed->steps);
+                    skippedGenerations = Game::CycleDetector::skip(grid, *confirmed, repetitions);
+                    i += repetitions * static_cast<int>(confirmed->steps);
+                    generation = getGeneration(i + 1);
+                    skipped = confirmed;
+                    detector = Game::CycleDetector(0);
+                }
+            }
+            else if (period && !detector.isExpecting())
+                detector.expect(grid, *period);
 
             // Print the grid
             clearScreen();
-            std::cout << "Generation: " << i + 1 << " (Ctrl+C to exit)" << std::endl;
+            std::cout << "Generation: " << generation << " (Ctrl+C to exit)" << std::endl;
             // If verbose mode is enabled, print the time elapsed and the number of living cells
             if (args.isVerbose()) {
                 std::cout << "Time elapsed: " << std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - now).count() << "s" << std::endl;
                 // Count the number of living cells
-                const int alive = grid.getLivingCells().size();
+                // Dynamic grids grow, so the size is read on each generation
+                const int64_t alive = grid.getPopulation();
+                const int64_t size = static_cast<int64_t>(grid.getRows()) * grid.getCols();
                 std::cout << "Living cells: " << alive << std::endl;
-                std::cout << "Dead cells: " << (rows * cols - alive) << std::endl;
-                std::cout << "Alive ratio: " << (alive * 100.0 / (rows * cols)) << "%" << std::endl;
+                std::cout << "Dead cells: " << (size - alive) << std::endl;
+                std::cout << "Alive ratio: " << (alive * 100.0 / size) << "%" << std::endl;
+                if constexpr (requires { grid.getOriginRow(); })
+                    std::cout << "Origin: " << grid.getOriginRow() << ", " << grid.getOriginCol() << std::endl;
+                if constexpr (requires { grid.getBytesCopied(); })
+                    std::cout << "Bytes copied: " << grid.getBytesCopied() << std::endl;
+                if constexpr (requires { grid.getTileCache(); }) {
+                    if (grid.getTileCache().isEnabled())
+                        std::cout << "Tile cache hit rate: " << grid.getTileCache().getHitRate() * 100 << "% (" << grid.getTileCache().getSize() << " tiles)" << std::endl;
+                }
+                if constexpr (requires { grid.getMass(); })
+                    std::cout << "Mass: " << grid.getMass() << std::endl;
             }
             std::cout << std::endl;
             grid.print();
 
             // Write current grid
-            if (canBeRLE && outputFormat == File::OutputFormat::RLE) {
+            if constexpr (std::is_same_v<T, float>) {
+                if (canBeRLE && outputFormat == File::OutputFormat::RLE)
+                    File::Writer::writeStatesRLE(grid.getLevels(), args.getOutputFolder() + "/gen" + std::to_string(i) + ".rle",
+                        grid.getRule().toString());
+                else
+                    File::Writer::write(grid, args.getOutputFolder() + "/gen" + std::to_string(i) + ".txt");
+            }
+            else if constexpr (std::is_same_v<T, uint8_t>) {
+                if (canBeRLE && outputFormat == File::OutputFormat::RLE)
+                    File::Writer::writeStatesRLE(grid.getCells(), args.getOutputFolder() + "/gen" + std::to_string(i) + ".rle",
+                        grid.getRule().toString());
+                else
+                    File::Writer::write(grid, args.getOutputFolder() + "/gen" + std::to_string(i) + ".txt");
+            }
+            else if (canBeRLE && outputFormat == File::OutputFormat::RLE) {
                 auto input = grid.getCells();
                 std::vector<std::vector<bool>> boolArray(input.size(), std::vector<bool>(input[0].size()));
                 for (size_t k = 0; k < input.size(); ++k) {
-                    for (size_t j = 0; j < input[i].size(); ++j) {
+                    for (size_t j = 0; j < input[k].size(); ++j) {
                         boolArray[k][j] = static_cast<bool>(input[k][j]);
                     }
                 }
-                File::Writer::writeRLE(boolArray, args.getOutputFolder() + "/gen" + std::to_string(i) + ".rle");
+                File::Writer::writeRLE(boolArray, args.getOutputFolder() + "/gen" + std::to_string(i) + ".rle",
+                    grid.getRule().toString());
             }
             else
                 File::Writer::write(grid, args.getOutputFolder() + "/gen" + std::to_string(i) + ".txt");
 
-            // Check if the grid is static
-            if (args.doEndIfStatic() && i > 0 && bulk.size() > 2) {
-                if (bulk[bulk.size() - 1] == bulk[bulk.size() - 2]) {
-                    std::cout << "Grid is static, ending simulation" << std::endl;
-                    break;
-                }
+            // End once the grid repeats itself, a static grid having a period of 1
+            if (args.doEndIfStatic() && period) {
+                std::cout << "Period " << describe(*period) << " detected at generation " << generation << ", ending simulation" << std::endl;
+                i++;
+                break;
             }
 
             // Wait at least the given delay
@@ -176,6 +351,12 @@ namespace GameOfLife::CLI {
         // Print the simulation time
         std::cout << "Simulation finished after " << i << " generations in " <<
             std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::system_clock::now() - now).count() << "s" << std::endl;
+        if (cycle && !args.doEndIfStatic())
+            std::cout << "Period " << describe(*cycle) << " detected at generation " << cycleGeneration << std::endl;
+        if (skipped) {
+            std::cout << "Skipped " << skippedGenerations << " generations of period " << describe(*skipped) << " (displacement "
+                << skipped->dRow << ", " << skipped->dCol << "), saving about " << savedSeconds << "s" << std::endl;
+        }
     }
 
     /**
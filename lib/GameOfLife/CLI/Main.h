@@ -13,7 +13,7 @@ namespace GameOfLife::CLI {
         static void workWrapper(Arguments &args);
         static void fastWorkWrapper(Arguments &args);
         template <typename TGrid, typename T>
-        static void simulate(TGrid &grid, Arguments &args, bool canBeRLE, std::vector<std::vector<std::vector<T>>> &bulk, File::OutputFormat outputFormat);
+        static void simulate(TGrid &grid, Arguments &args, bool canBeRLE, File::OutputFormat outputFormat);
         static void clearScreen();
     public:
         static int start(Arguments arguments, bool defaultsToInteractive = false);
@@ -67,24 +67,14 @@ namespace GameOfLife::File {
     }
 
     /**
-     * Parse the RLE file and return the cells
+     * Read the header of an RLE file, up to and including its "x = ..." line
      *
-     * @param filename RLE file path
+     * @param file RLE file, left on the line after the header
      * @param rows Number of rows, to be set by the function
      * @param cols Number of columns, to be set by the function
-     * @return 2D vector of cells
+     * @param rule Rule as written in the header, empty if there is none, to be set by the function
      */
-    std::vector<std::vector<bool>> Parser::parseRLE(const std::string &filename, int &rows, int &cols) {
-        if (filename.empty()) {
-            throw std::invalid_argument("Filename cannot be empty");
-        }
-
-        // Open the file
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            throw std::runtime_error("Could not open file: " + filename);
-        }
-
+    static void readHeader(std::ifstream &file, int &rows, int &cols, std::string &rule) {
         // Get x, y
         std::string line;
         while (std::getline(file, line)) {
@@ -96,15 +86,64 @@ namespace GameOfLife::File {
                     cols = std::stoi(line.substr(xPos + 3)); // Extract x after "x ="
                     rows = std::stoi(line.substr(yPos + 3)); // Extract y after "y ="
                 }
+
+                // The rule is the last field of the header, and may itself contain commas (B3/S23:T100,100)
+                rule.clear();
+                const size_t rulePos = line.find("rule");
+                if (rulePos != std::string::npos) {
+                    const size_t equals = line.find('=', rulePos);
+                    if (equals != std::string::npos) {
+                        rule = line.substr(equals + 1);
+                        rule.erase(0, rule.find_first_not_of(" \t"));
+                        rule.erase(rule.find_last_not_of(" \t\r") + 1);
+                    }
+                }
                 break; // Stop searching once dimensions are found
             }
         }
+    }
+
+    /**
+     * Parse the RLE file and return the cells
+     *
+     * @param filename RLE file path
+     * @param rows Number of rows, to be set by the function
+     * @param cols Number of columns, to be set by the function
+     * @return 2D vector of cells
+     */
+    std::vector<std::vector<bool>> Parser::parseRLE(const std::string &filename, int &rows, int &cols) {
+        std::string rule;
+        return parseRLE(filename, rows, cols, rule);
+    }
+
+    /**
+     * Parse the RLE file and return the cells, along with the rule of its header
+     *
+     * @param filename RLE file path
+     * @param rows Number of rows, to be set by the function
+     * @param cols Number of columns, to be set by the function
+     * @param rule Rule as written in the header, empty if there is none, to be set by the function
+     * @return 2D vector of cells
+     */
+    std::vector<std::vector<bool>> Parser::parseRLE(const std::string &filename, int &rows, int &cols, std::string &rule) {
+        if (filename.empty()) {
+            throw std::invalid_argument("Filename cannot be empty");
+        }
+
+        // Open the file
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file: " + filename);
+        }
+
+        readHeader(file, rows, cols, rule);
 
         // Read the file line per line
         std::vector<std::vector<bool>> cells;
         cells.resize(rows, std::vector<bool>(cols));
 
         // Parse the RLE pattern
+        std::string line;
         int row = 0, col = 0;
         int runLength = 0;
         while (std::getline(file, line)) {
@@ -147,4 +186,81 @@ namespace GameOfLife::File {
 
         return cells;
     }
+
+    /**
+     * Parse a multi-state RLE file and return the states of the cells, along with the rule of its header.
+     * States are written '.' (or 'b') for 0, 'A' (or 'o') to 'X' for 1 to 24, then 'pA' to 'yO' for 25 to 255.
+     *
+     * @param filename RLE file path
+     * @param rows Number of rows, to be set by the function
+     * @param cols Number of columns, to be set by the function
+     * @param rule Rule as written in the header, empty if there is none, to be set by the function
+     * @return 2D vector of states
+     */
+    std::vector<std::vector<uint8_t>> Parser::parseStatesRLE(const std::string &filename, int &rows, int &cols, std::string &rule) {
+        if (filename.empty()) {
+            throw std::invalid_argument("Filename cannot be empty");
+        }
+
+        // Open the file
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file: " + filename);
+        }
+
+        readHeader(file, rows, cols, rule);
+        std::vector cells(rows, std::vector<uint8_t>(cols));
+
+        // Parse the RLE pattern
+        std::string line;
+        int row = 0, col = 0;
+        int runLength = 0;
+        int prefix = 0;
+        while (std::getline(file, line)) {
+            // Skip comments and empty lines
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            for (char c : line) {
+                int state = -1;
+                if (std::isdigit(c)) {
+                    // Build the run-length number
+                    runLength = runLength * 10 + (c - '0');
+                } else if (c >= 'p' && c <= 'y') {
+                    // High states take a prefix
+                    prefix = c - 'p' + 1;
+                } else if (c == '.' || c == 'b') {
+                    state = 0;
+                } else if (c == 'o') {
+                    state = 1;
+                } else if (c >= 'A' && c <= 'X') {
+                    state = prefix * 24 + (c - 'A') + 1;
+                } else if (c == '$') {
+                    // End of line
+                    runLength = (runLength == 0) ? 1 : runLength;
+                    row += runLength;
+                    col = 0;
+                    runLength = 0;
+                } else if (c == '!') {
+                    // End of the pattern
+                    return cells;
+                }
+
+                if (state < 0)
+                    continue;
+                runLength = (runLength == 0) ? 1 : runLength;
+                for (int i = 0; i < runLength; ++i) {
+                    if (col < cols && row < rows && state <= 255) {
+                        cells[row][col] = static_cast<uint8_t>(state);
+                    }
+                    col++;
+                }
+                runLength = 0;
+                prefix = 0;
+            }
+        }
+
+        return cells;
+    }
 }
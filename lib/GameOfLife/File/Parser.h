@@ -1,5 +1,6 @@
 #ifndef PARSER_H
 #define PARSER_H
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,6 +26,8 @@ namespace GameOfLife::File {
         [[nodiscard]] std::vector<std::vector<bool>> parse(const std::string &filename, int &rows, int &cols) override;
 
         static std::vector<std::vector<bool>> parseRLE(const std::string &filename, int& rows, int& cols);
+        static std::vector<std::vector<bool>> parseRLE(const std::string &filename, int& rows, int& cols, std::string &rule);
+        static std::vector<std::vector<uint8_t>> parseStatesRLE(const std::string &filename, int& rows, int& cols, std::string &rule);
     };
 
 }
@@ -39,6 +39,7 @@ namespace GameOfLife::File {
      * @param data The data to write
      * @param outputFolder The folder to write the files to
      * @param startIndex The starting index for the files
+     * @param rule Rule written in the headers
      */
     void Writer::writeBulk(const std::vector<IWritable> &data, const std::string &outputFolder, int startIndex) {
         for (int i = 0; i < data.size(); i++) {
@@ -51,8 +52,10 @@ namespace GameOfLife::File {
      *
      * @param matrix The 2D matrix to write
      * @param filename The filename to write to
+     * @param rule Rule written in the header
      */
-    void Writer::writeRLE(const std::vector<std::vector<bool>>& matrix, const std::string &filename) {
+    void Writer::writeRLE(const std::vector<std::vector<bool>>& matrix, const std::string &filename,
+        const std::string &rule) {
         // Argument validation
         if (filename.empty()) {
             throw std::invalid_argument("Filename cannot be empty");
@@ -69,7 +72,7 @@ namespace GameOfLife::File {
         const int cols = matrix[0].size();
 
         // Write the header
-        file << "x = " << cols << ", y = " << rows << ", rule = B3/S23\n";
+        file << "x = " << cols << ", y = " << rows << ", rule = " << rule << "\n";
 
         int count = 0;
         bool last = matrix[0][0];
@@ -122,11 +125,74 @@ namespace GameOfLife::File {
      * @param matrix The 2D array to write
      * @param outputFolder The folder to write the files to
      * @param startIndex The starting index for the files
+     * @param rule Rule written in the headers
      */
     void Writer::writeBulkRLE(const std::vector<std::vector<std::vector<bool>>> &matrix,
-        const std::string &outputFolder, const int startIndex) {
+        const std::string &outputFolder, const int startIndex, const std::string &rule) {
         for (int i = 0; i < matrix.size(); i++) {
-            writeRLE(matrix[i], outputFolder + "/gen" + std::to_string(startIndex + i) + ".rle");
+            writeRLE(matrix[i], outputFolder + "/gen" + std::to_string(startIndex + i) + ".rle", rule);
         }
     }
+
+    /**
+     * Writes multi-state cells to a file in RLE format, '.' for state 0, 'A' to 'X' for 1 to 24, then 'pA' to 'yO'
+     *
+     * @param matrix The states to write
+     * @param filename The filename to write to
+     * @param rule The rule written in the header
+     */
+    void Writer::writeStatesRLE(const std::vector<std::vector<uint8_t>>& matrix, const std::string &filename,
+        const std::string &rule) {
+        // Argument validation
+        if (filename.empty()) {
+            throw std::invalid_argument("Filename cannot be empty");
+        }
+
+        // Open the file
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open file");
+        }
+
+        // Count the number of rows and columns, assuming the matrix is not empty
+        const int rows = matrix.size();
+        const int cols = matrix[0].size();
+
+        // Write the header
+        file << "x = " << cols << ", y = " << rows << ", rule = " << rule << "\n";
+
+        for (int row = 0; row < rows; row++) {
+            // Drop trailing dead cells
+            int end = cols;
+            while (end > 0 && matrix[row][end - 1] == 0) {
+                end--;
+            }
+
+            // Write each run of equal states
+            for (int col = 0; col < end;) {
+                const uint8_t state = matrix[row][col];
+                int count = 1;
+                while (col + count < end && matrix[row][col + count] == state) {
+                    count++;
+                }
+                if (count > 1) {
+                    file << count;
+                }
+                if (state == 0) {
+                    file << '.';
+                } else {
+                    if (state > 24) {
+                        file << static_cast<char>('p' + (state - 25) / 24);
+                    }
+                    file << static_cast<char>('A' + (state - 1) % 24);
+                }
+                col += count;
+            }
+            file << "$";
+        }
+
+        // Write the end of the file and close it
+        file << "!";
+        file.close();
+    }
 }
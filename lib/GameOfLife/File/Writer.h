@@ -1,5 +1,6 @@
 #ifndef WRITER_H
 #define WRITER_H
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -15,8 +16,12 @@ namespace GameOfLife::File {
         static void write(const IWritable &data, const std::string &filename);
         static void writeBulk(const std::vector<IWritable> &data, const std::string &outputFolder, int startIndex);
 
-        static void writeRLE(const std::vector<std::vector<bool>>& matrix, const std::string &filename);
-        static void writeBulkRLE(const std::vector<std::vector<std::vector<bool>>>& matrix, const std::string &outputFolder, int startIndex);
+        static void writeRLE(const std::vector<std::vector<bool>>& matrix, const std::string &filename,
+            const std::string &rule = "B3/S23");
+        static void writeBulkRLE(const std::vector<std::vector<std::vector<bool>>>& matrix, const std::string &outputFolder,
+            int startIndex, const std::string &rule = "B3/S23");
+        static void writeStatesRLE(const std::vector<std::vector<uint8_t>>& matrix, const std::string &filename,
+            const std::string &rule);
     };
 
 }
@@ -1,6 +1,7 @@
 #include "Main.h"
 #include "CLI/Main.h"
 
+#include <algorithm>
 #include <iostream>
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
@@ -9,7 +10,13 @@
 #include "File/ExtendedParser.h"
 #include "File/Parser.h"
 #include "File/Utils.h"
+#include "Game/GenerationsGrid.h"
 #include "Game/Grid.h"
+#include "Game/HashLifeGrid.h"
+#include "Game/HighPerformanceGrid.h"
+#include "Game/LargerThanLifeGrid.h"
+#include "Game/LeniaGrid.h"
+#include "Game/TiledGrid.h"
 
 
 namespace GameOfLife::GUI {
@@ -59,15 +66,20 @@ namespace GameOfLife::GUI {
     template<typename TGrid>
     void Main::drawVerbose(sf::RenderWindow &window, const sf::Font &font, const TGrid &grid, const long long drawTime,
         const long long stepTime, const int generation, const int delay) {
+        // Grids with a front and back buffer report what the last generation copied between them
+        std::string copied;
+        if constexpr (requires { grid.getBytesCopied(); })
+            copied = " - Bytes copied: " + std::to_string(grid.getBytesCopied());
+
         // Print text the frames per second and generation time
         sf::Text text;
         text.setFont(font);
         text.setString("FPS: " + std::to_string(drawTime == 0 ? -1 : 1000000 / drawTime) +
             " - Generation time: " + std::to_string(stepTime) + "us" +
-            "\nGrid size: " + std::to_string(grid.getRows()) + "x" + std::to_string(grid.getCols()) +
-            "\nLiving cells: " + std::to_string(grid.getLivingCells().size()) +
-            "\nDead cells: " + std::to_string(grid.getRows() * grid.getCols() - grid.getLivingCells().size()) +
-            "\nAlive ratio: " + std::to_string(grid.getLivingCells().size() * 100.0 / (grid.getRows() * grid.getCols())) + "%" +
+            "\nGrid size: " + std::to_string(grid.getRows()) + "x" + std::to_string(grid.getCols()) + copied +
+            "\nLiving cells: " + std::to_string(grid.getPopulation()) +
+            "\nDead cells: " + std::to_string(grid.getRows() * grid.getCols() - grid.getPopulation()) +
+            "\nAlive ratio: " + std::to_string(grid.getPopulation() * 100.0 / (grid.getRows() * grid.getCols())) + "%" +
             "\nDelay: " + std::to_string(delay) + "ms" + " - Generation: " + std::to_string(generation));
         text.setCharacterSize(24);
         text.setFillColor(sf::Color::White);
@@ -103,8 +115,9 @@ namespace GameOfLife::GUI {
             int rows = 0;
             int cols = 0;
             std::vector<std::vector<bool>> cells;
+            std::string fileRule;
             if (args.getInputFile().ends_with(".rle")) {
-                cells = File::Parser::parseRLE(args.getInputFile(), rows, cols);
+                cells = File::Parser::parseRLE(args.getInputFile(), rows, cols, fileRule);
                 outputFormat = File::OutputFormat::RLE;
             }
             else if (args.getInputFile().ends_with(".cells")) {
@@ -116,9 +129,90 @@ namespace GameOfLife::GUI {
                 return;
             }
 
-            // Create the grid
+            // Larger than Life rules only run on their own engine
+            if (const auto rangeRule = args.resolveRangeRule(fileRule)) {
+                Game::LargerThanLifeGrid grid(cells, rows, cols, window.getSize().y - 2, window.getSize().x - 2, args.isDynamic());
+                grid.setFormatConfig(formatConfig);
+                grid.setRule(*rangeRule);
+
+                render(window, grid, font);
+                return;
+            }
+
+            // Multi-state rules only run on their own engine, from the states of the file
+            if (const auto generationsRule = args.resolveGenerationsRule(fileRule)) {
+                std::vector states(rows, std::vector<uint8_t>(cols));
+                if (outputFormat == File::OutputFormat::RLE)
+                    states = File::Parser::parseStatesRLE(args.getInputFile(), rows, cols, fileRule);
+                else {
+                    for (int i = 0; i < rows; i++) {
+                        std::copy(cells[i].begin(), cells[i].end(), states[i].begin());
+                    }
+                }
+                Game::GenerationsGrid grid(states, rows, cols, window.getSize().y - 2, window.getSize().x - 2, args.isDynamic());
+                grid.setRule(*generationsRule);
+
+                render(window, grid, font);
+                return;
+            }
+
+            // Lenia rules only run on their own engine, the states of the file being the levels of the cells
+            if (const auto leniaRule = args.resolveLeniaRule(fileRule)) {
+                std::vector values(rows, std::vector<float>(cols));
+                if (outputFormat == File::OutputFormat::RLE)
+                    values = Game::LeniaGrid::getValues(File::Parser::parseStatesRLE(args.getInputFile(), rows, cols, fileRule));
+                else {
+                    for (int i = 0; i < rows; i++) {
+                        std::copy(cells[i].begin(), cells[i].end(), values[i].begin());
+                    }
+                }
+                Game::LeniaGrid grid(values, rows, cols, window.getSize().y - 2, window.getSize().x - 2, args.isDynamic());
+                grid.setFormatConfig(formatConfig);
+                grid.setRule(*leniaRule);
+
+                render(window, grid, font);
+                return;
+            }
+
+            // The rule given on the command line overrides the rule of the file
+            const Game::IsotropicRule rule = args.resolveRule(fileRule);
+
+            // Create the grid with the requested engine
+            if (args.getEngine() == CLI::Engine::PACKED) {
+                Game::HighPerformanceGrid grid(cells, rows, cols, window.getSize().y - 2, window.getSize().x - 2, args.isDynamic());
+                grid.setFormatConfig(formatConfig);
+                grid.setRule(rule);
+
+                render(window, grid, font);
+                return;
+            }
+            if (args.getEngine() == CLI::Engine::HASHLIFE) {
+                Game::HashLifeGrid grid(cells, rows, cols);
+                grid.setFormatConfig(formatConfig);
+                grid.setStepExponent(args.getStepExponent());
+                grid.setMemoryLimit(static_cast<size_t>(args.getMemoryLimit()) << 20);
+                grid.setRule(rule);
+
+                render(window, grid, font);
+                return;
+            }
+            if (args.getEngine() == CLI::Engine::TILED) {
+                Game::TiledGrid grid(cells, rows, cols);
+                grid.setFormatConfig(formatConfig);
+                grid.setRule(rule);
+
+                render(window, grid, font);
+                return;
+            }
+
             Game::Grid grid(cells, rows, cols, window.getSize().y - 2, window.getSize().x - 2, args.isDynamic());
             grid.setFormatConfig(formatConfig);
+            grid.setRule(rule);
+            grid.setTopology(args.getTopology());
+            if (args.getEngine() == CLI::Engine::FRONTIER)
+                grid.setStepMode(Game::StepMode::FRONTIER);
+            if (args.getEngine() == CLI::Engine::INCREMENTAL)
+                grid.setStepMode(Game::StepMode::INCREMENTAL);
 
             render(window, grid, font);
             return;
@@ -132,6 +226,7 @@ namespace GameOfLife::GUI {
 
         Game::ExtendedGrid grid(cells, rows, cols, window.getSize().y - 2, window.getSize().x - 2, args.isDynamic());
         grid.setFormatConfig(formatConfig);
+        grid.setRule(args.resolveRule(""));
 
         render(window, grid, font);
     }
@@ -308,6 +403,179 @@ namespace GameOfLife::GUI {
 
     }
 
+    /**
+     * Draws the grid to the window.
+     *
+     * @param window The window
+     * @param grid The grid
+     */
+    void Main::drawGrid(sf::RenderWindow &window, Game::HighPerformanceGrid &grid) {
+        int cellSize;
+        float offsetX, offsetY;
+        getDimensions(window, grid, cellSize, offsetX, offsetY);
+
+        // Redraw only the cells that changed state
+        for (const auto &cell : grid.getChangedCells()) {
+            int i = cell.first;
+            int j = cell.second;
+            sf::RectangleShape rectangle(sf::Vector2f(cellSize, cellSize));
+            rectangle.setPosition(j * cellSize + offsetX, i * cellSize + offsetY);
+            rectangle.setFillColor(grid.isAlive(i, j) ? sf::Color::White : sf::Color::Black);
+            window.draw(rectangle);
+        }
+    }
+
+    /**
+     * Draws the grid to the window.
+     *
+     * @param window The window
+     * @param grid The grid
+     */
+    void Main::drawGrid(sf::RenderWindow &window, Game::HashLifeGrid &grid) {
+        int cellSize;
+        float offsetX, offsetY;
+        getDimensions(window, grid, cellSize, offsetX, offsetY);
+
+        // A step can move any cell, so the whole visible window is redrawn
+        sf::RectangleShape background(sf::Vector2f(grid.getCols() * cellSize, grid.getRows() * cellSize));
+        background.setPosition(offsetX, offsetY);
+        background.setFillColor(sf::Color::Black);
+        window.draw(background);
+
+        for (const auto &cell : grid.getLivingCells()) {
+            sf::RectangleShape rectangle(sf::Vector2f(cellSize, cellSize));
+            rectangle.setPosition(cell.second * cellSize + offsetX, cell.first * cellSize + offsetY);
+            rectangle.setFillColor(sf::Color::White);
+            window.draw(rectangle);
+        }
+    }
+
+    /**
+     * Draws the grid to the window.
+     *
+     * @param window The window
+     * @param grid The grid
+     */
+    void Main::drawGrid(sf::RenderWindow &window, Game::TiledGrid &grid) {
+        int cellSize;
+        float offsetX, offsetY;
+        getDimensions(window, grid, cellSize, offsetX, offsetY);
+
+        // Changed cells are not tracked, so the whole visible window is redrawn
+        sf::RectangleShape background(sf::Vector2f(grid.getCols() * cellSize, grid.getRows() * cellSize));
+        background.setPosition(offsetX, offsetY);
+        background.setFillColor(sf::Color::Black);
+        window.draw(background);
+
+        for (const auto &cell : grid.getLivingCells()) {
+            sf::RectangleShape rectangle(sf::Vector2f(cellSize, cellSize));
+            rectangle.setPosition(cell.second * cellSize + offsetX, cell.first * cellSize + offsetY);
+            rectangle.setFillColor(sf::Color::White);
+            window.draw(rectangle);
+        }
+    }
+
+    /**
+     * Draws the grid to the window.
+     *
+     * @param window The window
+     * @param grid The grid
+     */
+    void Main::drawGrid(sf::RenderWindow &window, Game::LargerThanLifeGrid &grid) {
+        int cellSize;
+        float offsetX, offsetY;
+        getDimensions(window, grid, cellSize, offsetX, offsetY);
+
+        // Redraw only the cells that changed state
+        for (const auto &cell : grid.getChangedCells()) {
+            int i = cell.first;
+            int j = cell.second;
+            sf::RectangleShape rectangle(sf::Vector2f(cellSize, cellSize));
+            rectangle.setPosition(j * cellSize + offsetX, i * cellSize + offsetY);
+            rectangle.setFillColor(grid.isAlive(i, j) ? sf::Color::White : sf::Color::Black);
+            window.draw(rectangle);
+        }
+    }
+
+    /**
+     * Gets the colour of a multi-state cell.
+     * LifeHistory uses the colours of Golly, Generations fade the decaying states from yellow to red.
+     *
+     * @param rule The rule
+     * @param state The state
+     * @return The colour of the state
+     */
+    static sf::Color getStateColor(const Game::GenerationsRule &rule, const uint8_t state) {
+        if (rule.isHistory()) {
+            static const sf::Color history[7] = {sf::Color::Black, sf::Color::Green, sf::Color(0, 0, 128), sf::Color::White,
+                sf::Color(216, 0, 0), sf::Color::Yellow, sf::Color(96, 96, 96)};
+            return history[std::min<int>(state, 6)];
+        }
+        if (state <= 1)
+            return state == 1 ? sf::Color::White : sf::Color::Black;
+        const int fade = 255 * (state - 2) / std::max(1, rule.getStates() - 2);
+        return {255, static_cast<sf::Uint8>(255 - fade), 0};
+    }
+
+    /**
+     * Draws the grid to the window.
+     *
+     * @param window The window
+     * @param grid The grid
+     */
+    void Main::drawGrid(sf::RenderWindow &window, Game::GenerationsGrid &grid) {
+        int cellSize;
+        float offsetX, offsetY;
+        getDimensions(window, grid, cellSize, offsetX, offsetY);
+
+        // Redraw only the cells that changed state
+        for (const auto &cell : grid.getChangedCells()) {
+            int i = cell.first;
+            int j = cell.second;
+            sf::RectangleShape rectangle(sf::Vector2f(cellSize, cellSize));
+            rectangle.setPosition(j * cellSize + offsetX, i * cellSize + offsetY);
+            rectangle.setFillColor(getStateColor(grid.getRule(), grid.getState(i, j)));
+            window.draw(rectangle);
+        }
+    }
+
+    /**
+     * Gets the colour of a Lenia value, from black through blue and green to yellow.
+     *
+     * @param value The value, in [0, 1]
+     * @return The colour of the value
+     */
+    static sf::Color getValueColor(const float value) {
+        static const sf::Color stops[4] = {sf::Color::Black, sf::Color(32, 64, 192), sf::Color(32, 192, 96), sf::Color(255, 240, 64)};
+        const float position = std::clamp(value, 0.0f, 1.0f) * 3;
+        const int stop = std::min(static_cast<int>(position), 2);
+        const float t = position - stop;
+        const auto mix = [t](const sf::Uint8 from, const sf::Uint8 to) { return static_cast<sf::Uint8>(from + (to - from) * t); };
+        return {mix(stops[stop].r, stops[stop + 1].r), mix(stops[stop].g, stops[stop + 1].g), mix(stops[stop].b, stops[stop + 1].b)};
+    }
+
+    /**
+     * Draws the grid to the window.
+     *
+     * @param window The window
+     * @param grid The grid
+     */
+    void Main::drawGrid(sf::RenderWindow &window, Game::LeniaGrid &grid) {
+        int cellSize;
+        float offsetX, offsetY;
+        getDimensions(window, grid, cellSize, offsetX, offsetY);
+
+        // Redraw only the cells whose level changed
+        for (const auto &cell : grid.getChangedCells()) {
+            int i = cell.first;
+            int j = cell.second;
+            sf::RectangleShape rectangle(sf::Vector2f(cellSize, cellSize));
+            rectangle.setPosition(j * cellSize + offsetX, i * cellSize + offsetY);
+            rectangle.setFillColor(getValueColor(grid.getValue(i, j)));
+            window.draw(rectangle);
+        }
+    }
+
     /**
      * Draws the grid to the window.
      *
@@ -378,6 +646,124 @@ namespace GameOfLife::GUI {
         grid.insert(cells, row, col, false);
     }
 
+    /**
+     * Inserts a pattern into the grid.
+     *
+     * @param grid The grid
+     * @param pattern The pattern
+     * @param row The row to insert the pattern
+     * @param col The column to insert the pattern
+     */
+    void Main::insertPattern(Game::HighPerformanceGrid &grid, const std::string &pattern, int row, int col) {
+        int rows = 0;
+        int cols = 0;
+        const std::vector<std::vector<bool>> cells = File::Parser::parseRLE(pattern, rows, cols);
+
+        if (row < 0 || col < 0 || row + rows > grid.getRows() || col + cols > grid.getCols())
+            return;
+
+        grid.insert(cells, row, col, false);
+    }
+
+    /**
+     * Inserts a pattern into the grid.
+     *
+     * @param grid The grid
+     * @param pattern The pattern
+     * @param row The row to insert the pattern
+     * @param col The column to insert the pattern
+     */
+    void Main::insertPattern(Game::HashLifeGrid &grid, const std::string &pattern, int row, int col) {
+        int rows = 0;
+        int cols = 0;
+        const std::vector<std::vector<bool>> cells = File::Parser::parseRLE(pattern, rows, cols);
+
+        // The universe is unbounded, only the visible window limits the insertion
+        if (row < 0 || col < 0 || row >= grid.getRows() || col >= grid.getCols())
+            return;
+
+        grid.insert(cells, row, col, false);
+    }
+
+    /**
+     * Inserts a pattern into the grid.
+     *
+     * @param grid The grid
+     * @param pattern The pattern
+     * @param row The row to insert the pattern
+     * @param col The column to insert the pattern
+     */
+    void Main::insertPattern(Game::TiledGrid &grid, const std::string &pattern, int row, int col) {
+        int rows = 0;
+        int cols = 0;
+        const std::vector<std::vector<bool>> cells = File::Parser::parseRLE(pattern, rows, cols);
+
+        // The universe is unbounded, only the visible window limits the insertion
+        if (row < 0 || col < 0 || row >= grid.getRows() || col >= grid.getCols())
+            return;
+
+        grid.insert(cells, row, col, false);
+    }
+
+    /**
+     * Inserts a pattern into the grid.
+     *
+     * @param grid The grid
+     * @param pattern The pattern
+     * @param row The row to insert the pattern
+     * @param col The column to insert the pattern
+     */
+    void Main::insertPattern(Game::LargerThanLifeGrid &grid, const std::string &pattern, int row, int col) {
+        int rows = 0;
+        int cols = 0;
+        const std::vector<std::vector<bool>> cells = File::Parser::parseRLE(pattern, rows, cols);
+
+        if (row < 0 || col < 0 || row + rows > grid.getRows() || col + cols > grid.getCols())
+            return;
+
+        grid.insert(cells, row, col, false);
+    }
+
+    /**
+     * Inserts a pattern into the grid.
+     *
+     * @param grid The grid
+     * @param pattern The pattern
+     * @param row The row to insert the pattern
+     * @param col The column to insert the pattern
+     */
+    void Main::insertPattern(Game::GenerationsGrid &grid, const std::string &pattern, int row, int col) {
+        int rows = 0;
+        int cols = 0;
+        std::string rule;
+        const std::vector<std::vector<uint8_t>> states = File::Parser::parseStatesRLE(pattern, rows, cols, rule);
+
+        if (row < 0 || col < 0 || row + rows > grid.getRows() || col + cols > grid.getCols())
+            return;
+
+        grid.insert(states, row, col, false);
+    }
+
+    /**
+     * Inserts a pattern into the grid.
+     *
+     * @param grid The grid
+     * @param pattern The pattern
+     * @param row The row to insert the pattern
+     * @param col The column to insert the pattern
+     */
+    void Main::insertPattern(Game::LeniaGrid &grid, const std::string &pattern, int row, int col) {
+        int rows = 0;
+        int cols = 0;
+        std::string rule;
+        const std::vector<std::vector<float>> values = Game::LeniaGrid::getValues(File::Parser::parseStatesRLE(pattern, rows, cols, rule));
+
+        if (row < 0 || col < 0 || row + rows > grid.getRows() || col + cols > grid.getCols())
+            return;
+
+        grid.insert(values, row, col, false);
+    }
+
     /**
      * Inserts a pattern into the grid.
      *
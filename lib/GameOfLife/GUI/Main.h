@@ -3,6 +3,12 @@
 #include <SFML/Graphics.hpp>
 #include "CLI/Arguments.h"
 #include "Game/ExtendedGrid.h"
+#include "Game/GenerationsGrid.h"
+#include "Game/HashLifeGrid.h"
+#include "Game/HighPerformanceGrid.h"
+#include "Game/LargerThanLifeGrid.h"
+#include "Game/LeniaGrid.h"
+#include "Game/TiledGrid.h"
 
 namespace GameOfLife::GUI {
 
@@ -20,8 +26,20 @@ namespace GameOfLife::GUI {
         void getDimensions(sf::RenderWindow &window, const TGrid &grid, int &cellSize, float &offsetX, float &offsetY) const;
 
         void drawGrid(sf::RenderWindow &window, Game::Grid &grid);
+        void drawGrid(sf::RenderWindow &window, Game::HighPerformanceGrid &grid);
+        void drawGrid(sf::RenderWindow &window, Game::HashLifeGrid &grid);
+        void drawGrid(sf::RenderWindow &window, Game::TiledGrid &grid);
+        void drawGrid(sf::RenderWindow &window, Game::LargerThanLifeGrid &grid);
+        void drawGrid(sf::RenderWindow &window, Game::GenerationsGrid &grid);
+        void drawGrid(sf::RenderWindow &window, Game::LeniaGrid &grid);
         void drawGrid(sf::RenderWindow &window, const Game::ExtendedGrid &grid);
         void insertPattern(Game::Grid &grid, const std::string &pattern, int row, int col);
+        void insertPattern(Game::HighPerformanceGrid &grid, const std::string &pattern, int row, int col);
+        void insertPattern(Game::HashLifeGrid &grid, const std::string &pattern, int row, int col);
+        void insertPattern(Game::TiledGrid &grid, const std::string &pattern, int row, int col);
+        void insertPattern(Game::LargerThanLifeGrid &grid, const std::string &pattern, int row, int col);
+        void insertPattern(Game::GenerationsGrid &grid, const std::string &pattern, int row, int col);
+        void insertPattern(Game::LeniaGrid &grid, const std::string &pattern, int row, int col);
         void insertPattern(Game::ExtendedGrid &grid, const std::string &pattern, int row, int col);
         void drawHelp(sf::RenderWindow &window, sf::Font &font) const;
         template<typename TGrid>
@@ -0,0 +1,35 @@
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+#define CACHE_LINE 64
+
+namespace GameOfLife::Game {
+    /**
+     * Allocator placing the storage of a container on a cache line boundary, so rows padded to whole cache lines never
+     * share one.
+     */
+    template<typename T>
+    struct AlignedAllocator {
+        using value_type = T;
+
+        AlignedAllocator() = default;
+        template<typename U>
+        AlignedAllocator(const AlignedAllocator<U> &) noexcept {}
+
+        T *allocate(const std::size_t count) {
+            return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{CACHE_LINE}));
+        }
+
+        void deallocate(T *pointer, std::size_t) noexcept {
+            ::operator delete(pointer, std::align_val_t{CACHE_LINE});
+        }
+
+        template<typename U>
+        bool operator==(const AlignedAllocator<U> &) const noexcept { return true; }
+    };
+}
+
+#endif //ALIGNEDALLOCATOR_H
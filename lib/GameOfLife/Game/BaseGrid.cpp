@@ -1,10 +1,9 @@
 #include "BaseGrid.h"
 
 #include <stdexcept>
-#include <unordered_set>
 #include <vector>
 
-#include "HashFunction.h"
+#include "CoordinateSet.h"
 
 namespace GameOfLife::Game {
     // Empty
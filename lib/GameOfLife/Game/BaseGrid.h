@@ -2,10 +2,9 @@
 #define BASEGRID_H
 #include <stdexcept>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
-#include "HashFunction.h"
+#include "CoordinateSet.h"
 #include "File/IWritable.h"
 
 
@@ -37,9 +36,9 @@ namespace GameOfLife::Game {
 
         [[nodiscard]] std::string getText() const override = 0;
 
-        void move(std::vector<std::vector<T>> &grid,
-            std::unordered_set<std::pair<int, int>, HashFunction> &livingCells,
-            std::unordered_set<std::pair<int, int>, HashFunction> &changedCells,
+        void move(std::vector<std::vector<T>> &grid, std::vector<std::vector<T>> &next,
+            CoordinateSet &livingCells,
+            CoordinateSet &changedCells,
             int fromRow, int fromCol, int numRows, int numCols, int toRow, int toCol) {
             // Extract the submatrix
             std::vector submatrix(numRows, std::vector<T>(numCols));
@@ -53,6 +52,7 @@ namespace GameOfLife::Game {
             for (int i = 0; i < numRows; ++i) {
                 for (int j = 0; j < numCols; ++j) {
                     grid[fromRow + i][fromCol + j] = false; // Assuming false is the default value
+                    next[fromRow + i][fromCol + j] = false;
                 }
             }
 
@@ -62,6 +62,7 @@ namespace GameOfLife::Game {
             for (int i = 0; i < numRows; ++i) {
                 for (int j = 0; j < numCols; ++j) {
                     grid[toRow + i][toCol + j] = submatrix[i][j];
+                    next[toRow + i][toCol + j] = submatrix[i][j];
                     changedCells.insert(std::make_pair(toRow + i, toCol + j));
                     if (submatrix[i][j]) {
                         livingCells.insert(std::make_pair(toRow + i, toCol + j));
@@ -71,7 +72,7 @@ namespace GameOfLife::Game {
         }
 
         void resize(std::vector<std::vector<T>> &grid, std::vector<std::vector<T>> &next,
-            std::unordered_set<std::pair<int, int>, HashFunction> &livingCells,
+            CoordinateSet &livingCells,
             int addNorth, int addEast, int addSouth, int addWest, int &rows, int &cols, int maxRows, int maxCols) {
             // Argument check
             if (addNorth < 0 || addEast < 0 || addSouth < 0 || addWest < 0) {
@@ -83,33 +84,23 @@ namespace GameOfLife::Game {
                 return;
             }
 
-            if (addEast > 0) {
-                for (int i = 0; i < rows; ++i) {
-                    grid[i].resize(cols + addEast);
+            // Grow both buffers the same way, rows are moved and not copied
+            auto grow = [&](std::vector<std::vector<T>> &buffer) {
+                const int newCols = cols + addEast + addWest;
+                for (auto &row : buffer) {
+                    row.resize(cols + addEast);
+                    row.insert(row.begin(), addWest, T());
                 }
-                cols += addEast;
-            }
-            if (addSouth > 0) {
-                grid.resize(rows + addSouth, std::vector<T>(cols));
-                rows += addSouth;
-            }
-
-            if (addNorth > 0) {
-                // Insert new rows at the top
-                grid.insert(grid.begin(), addNorth, std::vector<T>(cols));
-                rows += addNorth;
-            }
-
-            if (addWest > 0) {
-                // Insert new columns at the left
-                for (int i = 0; i < rows; ++i) {
-                    grid[i].insert(grid[i].begin(), addWest, T());
-                }
-                cols += addWest;
-            }
+                buffer.resize(rows + addSouth, std::vector<T>(newCols));
+                buffer.insert(buffer.begin(), addNorth, std::vector<T>(newCols));
+            };
+            grow(grid);
+            grow(next);
+            rows += addNorth + addSouth;
+            cols += addEast + addWest;
 
             // Update the living cells set
-            std::unordered_set<std::pair<int, int>, HashFunction> newLivingCells;
+            CoordinateSet newLivingCells;
             for (const auto &cell : livingCells) {
                 int newRow = cell.first + addNorth;
                 int newCol = cell.second + addWest;
@@ -118,14 +109,11 @@ namespace GameOfLife::Game {
                 }
             }
             livingCells = newLivingCells;
-
-            // Resize the next generation
-            next = grid;
         }
 
-        void insert(std::vector<std::vector<T>> &grid,
-            std::unordered_set<std::pair<int, int>, HashFunction> &livingCells,
-            std::unordered_set<std::pair<int, int>, HashFunction> &changedCells,
+        void insert(std::vector<std::vector<T>> &grid, std::vector<std::vector<T>> &next,
+            CoordinateSet &livingCells,
+            CoordinateSet &changedCells,
             const std::vector<std::vector<T>> &cells,
             int row, int col, int rows, int cols, int maxRows, int maxCols, bool hollow) {
             // Argument check
@@ -143,6 +131,7 @@ namespace GameOfLife::Game {
                 for (int j = 0; j < cells[i].size(); ++j) {
                     if (!hollow || cells[i][j]) {
                         grid[row + i][col + j] = cells[i][j];
+                        next[row + i][col + j] = cells[i][j];
                         changedCells.insert({row + i, col + j});
                     }
                 }
@@ -0,0 +1,184 @@
+#include "BatchGrid.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+#include "Random.h"
+#include "StepKernel.h"
+
+namespace GameOfLife::Game {
+    /**
+     * Constructs a batch of 64 empty universes of the specified size, all active.
+     *
+     * @param rows Number of rows of each universe
+     * @param cols Number of columns of each universe
+     */
+    BatchGrid::BatchGrid(const int rows, const int cols) : rows(rows), cols(cols) {
+        cells.resize(static_cast<size_t>(rows) * cols);
+        next.resize(cells.size());
+        empty.resize(cols);
+    }
+
+    /**
+     * Checks that a lane is one of the universes of the batch.
+     *
+     * @param lane Lane of a universe
+     */
+    void BatchGrid::checkLane(const int lane) {
+        if (lane < 0 || lane >= LANES)
+            throw std::invalid_argument("The lane must be between 0 and 63.");
+    }
+
+    /**
+     * Loads the cells of a grid into a universe, replacing its cells. The cells past the edges are left out.
+     *
+     * @param lane Lane of the universe
+     * @param cells Cells, as given by the getCells method of the grids
+     * @param row Row to place the cells at
+     * @param col Column to place the cells at
+     */
+    void BatchGrid::load(const int lane, const std::vector<std::vector<bool>> &cells, const int row, const int col) {
+        checkLane(lane);
+        const uint64_t bit = uint64_t{1} << lane;
+        for (uint64_t &word : this->cells) {
+            word &= ~bit;
+        }
+        for (int i = 0; i < static_cast<int>(cells.size()); i++) {
+            for (int j = 0; j < static_cast<int>(cells[i].size()); j++) {
+                if (cells[i][j] && row + i >= 0 && row + i < rows && col + j >= 0 && col + j < cols)
+                    this->cells[static_cast<size_t>(row + i) * cols + col + j] |= bit;
+            }
+        }
+    }
+
+    /**
+     * Extracts the cells of a universe, to be loaded in a grid.
+     *
+     * @param lane Lane of the universe
+     * @return Cells of the universe
+     */
+    std::vector<std::vector<bool>> BatchGrid::extract(const int lane) const {
+        checkLane(lane);
+        std::vector extracted(rows, std::vector<bool>(cols));
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                extracted[i][j] = cells[static_cast<size_t>(i) * cols + j] >> lane & 1;
+            }
+        }
+        return extracted;
+    }
+
+    /**
+     * Fills a region of every universe with a different random soup. The soups only depend on the seed, the universe
+     * and the cell, so a seed always gives the same batch.
+     *
+     * @param aliveProbability Probability of a cell being alive
+     * @param seed Seed
+     * @param row First row of the region
+     * @param col First column of the region
+     * @param numRows Number of rows of the region
+     * @param numCols Number of columns of the region
+     */
+    void BatchGrid::randomize(const float aliveProbability, const uint64_t seed, const int row, const int col,
+        const int numRows, const int numCols) {
+        if (aliveProbability < 0 || aliveProbability > 1)
+            return;
+        if (row < 0 || col < 0 || row + numRows > rows || col + numCols > cols)
+            throw std::invalid_argument("The region must be within the grid.");
+
+        // A row of the region is drawn as a packed row of 64 bits per cell, one bit per universe
+        const uint32_t threshold = Random::threshold(aliveProbability);
+        std::vector<uint64_t> drawn(numCols);
+        for (int i = 0; i < numRows; i++) {
+            Random::bernoulliRow(drawn.data(), numCols * LANES, threshold, seed, 0, static_cast<uint32_t>(row + i),
+                Random::Stream::RANDOMIZE);
+            std::copy(drawn.begin(), drawn.end(), &cells[static_cast<size_t>(row + i) * cols + col]);
+        }
+    }
+
+    /**
+     * Clears every universe.
+     */
+    void BatchGrid::clear() {
+        std::fill(cells.begin(), cells.end(), 0);
+    }
+
+    /**
+     * Sets a cell of a universe to be alive or dead.
+     *
+     * @param lane Lane of the universe
+     * @param row Cell row
+     * @param col Cell column
+     * @param alive Alive status
+     */
+    void BatchGrid::setAlive(const int lane, const int row, const int col, const bool alive) {
+        checkLane(lane);
+        uint64_t &word = cells[static_cast<size_t>(row) * cols + col];
+        const uint64_t bit = uint64_t{1} << lane;
+        word = alive ? word | bit : word & ~bit;
+    }
+
+    /**
+     * Checks if a cell of a universe is alive.
+     *
+     * @param lane Lane of the universe
+     * @param row Cell row
+     * @param col Cell column
+     * @return True if the cell is alive, false otherwise
+     */
+    bool BatchGrid::isAlive(const int lane, const int row, const int col) const {
+        checkLane(lane);
+        return cells[static_cast<size_t>(row) * cols + col] >> lane & 1;
+    }
+
+    /**
+     * Steps the active universes to the next generation, the retired ones keep their cells.
+     * The universes that changed are recorded, so the settled ones can be retired.
+     *
+     * @param wrap If true, the universes wrap around the edges
+     */
+    void BatchGrid::step(const bool wrap) {
+        changedLanes = 0;
+        for (int i = 0; i < rows; i++) {
+            const uint64_t *above = i > 0 ? &cells[static_cast<size_t>(i - 1) * cols] :
+                wrap ? &cells[static_cast<size_t>(rows - 1) * cols] : empty.data();
+            const uint64_t *below = i < rows - 1 ? &cells[static_cast<size_t>(i + 1) * cols] :
+                wrap ? &cells[0] : empty.data();
+            changedLanes |= StepKernel::stepLanes(above, &cells[static_cast<size_t>(i) * cols], below,
+                &next[static_cast<size_t>(i) * cols], cols, wrap, active, rule);
+        }
+        std::swap(cells, next);
+        generation++;
+    }
+
+    /**
+     * Gets the number of living cells of a universe.
+     *
+     * @param lane Lane of the universe
+     * @return Number of living cells
+     */
+    size_t BatchGrid::getPopulation(const int lane) const {
+        checkLane(lane);
+        size_t population = 0;
+        for (const uint64_t word : cells) {
+            population += word >> lane & 1;
+        }
+        return population;
+    }
+
+    /**
+     * Gets the number of living cells of every universe, by lane.
+     *
+     * @return Number of living cells of each universe
+     */
+    std::array<size_t, BatchGrid::LANES> BatchGrid::getPopulations() const {
+        std::array<size_t, LANES> populations{};
+        for (const uint64_t word : cells) {
+            for (uint64_t bits = word; bits != 0; bits &= bits - 1) {
+                populations[std::countr_zero(bits)]++;
+            }
+        }
+        return populations;
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef BATCHGRID_H
+#define BATCHGRID_H
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Rules.h"
+
+namespace GameOfLife::Game {
+    /**
+     * Batch of 64 independent grids of the same size, bit-sliced: each cell is a word whose bit k is the cell of the
+     * universe k, so the bitwise adders of the StepKernel advance all the universes at once.
+     * Made for soup searches, which run many small grids: universes that settled can be retired from the active mask,
+     * they then keep their cells while the others are stepped.
+     */
+    class BatchGrid {
+    public:
+        static constexpr int LANES = 64;
+
+    private:
+        std::vector<uint64_t> cells;
+        std::vector<uint64_t> next;
+        std::vector<uint64_t> empty;
+        int rows;
+        int cols;
+
+        uint64_t active = ~uint64_t{0};
+        uint64_t changedLanes = 0;
+        uint64_t generation = 0;
+        IsotropicRule rule;
+
+        static void checkLane(int lane);
+
+    public:
+        BatchGrid() = delete;
+        BatchGrid(int rows, int cols);
+
+        void load(int lane, const std::vector<std::vector<bool>> &cells, int row = 0, int col = 0);
+        [[nodiscard]] std::vector<std::vector<bool>> extract(int lane) const;
+        void randomize(float aliveProbability, uint64_t seed, int row, int col, int numRows, int numCols);
+        void clear();
+
+        void setAlive(int lane, int row, int col, bool alive);
+        [[nodiscard]] bool isAlive(int lane, int row, int col) const;
+
+        void step(bool wrap);
+
+        void setActive(const uint64_t active) { this->active = active; }
+        [[nodiscard]] uint64_t getActive() const { return active; }
+        void retire(const int lane) { active &= ~(uint64_t{1} << lane); }
+        [[nodiscard]] uint64_t getChangedLanes() const { return changedLanes; }
+
+        [[nodiscard]] size_t getPopulation(int lane) const;
+        [[nodiscard]] std::array<size_t, LANES> getPopulations() const;
+
+        [[nodiscard]] int getRows() const { return rows; }
+        [[nodiscard]] int getCols() const { return cols; }
+        [[nodiscard]] uint64_t getGeneration() const { return generation; }
+
+        void setRule(const IsotropicRule &rule) { this->rule = rule; }
+        [[nodiscard]] const IsotropicRule &getRule() const { return rule; }
+    };
+}
+
+#endif //BATCHGRID_H
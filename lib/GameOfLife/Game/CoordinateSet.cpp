@@ -0,0 +1,203 @@
+#include "CoordinateSet.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define COORDINATESET_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace GameOfLife::Game {
+    /**
+     * Bit masks of the bytes of a group of 16 control bytes matching a condition, bit i for byte i.
+     */
+#ifdef COORDINATESET_SSE2
+    static inline uint32_t matchByte(const int8_t *group, const int8_t value) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(value)));
+    }
+
+    static inline uint32_t matchFree(const int8_t *group) {
+        // Empty and deleted control bytes are the only negative ones
+        return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(group)));
+    }
+#else
+    static inline uint32_t matchByte(const int8_t *group, const int8_t value) {
+        uint32_t mask = 0;
+        for (int i = 0; i < 16; i++)
+            mask |= static_cast<uint32_t>(group[i] == value) << i;
+        return mask;
+    }
+
+    static inline uint32_t matchFree(const int8_t *group) {
+        uint32_t mask = 0;
+        for (int i = 0; i < 16; i++)
+            mask |= static_cast<uint32_t>(group[i] < 0) << i;
+        return mask;
+    }
+#endif
+
+    /**
+     * Constructs an empty set able to hold the expected number of coordinates without rehashing.
+     *
+     * @param expected Expected number of coordinates
+     */
+    CoordinateSet::CoordinateSet(const size_t expected) {
+        reserve(expected);
+    }
+
+    /**
+     * Finds the slot of a key.
+     *
+     * @param key Packed coordinate
+     * @return Slot index, or NOT_FOUND
+     */
+    size_t CoordinateSet::findKey(const uint64_t key) const {
+        if (used == 0)
+            return NOT_FOUND;
+
+        const uint64_t h = hash(key);
+        const auto tag = static_cast<int8_t>(h & 0x7F);
+        const size_t mask = capacity - 1;
+        size_t position = (h >> 7) & mask;
+        for (size_t stride = GROUP_SIZE; ; stride += GROUP_SIZE) {
+            const int8_t *group = &control[position];
+            for (uint32_t match = matchByte(group, tag); match; match &= match - 1) {
+                const size_t index = (position + std::countr_zero(match)) & mask;
+                if (slots[index] == key)
+                    return index;
+            }
+            if (matchByte(group, EMPTY))
+                return NOT_FOUND;
+            position = (position + stride) & mask;
+        }
+    }
+
+    /**
+     * Inserts a key if it is not already in the set.
+     *
+     * @param key Packed coordinate
+     * @return True if the key was inserted, false if it was already in the set
+     */
+    bool CoordinateSet::insertKey(const uint64_t key) {
+        // Keep at least one eighth of the slots empty so every probe ends
+        if ((used + deleted + 1) * 8 > capacity * 7)
+            rehash(used * 2 >= capacity ? capacity * 2 : capacity);
+
+        const uint64_t h = hash(key);
+        const auto tag = static_cast<int8_t>(h & 0x7F);
+        const size_t mask = capacity - 1;
+        size_t position = (h >> 7) & mask;
+        size_t target = NOT_FOUND;
+        for (size_t stride = GROUP_SIZE; ; stride += GROUP_SIZE) {
+            const int8_t *group = &control[position];
+            for (uint32_t match = matchByte(group, tag); match; match &= match - 1) {
+                const size_t index = (position + std::countr_zero(match)) & mask;
+                if (slots[index] == key)
+                    return false;
+            }
+            if (const uint32_t free = matchFree(group); free && target == NOT_FOUND)
+                target = (position + std::countr_zero(free)) & mask;
+            if (matchByte(group, EMPTY))
+                break;
+            position = (position + stride) & mask;
+        }
+
+        if (control[target] == DELETED)
+            deleted--;
+        setControl(target, tag);
+        slots[target] = key;
+        used++;
+        return true;
+    }
+
+    /**
+     * Erases a key.
+     *
+     * @param key Packed coordinate
+     * @return Number of erased keys (0 or 1)
+     */
+    size_t CoordinateSet::eraseKey(const uint64_t key) {
+        const size_t index = findKey(key);
+        if (index == NOT_FOUND)
+            return 0;
+
+        setControl(index, DELETED);
+        used--;
+        deleted++;
+        return 1;
+    }
+
+    /**
+     * Sets a control byte, and its mirror if it is in the first group.
+     *
+     * @param index Slot index
+     * @param value Control byte
+     */
+    void CoordinateSet::setControl(const size_t index, const int8_t value) {
+        control[index] = value;
+        if (index < GROUP_SIZE)
+            control[capacity + index] = value;
+    }
+
+    /**
+     * Removes all the coordinates, keeping the allocated slots.
+     */
+    void CoordinateSet::clear() {
+        if (used == 0 && deleted == 0)
+            return;
+        std::fill(control.begin(), control.end(), EMPTY);
+        used = 0;
+        deleted = 0;
+    }
+
+    /**
+     * Allocates enough slots for the expected number of coordinates.
+     *
+     * @param expected Expected number of coordinates
+     */
+    void CoordinateSet::reserve(const size_t expected) {
+        const size_t needed = std::bit_ceil(std::max<size_t>(expected * 8 / 7 + 1, GROUP_SIZE));
+        if (needed > capacity)
+            rehash(needed);
+    }
+
+    /**
+     * Moves every coordinate to a new slot array.
+     *
+     * @param newCapacity Number of slots, a power of two
+     */
+    void CoordinateSet::rehash(const size_t newCapacity) {
+        std::vector<int8_t> oldControl = std::move(control);
+        std::vector<uint64_t> oldSlots = std::move(slots);
+        const size_t oldCapacity = capacity;
+
+        capacity = std::max<size_t>(newCapacity, GROUP_SIZE);
+        control.assign(capacity + GROUP_SIZE, EMPTY);
+        slots.resize(capacity);
+        used = 0;
+        deleted = 0;
+
+        for (size_t i = 0; i < oldCapacity; i++) {
+            if (oldControl[i] >= 0)
+                insertKey(oldSlots[i]);
+        }
+    }
+
+    /**
+     * Compares two sets, regardless of the insertion order.
+     *
+     * @param other Other set
+     * @return True if both sets hold the same coordinates
+     */
+    bool CoordinateSet::operator==(const CoordinateSet &other) const {
+        if (used != other.used)
+            return false;
+        for (size_t i = 0; i < capacity; i++) {
+            if (control[i] >= 0 && other.findKey(slots[i]) == NOT_FOUND)
+                return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,119 @@
+#ifndef COORDINATESET_H
+#define COORDINATESET_H
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace GameOfLife::Game {
+    /**
+     * Open-addressing set of cell coordinates.
+     * Coordinates are packed in 64-bit keys stored in a flat array, next to one control byte per slot
+     * (empty, deleted, or 7 bits of the hash). Lookups compare 16 control bytes at once.
+     */
+    class CoordinateSet {
+    public:
+        /**
+         * Forward iterator over the coordinates, yielding (row, column) pairs by value.
+         */
+        class Iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::pair<int, int>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::pair<int, int>;
+
+            Iterator() = default;
+            Iterator(const CoordinateSet *set, size_t index) : set(set), index(index) { skipFree(); }
+
+            std::pair<int, int> operator*() const { return unpack(set->slots[index]); }
+            Iterator &operator++() { index++; skipFree(); return *this; }
+            Iterator operator++(int) { Iterator copy = *this; ++*this; return copy; }
+            bool operator==(const Iterator &other) const { return index == other.index; }
+            bool operator!=(const Iterator &other) const { return index != other.index; }
+
+        private:
+            const CoordinateSet *set = nullptr;
+            size_t index = 0;
+
+            void skipFree() {
+                while (index < set->capacity && set->control[index] < 0)
+                    index++;
+            }
+        };
+
+        CoordinateSet() = default;
+        explicit CoordinateSet(size_t expected);
+        template<typename TIterator>
+        CoordinateSet(TIterator first, TIterator last) {
+            for (; first != last; ++first)
+                insert(*first);
+        }
+
+        bool insert(const std::pair<int, int> &cell) { return insertKey(pack(cell.first, cell.second)); }
+        bool emplace(const int row, const int col) { return insertKey(pack(row, col)); }
+        size_t erase(const std::pair<int, int> &cell) { return eraseKey(pack(cell.first, cell.second)); }
+        [[nodiscard]] bool contains(const std::pair<int, int> &cell) const { return findKey(pack(cell.first, cell.second)) != NOT_FOUND; }
+        [[nodiscard]] size_t count(const std::pair<int, int> &cell) const { return contains(cell); }
+
+        void clear();
+        void reserve(size_t expected);
+
+        [[nodiscard]] size_t size() const { return used; }
+        [[nodiscard]] bool empty() const { return used == 0; }
+
+        [[nodiscard]] Iterator begin() const { return {this, 0}; }
+        [[nodiscard]] Iterator end() const { return {this, capacity}; }
+
+        bool operator==(const CoordinateSet &other) const;
+
+        /**
+         * Packs a coordinate in a 64-bit key, row in the high half and column in the low half.
+         */
+        static uint64_t pack(const int row, const int col) {
+            return static_cast<uint64_t>(static_cast<uint32_t>(row)) << 32 | static_cast<uint32_t>(col);
+        }
+
+        /**
+         * Unpacks a 64-bit key into a coordinate.
+         */
+        static std::pair<int, int> unpack(const uint64_t key) {
+            return {static_cast<int32_t>(key >> 32), static_cast<int32_t>(key)};
+        }
+
+        /**
+         * Mixes all bits of a packed key (MurmurHash3 finalizer), so neighboring and diagonal cells spread evenly.
+         */
+        static uint64_t hash(uint64_t key) {
+            key ^= key >> 33;
+            key *= 0xFF51AFD7ED558CCDull;
+            key ^= key >> 33;
+            key *= 0xC4CEB9FE1A85EC53ull;
+            key ^= key >> 33;
+            return key;
+        }
+
+    private:
+        static constexpr int GROUP_SIZE = 16;
+        static constexpr int8_t EMPTY = -128;
+        static constexpr int8_t DELETED = -2;
+        static constexpr size_t NOT_FOUND = SIZE_MAX;
+
+        // Control bytes, with the first group mirrored after the last slot so any group can be loaded at once
+        std::vector<int8_t> control;
+        std::vector<uint64_t> slots;
+        size_t capacity = 0;
+        size_t used = 0;
+        size_t deleted = 0;
+
+        [[nodiscard]] size_t findKey(uint64_t key) const;
+        bool insertKey(uint64_t key);
+        size_t eraseKey(uint64_t key);
+        void setControl(size_t index, int8_t value);
+        void rehash(size_t newCapacity);
+    };
+}
+
+#endif //COORDINATESET_H
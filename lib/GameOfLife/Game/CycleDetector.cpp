@@ -0,0 +1,68 @@
+#include "CycleDetector.h"
+
+#include <algorithm>
+
+namespace GameOfLife::Game {
+    /**
+     * Creates a detector.
+     *
+     * @param maxPeriod Longest period to detect, in generations (0 disables the detection)
+     * @param stepGenerations Generations advanced by each step of the grid
+     */
+    CycleDetector::CycleDetector(const uint64_t maxPeriod, const uint64_t stepGenerations) : ring(maxPeriod),
+        maxPeriod(maxPeriod), stepGenerations(stepGenerations) {}
+
+    /**
+     * Gets the key of a cell in a state, the keys of the living cells of a grid being XORed into its hash.
+     * Keys are drawn by a SplitMix64 finalizer from the coordinates and the state, so no table is needed.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param state Cell state
+     * @return Key of the cell
+     */
+    uint64_t CycleDetector::key(const int64_t row, const int64_t col, const uint32_t state) {
+        const auto mix = [](uint64_t z) {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EB;
+            return z ^ (z >> 31);
+        };
+        return mix(mix(mix(static_cast<uint64_t>(row) + 0x9E3779B97F4A7C15) ^ static_cast<uint64_t>(col)) ^ state);
+    }
+
+    /**
+     * Records the hashes of a step, and looks for the same hashes among the recorded steps.
+     * The most recent match gives the shortest period; hashes of 64 bits make a false match very unlikely, and
+     * confirm() rules it out. A translatable grid whose shape matches has moved by the offset of its bounding box.
+     * When a step advances several generations, the match only gives a multiple of the period, which is not exact.
+     *
+     * @param generation Generation of the grid after the step, increasing with each call
+     * @return Period, if the grid repeats a recorded step at most maxPeriod generations ago
+     */
+    std::optional<CycleDetector::Cycle> CycleDetector::push(const uint64_t generation) {
+        if (ring.empty())
+            return std::nullopt;
+
+        std::optional<Cycle> cycle;
+        for (size_t k = 1; k <= count; k++) {
+            const Entry &entry = ring[(next + ring.size() - k) % ring.size()];
+            if (generation - entry.generation > maxPeriod)
+                break;
+            if (entry.hash == hash) {
+                cycle = Cycle{generation - entry.generation, steps - entry.step, 0, 0, stepGenerations == 1};
+                break;
+            }
+            if (translatable && entry.shape == shape) {
+                cycle = Cycle{generation - entry.generation, steps - entry.step, minRow - entry.minRow, minCol - entry.minCol,
+                    stepGenerations == 1};
+                break;
+            }
+        }
+
+        ring[next] = {hash, shape, minRow, minCol, generation, steps};
+        next = (next + 1) % ring.size();
+        count = std::min(count + 1, ring.size());
+        steps++;
+        return cycle;
+    }
+}
@@ -0,0 +1,265 @@
+#ifndef CYCLEDETECTOR_H
+#define CYCLEDETECTOR_H
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+
+namespace GameOfLife::Game {
+    /**
+     * Detects when a grid returns to an earlier state, possibly translated.
+     * The grid is summarized by a Zobrist-style hash, the XOR of a random key per living cell and state, which only
+     * needs the births and deaths of a step to be updated. Grids that can be translated, the unbounded engines, also
+     * get a hash of their cells relative to their bounding box, so spaceships are found with their displacement. The
+     * hashes of the last generations are kept in a ring, so any period up to the limit is found without storing the
+     * grids themselves. A period found by the hashes can then be confirmed by comparing the cells one period later.
+     */
+    class CycleDetector {
+    public:
+        /**
+         * Period of a grid: its length in generations and in steps, and the displacement of the cells over a period.
+         * When a step advances several generations, the grid is only seen every few generations, so the length found is
+         * a multiple of the period, the smallest one that is also a multiple of the generations per step.
+         */
+        struct Cycle {
+            uint64_t period;
+            uint64_t steps;
+            int64_t dRow;
+            int64_t dCol;
+            bool exact = true;
+
+            bool operator==(const Cycle &other) const = default;
+        };
+
+        /**
+         * Living cell of a grid, in any state but 0.
+         */
+        struct Cell {
+            int64_t row;
+            int64_t col;
+            uint8_t state;
+
+            auto operator<=>(const Cell &other) const = default;
+        };
+
+    private:
+        struct Entry {
+            uint64_t hash;
+            uint64_t shape;
+            int64_t minRow;
+            int64_t minCol;
+            uint64_t generation;
+            uint64_t step;
+        };
+
+        std::vector<Entry> ring;
+        size_t next = 0;
+        size_t count = 0;
+        uint64_t maxPeriod;
+        uint64_t stepGenerations;
+        uint64_t steps = 0;
+
+        // Hash of the cells, and for translatable grids the hash of the cells relative to their bounding box
+        uint64_t hash = 0;
+        uint64_t shape = 0;
+        int64_t minRow = 0;
+        int64_t minCol = 0;
+        bool translatable = false;
+
+        // Dimensions of the hashed grid, and the states of its cells for multi-state grids
+        int rows = -1;
+        int cols = -1;
+        std::vector<uint8_t> states;
+
+        // Period waiting to be confirmed, with the cells expected at the end of the period
+        std::optional<Cycle> expected;
+        uint64_t expectedStep = 0;
+        std::vector<Cell> expectedCells;
+
+        template<typename TGrid>
+        static constexpr bool isMultiState = requires(const TGrid &grid) { grid.getState(0, 0); };
+
+        template<typename TGrid>
+        static constexpr bool isTranslatable = requires(TGrid &grid) {
+            grid.getUniverseCells();
+            grid.translate(int64_t{0}, int64_t{0});
+        };
+
+        template<typename TGrid>
+        void rehash(const TGrid &grid) {
+            rows = grid.getRows();
+            cols = grid.getCols();
+            translatable = isTranslatable<TGrid>;
+            const std::vector<Cell> cells = collect(grid);
+            if constexpr (isMultiState<TGrid>) {
+                states.assign(static_cast<size_t>(rows) * cols, 0);
+                for (const Cell &cell : cells) {
+                    states[cell.row * cols + cell.col] = cell.state;
+                }
+            }
+
+            hash = 0;
+            for (const Cell &cell : cells) {
+                hash ^= key(cell.row, cell.col, cell.state);
+            }
+            shape = 0;
+            minRow = 0;
+            minCol = 0;
+            if (translatable && !cells.empty()) {
+                minRow = cells.front().row;
+                minCol = std::ranges::min_element(cells, {}, &Cell::col)->col;
+                for (const Cell &cell : cells) {
+                    shape ^= key(cell.row - minRow, cell.col - minCol, cell.state);
+                }
+            }
+        }
+
+    public:
+        explicit CycleDetector(uint64_t maxPeriod = 64, uint64_t stepGenerations = 1);
+
+        [[nodiscard]] static uint64_t key(int64_t row, int64_t col, uint32_t state);
+
+        /**
+         * Gets the living cells of a grid, sorted. Unbounded grids give all their cells, in the visible window or not.
+         *
+         * @param grid Grid
+         * @return Living cells
+         */
+        template<typename TGrid>
+        [[nodiscard]] static std::vector<Cell> collect(const TGrid &grid) {
+            std::vector<Cell> cells;
+            if constexpr (isTranslatable<TGrid>) {
+                for (const auto &[row, col] : grid.getUniverseCells()) {
+                    cells.push_back({row, col, 1});
+                }
+            }
+            else if constexpr (isMultiState<TGrid>) {
+                for (int i = 0; i < grid.getRows(); i++) {
+                    for (int j = 0; j < grid.getCols(); j++) {
+                        if (const uint8_t state = grid.getState(i, j))
+                            cells.push_back({i, j, state});
+                    }
+                }
+            }
+            else {
+                for (const auto &[row, col] : grid.getLivingCells()) {
+                    cells.push_back({row, col, 1});
+                }
+            }
+            std::ranges::sort(cells);
+            return cells;
+        }
+
+        /**
+         * Hashes every cell of a grid, and forgets the earlier generations.
+         *
+         * @param grid Grid
+         */
+        template<typename TGrid>
+        void track(const TGrid &grid) {
+            if (maxPeriod == 0)
+                return;
+            rehash(grid);
+            next = 0;
+            count = 0;
+            expected.reset();
+        }
+
+        /**
+         * Updates the hashes after a step, from the changed cells when the grid keeps them, else from its living cells.
+         * A grid that was resized is tracked again, its cells having moved.
+         *
+         * @param grid Grid
+         */
+        template<typename TGrid>
+        void update(const TGrid &grid) {
+            if (maxPeriod == 0)
+                return;
+            if (grid.getRows() != rows || grid.getCols() != cols) {
+                track(grid);
+                return;
+            }
+            if constexpr (requires { grid.getChangedCells(); }) {
+                for (const auto &[row, col] : grid.getChangedCells()) {
+                    if constexpr (isMultiState<TGrid>) {
+                        uint8_t &previous = states[static_cast<size_t>(row) * cols + col];
+                        const uint8_t state = grid.getState(row, col);
+                        if (previous != 0)
+                            hash ^= key(row, col, previous);
+                        if (state != 0)
+                            hash ^= key(row, col, state);
+                        previous = state;
+                    }
+                    else
+                        hash ^= key(row, col, 1);
+                }
+            }
+            else
+                rehash(grid);
+        }
+
+        /**
+         * Waits for a period found by the hashes to be confirmed, remembering the cells the grid should have once
+         * the period is over.
+         *
+         * @param grid Grid
+         * @param cycle Period found by the hashes
+         */
+        template<typename TGrid>
+        void expect(const TGrid &grid, const Cycle &cycle) {
+            expected = cycle;
+            expectedStep = steps + cycle.steps;
+            expectedCells = collect(grid);
+            for (Cell &cell : expectedCells) {
+                cell.row += cycle.dRow;
+                cell.col += cycle.dCol;
+            }
+        }
+
+        /**
+         * Confirms the awaited period once it is over, by comparing the cells of the grid with the expected ones.
+         * The rules are deterministic, so a grid that repeats its cells once repeats them forever.
+         *
+         * @param grid Grid
+         * @return The period, if it was awaited, is over, and the cells match
+         */
+        template<typename TGrid>
+        std::optional<Cycle> confirm(const TGrid &grid) {
+            if (!expected || steps < expectedStep)
+                return std::nullopt;
+            std::optional<Cycle> confirmed;
+            if (collect(grid) == expectedCells)
+                confirmed = expected;
+            expected.reset();
+            expectedCells.clear();
+            return confirmed;
+        }
+
+        /**
+         * Skips whole periods of a confirmed cycle: the grid of the same phase, moved by the displacement of every
+         * skipped period, is the grid of the later generation.
+         *
+         * @param grid Grid
+         * @param cycle Confirmed period
+         * @param repetitions Number of periods to skip
+         * @return Number of generations skipped
+         */
+        template<typename TGrid>
+        static uint64_t skip(TGrid &grid, const Cycle &cycle, const uint64_t repetitions) {
+            if constexpr (isTranslatable<TGrid>)
+                grid.translate(cycle.dRow * static_cast<int64_t>(repetitions), cycle.dCol * static_cast<int64_t>(repetitions));
+            return cycle.period * repetitions;
+        }
+
+        std::optional<Cycle> push(uint64_t generation);
+
+        [[nodiscard]] bool isExpecting() const { return expected.has_value(); }
+        [[nodiscard]] uint64_t getHash() const { return hash; }
+        [[nodiscard]] uint64_t getShape() const { return shape; }
+        [[nodiscard]] uint64_t getMaxPeriod() const { return maxPeriod; }
+    };
+}
+
+
+#endif //CYCLEDETECTOR_H
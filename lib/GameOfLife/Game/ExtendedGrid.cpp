@@ -1,8 +1,9 @@
 #include "ExtendedGrid.h"
+#include <bit>
 #include <iostream>
-#include <mutex>
 #include <sstream>
-#include <thread>
+
+#include "StepKernel.h"
 
 
 namespace GameOfLife::Game {
@@ -16,9 +17,12 @@ namespace GameOfLife::Game {
      * @param isDynamic Dynamic
      */
     ExtendedGrid::ExtendedGrid(const int rows, const int cols, const int maxRows, const int maxCols, const bool isDynamic) :
-    rows(rows), cols(cols), maxRows(maxRows), maxCols(maxCols), isDynamic(isDynamic) {
-        cells.resize(rows, std::vector<Cell>(cols));
-        next = cells;
+    rows(rows), cols(cols), maxRows(maxRows), maxCols(maxCols), wordsPerRow((cols + 63) / 64),
+    stride((wordsPerRow + 7) & ~7), isDynamic(isDynamic) {
+        cells.resize(static_cast<size_t>(rows) * stride);
+        obstacles.resize(cells.size());
+        next.resize(cells.size());
+        changed.resize(cells.size());
     }
 
     /**
@@ -32,51 +36,55 @@ namespace GameOfLife::Game {
      * @param isDynamic Dynamic
      */
     ExtendedGrid::ExtendedGrid(const std::vector<std::vector<Cell>> &cells, const int rows, const int cols, const int maxRows, const int maxCols, const bool isDynamic) :
-    rows(rows), cols(cols), maxRows(maxRows), maxCols(maxCols), isDynamic(isDynamic) {
-        this->cells = cells;
-        next = cells;
-
-        // Populate living cells
+    ExtendedGrid(rows, cols, maxRows, maxCols, isDynamic) {
+        // Pack the cells
         for (int i = 0; i < rows; i++) {
             for (int j = 0; j < cols; j++) {
-                if (cells[i][j].isAlive())
-                    livingCells.insert(std::make_pair(i, j));
+                setBit(this->cells, i, j, cells[i][j].isAlive());
+                setBit(obstacles, i, j, cells[i][j].isObstacle());
             }
         }
 
-        changedCells = livingCells;
+        changed = this->cells;
     }
 
     /**
-     * Set a cell to be alive or dead
+     * Set a bit of a plane
      *
+     * @param plane Bitplane
      * @param row Cell's row
      * @param col Cell's column
-     * @param alive Alive
+     * @param value Bit value
      */
-    void ExtendedGrid::setAlive(int row, int col, const bool alive) {
-        cells[row][col] = alive;
-        if (alive)
-            livingCells.insert(std::make_pair(row, col));
-        else
-            livingCells.erase(std::make_pair(row, col));
+    void ExtendedGrid::setBit(Plane &plane, const int row, const int col, const bool value) {
+        uint64_t &word = plane[static_cast<size_t>(row) * stride + col / 64];
+        const uint64_t bit = uint64_t{1} << (col % 64);
+        word = value ? word | bit : word & ~bit;
     }
 
     /**
-     * Set a cell to be alive or dead in the next generation
+     * Get a bit of a plane
      *
+     * @param plane Bitplane
      * @param row Cell's row
      * @param col Cell's column
-     * @param alive Alive
+     * @return Bit value
      */
-    void ExtendedGrid::setAliveNext(int row, int col, const bool alive) {
-        next[row][col] = alive;
-        if (alive)
-            livingCells.emplace(row, col);
-        else
-            livingCells.erase(std::make_pair(row, col));
+    bool ExtendedGrid::getBit(const Plane &plane, const int row, const int col) const {
+        return plane[static_cast<size_t>(row) * stride + col / 64] >> (col % 64) & 1;
+    }
 
-        changedCells.emplace(row, col);
+    /**
+     * Set a cell to be alive or dead
+     *
+     * @param row Cell's row
+     * @param col Cell's column
+     * @param alive Alive
+     */
+    void ExtendedGrid::setAlive(int row, int col, const bool alive) {
+        if (isAlive(row, col) != alive)
+            setBit(changed, row, col, true);
+        setBit(cells, row, col, alive);
     }
 
     /**
@@ -87,7 +95,7 @@ namespace GameOfLife::Game {
      * @return Alive
      */
     bool ExtendedGrid::isAlive(const int row, const int col) const {
-        return cells[row][col].isAlive();
+        return getBit(cells, row, col);
     }
 
     /**
@@ -98,7 +106,7 @@ namespace GameOfLife::Game {
      * @return Obstacle
      */
     bool ExtendedGrid::isObstacle(int row, int col) const {
-        return cells[row][col].isObstacle();
+        return getBit(obstacles, row, col);
     }
 
     /**
@@ -122,7 +130,7 @@ namespace GameOfLife::Game {
                 const int wrappedCol = wrap ? (j + cols) % cols : j;
 
                 if (wrappedRow >= 0 && wrappedRow < rows && wrappedCol >= 0 && wrappedCol < cols) {
-                    count += cells[wrappedRow][wrappedCol].isAlive();
+                    count += isAlive(wrappedRow, wrappedCol);
                 }
             }
         }
@@ -137,187 +145,87 @@ namespace GameOfLife::Game {
      * @param dynamic Dynamic resizing
      */
     void ExtendedGrid::step(const bool wrap, const bool dynamic) {
-        // Clear the changed cells
-        changedCells.clear();
+        bytesCopied = 0;
 
         // Check if the grid should be resized
         if (isDynamic && !wrap && dynamic) {
             // Check if a living cell is on the edge
             bool onEdgeNorth = false, onEdgeEast = false, onEdgeSouth = false, onEdgeWest = false;
-            for (auto &cell : livingCells) {
-                if (cell.first == 0) {
-                    onEdgeNorth = true;
-                } else if (cell.first == rows - 1) {
-                    onEdgeSouth = true;
-                } else if (cell.second == 0) {
-                    onEdgeWest = true;
-                } else if (cell.second == cols - 1) {
-                    onEdgeEast = true;
-                }
+            for (int w = 0; w < wordsPerRow; w++) {
+                onEdgeNorth |= cells[w] != 0;
+                onEdgeSouth |= cells[static_cast<size_t>(rows - 1) * stride + w] != 0;
             }
-            resize(onEdgeNorth ? 1 : 0, onEdgeEast ? 1 : 0, onEdgeSouth ? 1 : 0, onEdgeWest ? 1 : 0);
-        }
-
-        if (livingCells.size() > multiThreadedThreshold) {
-            multiThreadedStep(wrap);
-            return;
-        }
-
-        const std::pair<int, int> directions[] = {
-            { -1, -1 }, { -1, 0 }, { -1, 1 },
-            { 0, -1 }, {0, 0}, { 0, 1 },
-            { 1, -1 }, { 1, 0 }, { 1, 1 }
-        };
-
-        auto cellsToCheck = std::unordered_set<std::pair<int, int>, HashFunction>();
-
-        for (auto &cell : livingCells) {
-            const int row = cell.first;
-            const int col = cell.second;
-
-            for (auto &direction : directions) {
-                const int newRow = row + direction.first;
-                const int newCol = col + direction.second;
-
-                int wrappedRow = wrap ? (newRow + rows) % rows : newRow;
-                int wrappedCol = wrap ? (newCol + cols) % cols : newCol;
-
-                if (wrappedRow >= 0 && wrappedRow < rows && wrappedCol >= 0 && wrappedCol < cols) {
-                    cellsToCheck.insert(std::make_pair(wrappedRow, wrappedCol));
-                }
+            for (int i = 0; i < rows; i++) {
+                onEdgeWest |= isAlive(i, 0);
+                onEdgeEast |= isAlive(i, cols - 1);
             }
+            resize(onEdgeNorth ? 1 : 0, onEdgeEast ? 1 : 0, onEdgeSouth ? 1 : 0, onEdgeWest ? 1 : 0);
         }
 
-        // Check each cell
-        for (auto &cell : cellsToCheck) {
-            const int row = cell.first;
-            const int col = cell.second;
-
-            const int neighbors = countNeighbors(row, col, wrap);
-
-            if (!isObstacle(row, col))
-                setAliveNext(row, col, cells[row][col].willBeAlive(neighbors));
+        // Large grids are stepped in parallel bands of rows, each worker only writes its own rows and cache lines
+        if (static_cast<size_t>(rows) * cols > static_cast<size_t>(multiThreadedThreshold)) {
+            if (!pool)
+                pool = std::make_shared<ThreadPool>();
+            const int workers = pool->getWorkerCount();
+            const size_t band = (rows + workers - 1) / workers;
+            pool->parallelFor(rows, band, [&](const size_t begin, const size_t end, int) {
+                stepRows(static_cast<int>(begin), static_cast<int>(end), wrap);
+            });
         }
+        else
+            stepRows(0, rows, wrap);
 
-        // Move the next generation to the current generation
-        cells = next;
-
-        // Clear the next generation
-        for (auto &cell : livingCells) {
-            next[cell.first][cell.second] = false;
-        }
+        std::swap(cells, next);
     }
 
     /**
-     * Step the grid to the next generation
+     * Step a band of rows into the next generation, and record the changed cells
      *
+     * @param begin First row
+     * @param end Row after the last one
      * @param wrap Wrap around the grid (toroidal)
      */
-    void ExtendedGrid::step(const bool wrap) {
-        step(wrap, !wrap);
+    void ExtendedGrid::stepRows(const int begin, const int end, const bool wrap) {
+        const std::vector<uint64_t> empty(wordsPerRow);
+        for (int i = begin; i < end; i++) {
+            const size_t offset = static_cast<size_t>(i) * stride;
+            const uint64_t *above = i > 0 ? &cells[offset - stride] :
+                wrap ? &cells[static_cast<size_t>(rows - 1) * stride] : empty.data();
+            const uint64_t *below = i < rows - 1 ? &cells[offset + stride] :
+                wrap ? &cells[0] : empty.data();
+            StepKernel::stepRow(above, &cells[offset], below, &next[offset], wordsPerRow, cols, wrap, rule);
+
+            // Obstacles keep their state
+            const uint64_t *current = &cells[offset];
+            const uint64_t *obstacle = &obstacles[offset];
+            uint64_t *life = &next[offset];
+            uint64_t *change = &changed[offset];
+            for (int w = 0; w < wordsPerRow; w++) {
+                life[w] = (life[w] & ~obstacle[w]) | (current[w] & obstacle[w]);
+                change[w] = current[w] ^ life[w];
+            }
+        }
     }
 
     /**
      * Step the grid to the next generation
      */
     void ExtendedGrid::step() {
-        step(false, true);
+        step(false, false);
     }
 
     /**
-     * Step the grid to the next generation using multiple threads
+     * Step the grid to the next generation
      *
      * @param wrap Wrap around the grid (toroidal)
      */
-    void ExtendedGrid::multiThreadedStep(const bool wrap) {
-        // Assume that the size check has already been done
-
-        // Directions to check
-        const std::pair<int, int> directions[] = {
-            { -1, -1 }, { -1, 0 }, { -1, 1 },
-            { 0, -1 }, { 0, 0 }, { 0, 1 },
-            { 1, -1 }, { 1, 0 }, { 1, 1 }
-        };
-
-        auto cellsToCheck = std::unordered_set<std::pair<int, int>, HashFunction>();
-        std::mutex cellsToCheckMutex;
-        std::mutex nextMutex;
-
-        // Function to process a chunk of living cells
-        auto checkCells = [&](const int start, const int end) {
-            for (int idx = start; idx < end; ++idx) {
-                auto cell = *std::next(livingCells.begin(), idx);
-                const int row = cell.first;
-                const int col = cell.second;
-
-                for (auto &direction : directions) {
-                    const int newRow = row + direction.first;
-                    const int newCol = col + direction.second;
-
-                    int wrappedRow = wrap ? (newRow + rows) % rows : newRow;
-                    int wrappedCol = wrap ? (newCol + cols) % cols : newCol;
-
-                    if (wrappedRow >= 0 && wrappedRow < rows && wrappedCol >= 0 && wrappedCol < cols) {
-                        std::lock_guard lock(cellsToCheckMutex);
-                        cellsToCheck.insert(std::make_pair(wrappedRow, wrappedCol));
-                    }
-                }
-            }
-        };
-
-        int numThreads = std::thread::hardware_concurrency();
-        int cellsPerThread = livingCells.size() / numThreads;
-        std::vector<std::thread> threads;
-
-        for (int i = 0; i < numThreads; ++i) {
-            int start = i * cellsPerThread;
-            int end = (i == numThreads - 1) ? livingCells.size() : start + cellsPerThread;
-            threads.emplace_back(checkCells, start, end);
-        }
-
-        for (auto &thread : threads) {
-            thread.join();
-        }
-
-        // Check each cell
-        // Function to update a chunk of cells
-        auto updateCells = [&](const int start, const int end) {
-            for (int idx = start; idx < end; ++idx) {
-                auto cell = *std::next(cellsToCheck.begin(), idx);
-                const int row = cell.first;
-                const int col = cell.second;
-
-                const int neighbors = countNeighbors(row, col, wrap);
-
-                std::lock_guard nextLock(nextMutex);
-                setAliveNext(row, col, cells[row][col].willBeAlive(neighbors));
-            }
-        };
-
-        cellsPerThread = cellsToCheck.size() / numThreads;
-        threads.clear();
-
-        for (int i = 0; i < numThreads; ++i) {
-            int start = i * cellsPerThread;
-            int end = (i == numThreads - 1) ? cellsToCheck.size() : start + cellsPerThread;
-            threads.emplace_back(updateCells, start, end);
-        }
-
-        for (auto &thread : threads) {
-            thread.join();
-        }
-
-        // Move the next generation to the current generation
-        cells = next;
-
-        // Clear the next generation
-        for (auto &cell : livingCells) {
-            next[cell.first][cell.second] = false;
-        }
+    void ExtendedGrid::step(const bool wrap) {
+        step(wrap, false);
     }
 
     /**
      * Move a pattern
+     * The living cells are moved along with their obstacle flag, the obstacles at the original location stay
      *
      * @param fromRow Starting row
      * @param fromCol Starting column
@@ -327,7 +235,23 @@ namespace GameOfLife::Game {
      * @param toCol Destination column
      */
     void ExtendedGrid::move(const int fromRow, const int fromCol, const int numRows, const int numCols, const int toRow, const int toCol) {
-        BaseGrid::move(cells, livingCells, changedCells, fromRow, fromCol, numRows, numCols, toRow, toCol);
+        // Extract the submatrix and clear the original location
+        std::vector submatrix(numRows, std::vector<Cell>(numCols));
+        for (int i = 0; i < numRows; ++i) {
+            for (int j = 0; j < numCols; ++j) {
+                submatrix[i][j] = Cell(isAlive(fromRow + i, fromCol + j), isObstacle(fromRow + i, fromCol + j));
+                setAlive(fromRow + i, fromCol + j, false);
+            }
+        }
+
+        // Insert the submatrix at the new location
+        for (int i = 0; i < numRows; ++i) {
+            for (int j = 0; j < numCols; ++j) {
+                setAlive(toRow + i, toCol + j, submatrix[i][j].isAlive());
+                setBit(obstacles, toRow + i, toCol + j, submatrix[i][j].isObstacle());
+                setBit(changed, toRow + i, toCol + j, true);
+            }
+        }
     }
 
     /**
@@ -339,7 +263,50 @@ namespace GameOfLife::Game {
      * @param addWest Number of columns to add to the west
      */
     void ExtendedGrid::resize(const int addNorth, const int addEast, const int addSouth, const int addWest) {
-        BaseGrid::resize(cells, next, livingCells, addNorth, addEast, addSouth, addWest, rows, cols, maxRows, maxCols);
+        // Argument check
+        if (addNorth < 0 || addEast < 0 || addSouth < 0 || addWest < 0) {
+            throw std::invalid_argument("The number of rows and columns to add must be positive.");
+        }
+
+        // Check against the maximum size
+        if (rows + addNorth + addSouth > maxRows || cols + addEast + addWest > maxCols) {
+            return;
+        }
+        if (addNorth == 0 && addEast == 0 && addSouth == 0 && addWest == 0) {
+            return;
+        }
+
+        const int newRows = rows + addNorth + addSouth;
+        const int newCols = cols + addEast + addWest;
+        const int newWordsPerRow = (newCols + 63) / 64;
+        const int newStride = (newWordsPerRow + 7) & ~7;
+
+        // Copy each row of a plane, shifting its bits by the number of columns added to the west
+        const int wordShift = addWest / 64;
+        const int bitShift = addWest % 64;
+        auto grow = [&](const Plane &plane) {
+            Plane resized(static_cast<size_t>(newRows) * newStride);
+            for (int i = 0; i < rows; i++) {
+                const uint64_t *source = &plane[static_cast<size_t>(i) * stride];
+                uint64_t *destination = &resized[static_cast<size_t>(i + addNorth) * newStride];
+                for (int w = 0; w < wordsPerRow; w++) {
+                    destination[w + wordShift] |= source[w] << bitShift;
+                    if (bitShift != 0 && w + wordShift + 1 < newWordsPerRow)
+                        destination[w + wordShift + 1] |= source[w] >> (64 - bitShift);
+                }
+            }
+            return resized;
+        };
+        bytesCopied += 2 * cells.size() * sizeof(uint64_t);
+        cells = grow(cells);
+        obstacles = grow(obstacles);
+
+        rows = newRows;
+        cols = newCols;
+        wordsPerRow = newWordsPerRow;
+        stride = newStride;
+        next.assign(cells.size(), 0);
+        changed = cells;
     }
 
     /**
@@ -351,7 +318,26 @@ namespace GameOfLife::Game {
      * @param hollow If true, only the living cells will be inserted
      */
     void ExtendedGrid::insert(const std::vector<std::vector<Cell>> &cells, const int row, const int col, const bool hollow) {
-        BaseGrid::insert(this->cells, livingCells, changedCells, cells, row, col, rows, cols, maxRows, maxCols, hollow);
+        // Argument check
+        if (row < 0 || row >= rows || col < 0 || col >= cols) {
+            throw std::invalid_argument("The row and column must be within the grid.");
+        }
+
+        // Check against the maximum size
+        if (row + static_cast<int>(cells.size()) > maxRows || col + static_cast<int>(cells[0].size()) > maxCols) {
+            return;
+        }
+
+        // Insert the cells that fit in the grid
+        for (int i = 0; i < static_cast<int>(cells.size()) && row + i < rows; ++i) {
+            for (int j = 0; j < static_cast<int>(cells[i].size()) && col + j < cols; ++j) {
+                if (!hollow || cells[i][j].isAlive()) {
+                    setAlive(row + i, col + j, cells[i][j].isAlive());
+                    setBit(obstacles, row + i, col + j, cells[i][j].isObstacle());
+                    setBit(changed, row + i, col + j, true);
+                }
+            }
+        }
     }
 
     /**
@@ -366,22 +352,22 @@ namespace GameOfLife::Game {
             for (int j = 0; j < cols; j++) {
                 if ((rand() % 100) < aliveProbability * 100) {
                     setAlive(i, j, true);
-                    changedCells.insert(std::make_pair(i, j));
+                    setBit(changed, i, j, true);
                 }
             }
         }
     }
 
     /**
-     * Clear the grid
+     * Clear the grid, obstacles included
      */
     void ExtendedGrid::clear() {
-        // Clear the living cells
-        for (auto &row : cells) {
-            std::fill(row.begin(), row.end(), Cell(false, false));
+        for (size_t w = 0; w < cells.size(); w++) {
+            changed[w] |= cells[w] | obstacles[w];
         }
-        livingCells.clear();
-        next = cells;
+        std::fill(cells.begin(), cells.end(), 0);
+        std::fill(obstacles.begin(), obstacles.end(), 0);
+        std::fill(next.begin(), next.end(), 0);
     }
 
     /**
@@ -402,12 +388,70 @@ namespace GameOfLife::Game {
     void ExtendedGrid::print(const int fromRow, const int fromCol, const int toRow, const int toCol) const {
         for (int i = fromRow; i < toRow; i++) {
             for (int j = fromCol; j < toCol; j++) {
-                std::cout << (cells[i][j] ? formatConfig.getAliveChar() : formatConfig.getDeadChar()) << formatConfig.getDelimiterChar();
+                std::cout << (isAlive(i, j) ? formatConfig.getAliveChar() : formatConfig.getDeadChar()) << formatConfig.getDelimiterChar();
             }
             std::cout << std::endl;
         }
     }
 
+    /**
+     * Get the cells, unpacked from the bitplanes
+     *
+     * @return Cells
+     */
+    std::vector<std::vector<Cell>> ExtendedGrid::getCells() const {
+        std::vector unpacked(rows, std::vector<Cell>(cols));
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                unpacked[i][j] = Cell(isAlive(i, j), isObstacle(i, j));
+            }
+        }
+        return unpacked;
+    }
+
+    /**
+     * Get the coordinates of the living cells
+     *
+     * @return Set of living cells
+     */
+    CoordinateSet ExtendedGrid::getLivingCells() const {
+        CoordinateSet livingCells;
+        for (size_t w = 0; w < cells.size(); w++) {
+            for (uint64_t word = cells[w]; word != 0; word &= word - 1) {
+                livingCells.emplace(w / stride, (w % stride) * 64 + std::countr_zero(word));
+            }
+        }
+        return livingCells;
+    }
+
+    /**
+     * Get the coordinates of the cells that changed during the last generation
+     *
+     * @return Set of changed cells
+     */
+    CoordinateSet ExtendedGrid::getChangedCells() const {
+        CoordinateSet changedCells;
+        for (size_t w = 0; w < changed.size(); w++) {
+            for (uint64_t word = changed[w]; word != 0; word &= word - 1) {
+                changedCells.emplace(w / stride, (w % stride) * 64 + std::countr_zero(word));
+            }
+        }
+        return changedCells;
+    }
+
+    /**
+     * Get the number of living cells
+     *
+     * @return Number of living cells
+     */
+    size_t ExtendedGrid::getPopulation() const {
+        size_t population = 0;
+        for (const uint64_t word : cells) {
+            population += std::popcount(word);
+        }
+        return population;
+    }
+
     /**
      * IWritable implementation
      * Get the text representation of the grid
@@ -418,8 +462,8 @@ namespace GameOfLife::Game {
         std::stringstream ss;
         for (int i = 0; i < rows; i++) {
             for (int j = 0; j < cols; j++) {
-                ss << (cells[i][j].isObstacle() ? (cells[i][j] ? livingObstacle : deadObstacle) :
-                    (cells[i][j] ? formatConfig.getAliveChar() : formatConfig.getDeadChar()))
+                ss << (isObstacle(i, j) ? (isAlive(i, j) ? livingObstacle : deadObstacle) :
+                    (isAlive(i, j) ? formatConfig.getAliveChar() : formatConfig.getDeadChar()))
                 << formatConfig.getDelimiterChar();
             }
             ss << '\n';
@@ -1,39 +1,52 @@
 #ifndef EXTENDEDGRID_H
 #define EXTENDEDGRID_H
-#include <unordered_set>
+#include <cstdint>
 #include <vector>
 
+#include "AlignedAllocator.h"
 #include "Cell.h"
 #include "BaseGrid.h"
-#include "HashFunction.h"
+#include "CoordinateSet.h"
+#include "Rules.h"
+#include "ThreadPool.h"
 #include "File/FormatConfig.h"
 
 
 namespace GameOfLife::Game {
     /**
      * Advanced implementation of a grid, supporting obstacles
+     * Cells are stored as two packed bitplanes, one for the living cells and one for the obstacles
+     * Rows of the bitplanes start on a cache line, so the bands of rows stepped in parallel never share one
      */
     class ExtendedGrid : public BaseGrid<std::vector<std::vector<Cell>>, Cell> {
     private:
-        std::vector<std::vector<Cell>> cells;
-        std::vector<std::vector<Cell>> next;
-        std::unordered_set<std::pair<int, int>, HashFunction> livingCells;
-        std::unordered_set<std::pair<int, int>, HashFunction> changedCells;
+        using Plane = std::vector<uint64_t, AlignedAllocator<uint64_t>>;
+
+        Plane cells;
+        Plane obstacles;
+        Plane next;
+        Plane changed;
 
         int rows;
         int cols;
         int maxRows;
         int maxCols;
+        int wordsPerRow;
+        int stride; // Words from a row to the next, whole cache lines
 
+        std::shared_ptr<ThreadPool> pool;
         int multiThreadedThreshold = 100000;
+        size_t bytesCopied = 0;
+        IsotropicRule rule;
         bool isDynamic;
 
         File::FormatConfig formatConfig = File::FormatConfig('1', '0', ' ');
         char livingObstacle = 'x';
         char deadObstacle = 'o';
 
-        void setAliveNext(int row, int col, bool alive);
-        void multiThreadedStep(bool wrap);
+        void setBit(Plane &plane, int row, int col, bool value);
+        [[nodiscard]] bool getBit(const Plane &plane, int row, int col) const;
+        void stepRows(int begin, int end, bool wrap);
 
     public:
         ExtendedGrid() = delete;
@@ -59,7 +72,7 @@ namespace GameOfLife::Game {
         void print() const override;
         void print(int fromRow, int fromCol, int toRow, int toCol) const override;
 
-        [[nodiscard]] std::vector<std::vector<Cell>> getCells() const override { return cells; }
+        [[nodiscard]] std::vector<std::vector<Cell>> getCells() const override;
 
         [[nodiscard]] int getRows() const override { return rows; }
         [[nodiscard]] int getCols() const override { return cols; }
@@ -67,8 +80,13 @@ namespace GameOfLife::Game {
         [[nodiscard]] int getMaxRows() const { return maxRows; }
         [[nodiscard]] int getMaxCols() const { return maxCols; }
 
-        [[nodiscard]] std::unordered_set<std::pair<int, int>, HashFunction> getLivingCells() const { return livingCells; }
-        [[nodiscard]] std::unordered_set<std::pair<int, int>, HashFunction> getChangedCells() const { return changedCells; }
+        [[nodiscard]] CoordinateSet getLivingCells() const;
+        [[nodiscard]] CoordinateSet getChangedCells() const;
+        [[nodiscard]] size_t getPopulation() const;
+        [[nodiscard]] size_t getBytesCopied() const { return bytesCopied; }
+
+        void setRule(const IsotropicRule &rule) { this->rule = rule; }
+        [[nodiscard]] const IsotropicRule &getRule() const { return rule; }
 
         void setFormatConfig(const File::FormatConfig &formatConfig) { this->formatConfig = formatConfig; }
         [[nodiscard]] File::FormatConfig getFormatConfig() const { return formatConfig; }
@@ -0,0 +1,124 @@
+#include "FFT.h"
+
+#include <bit>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+
+namespace GameOfLife::Game {
+    /**
+     * Builds the plan of a transform.
+     *
+     * @param size Size of the transform, a power of two
+     */
+    FFT::FFT(const int size) : size(size) {
+        if (size < 1 || !std::has_single_bit(static_cast<unsigned>(size)))
+            throw std::invalid_argument("The size of the transform must be a power of two.");
+
+        const int bits = std::countr_zero(static_cast<unsigned>(size));
+        reversed.resize(size);
+        for (int i = 1; i < size; i++) {
+            reversed[i] = reversed[i >> 1] >> 1 | (i & 1) << (bits - 1);
+        }
+
+        // Twiddles in double precision, so large transforms keep their accuracy
+        twiddles.resize(size / 2);
+        for (int k = 0; k < size / 2; k++) {
+            const double angle = -2 * std::numbers::pi * k / size;
+            twiddles[k] = {static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle))};
+        }
+    }
+
+    /**
+     * Gets the smallest power of two greater than or equal to a number.
+     *
+     * @param n Number
+     * @return Power of two
+     */
+    int FFT::nextPowerOfTwo(const int n) {
+        return n <= 1 ? 1 : static_cast<int>(std::bit_ceil(static_cast<unsigned>(n)));
+    }
+
+    /**
+     * Transforms a sequence in place. The inverse transform is not scaled by 1 / size.
+     *
+     * @param data Sequence of size elements
+     * @param inverse Inverse transform
+     */
+    void FFT::transform(std::complex<float> *data, const bool inverse) const {
+        for (int i = 0; i < size; i++) {
+            if (i < reversed[i])
+                std::swap(data[i], data[reversed[i]]);
+        }
+
+        // Butterflies, the twiddles of a stage of length n are every size / n twiddle.
+        // The products are written out, std::complex would check every product for infinities and NaNs.
+        const float sign = inverse ? -1.0f : 1.0f;
+        for (int length = 2; length <= size; length <<= 1) {
+            const int half = length / 2;
+            const int stride = size / length;
+            for (int begin = 0; begin < size; begin += length) {
+                for (int k = 0; k < half; k++) {
+                    const float wr = twiddles[k * stride].real();
+                    const float wi = sign * twiddles[k * stride].imag();
+                    const std::complex<float> even = data[begin + k];
+                    const std::complex<float> value = data[begin + k + half];
+                    const std::complex<float> odd(value.real() * wr - value.imag() * wi, value.real() * wi + value.imag() * wr);
+                    data[begin + k] = {even.real() + odd.real(), even.imag() + odd.imag()};
+                    data[begin + k + half] = {even.real() - odd.real(), even.imag() - odd.imag()};
+                }
+            }
+        }
+    }
+
+    /**
+     * Transforms two real sequences with one complex transform, the first as the real part and the second as the
+     * imaginary part. The spectrum of a real sequence is symmetric, so only its first size / 2 + 1 bins are written.
+     *
+     * @param first First real sequence
+     * @param second Second real sequence
+     * @param firstOut Spectrum of the first sequence, size / 2 + 1 bins
+     * @param secondOut Spectrum of the second sequence, size / 2 + 1 bins
+     * @param buffer Buffer of size elements
+     */
+    void FFT::forwardReal(const float *first, const float *second, std::complex<float> *firstOut,
+        std::complex<float> *secondOut, std::complex<float> *buffer) const {
+        for (int i = 0; i < size; i++) {
+            buffer[i] = {first[i], second[i]};
+        }
+        transform(buffer, false);
+        for (int k = 0; k <= size / 2; k++) {
+            const std::complex<float> z = buffer[k % size];
+            const std::complex<float> mirror = std::conj(buffer[(size - k) % size]);
+            firstOut[k] = (z + mirror) * 0.5f;
+            // (z - mirror) / 2i
+            secondOut[k] = {(z.imag() - mirror.imag()) * 0.5f, (mirror.real() - z.real()) * 0.5f};
+        }
+    }
+
+    /**
+     * Inverse of forwardReal: rebuilds two real sequences from the first size / 2 + 1 bins of their spectra, with one
+     * complex transform. The sequences are not scaled by 1 / size.
+     *
+     * @param first Spectrum of the first sequence
+     * @param second Spectrum of the second sequence
+     * @param firstOut First real sequence
+     * @param secondOut Second real sequence
+     * @param buffer Buffer of size elements
+     */
+    void FFT::inverseReal(const std::complex<float> *first, const std::complex<float> *second, float *firstOut,
+        float *secondOut, std::complex<float> *buffer) const {
+        // first + i second, the upper bins being the conjugates of the lower ones
+        for (int k = 0; k <= size / 2; k++) {
+            buffer[k % size] = {first[k].real() - second[k].imag(), first[k].imag() + second[k].real()};
+        }
+        for (int k = size / 2 + 1; k < size; k++) {
+            buffer[k] = {first[size - k].real() + second[size - k].imag(), second[size - k].real() - first[size - k].imag()};
+        }
+        transform(buffer, true);
+        for (int n = 0; n < size; n++) {
+            firstOut[n] = buffer[n].real();
+            secondOut[n] = buffer[n].imag();
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef FFT_H
+#define FFT_H
+#include <complex>
+#include <vector>
+
+namespace GameOfLife::Game {
+    /**
+     * Plan of a radix-2 complex FFT of a fixed size, a power of two.
+     * The bit-reversal permutation and the twiddle factors are computed once, so the plan is reused for every row and
+     * every step. Real transforms pack two real sequences in one complex transform.
+     */
+    class FFT {
+    private:
+        int size;
+        std::vector<int> reversed;
+        std::vector<std::complex<float>> twiddles;
+
+    public:
+        explicit FFT(int size);
+
+        [[nodiscard]] static int nextPowerOfTwo(int n);
+
+        void transform(std::complex<float> *data, bool inverse) const;
+        void forwardReal(const float *first, const float *second, std::complex<float> *firstOut,
+            std::complex<float> *secondOut, std::complex<float> *buffer) const;
+        void inverseReal(const std::complex<float> *first, const std::complex<float> *second, float *firstOut,
+            float *secondOut, std::complex<float> *buffer) const;
+
+        [[nodiscard]] int getSize() const { return size; }
+    };
+}
+
+#endif //FFT_H
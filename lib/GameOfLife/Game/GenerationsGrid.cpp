@@ -0,0 +1,404 @@
+#include "GenerationsGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "StepKernel.h"
+
+namespace GameOfLife::Game {
+    /**
+     * Constructs a grid with the specified number of rows and columns.
+     *
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param maxRows Maximum number of rows
+     * @param maxCols Maximum number of columns
+     * @param isDynamic Enable dynamic resizing
+     */
+    GenerationsGrid::GenerationsGrid(const int rows, const int cols, const int maxRows, const int maxCols, const bool isDynamic) :
+    rows(rows), cols(cols), maxRows(maxRows), maxCols(maxCols), wordsPerRow((cols + 63) / 64), isDynamic(isDynamic) {
+        cells.resize(static_cast<size_t>(rows) * cols);
+        next.resize(cells.size());
+        changed.resize(cells.size());
+        plane.resize(static_cast<size_t>(rows) * wordsPerRow);
+        nextPlane.resize(plane.size());
+    }
+
+    /**
+     * Constructs a grid from existing states.
+     *
+     * @param cells States to copy
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param maxRows Maximum number of rows
+     * @param maxCols Maximum number of columns
+     * @param isDynamic Enable dynamic resizing
+     */
+    GenerationsGrid::GenerationsGrid(const std::vector<std::vector<uint8_t>> &cells, const int rows, const int cols,
+        const int maxRows, const int maxCols, const bool isDynamic) :
+    GenerationsGrid(rows, cols, maxRows, maxCols, isDynamic) {
+        for (int i = 0; i < rows; i++) {
+            std::copy_n(cells[i].begin(), cols, &this->cells[static_cast<size_t>(i) * cols]);
+        }
+
+        for (size_t k = 0; k < this->cells.size(); k++) {
+            changed[k] = this->cells[k] != 0;
+        }
+    }
+
+    /**
+     * Gets the character of a state, as written in multi-state RLE: '.' for 0, then 'A' to 'X'.
+     *
+     * @param state State
+     * @return Character of the state, '+' past the 24th state
+     */
+    char GenerationsGrid::getSymbol(const uint8_t state) {
+        if (state == 0)
+            return '.';
+        return state <= 24 ? static_cast<char>('A' + state - 1) : '+';
+    }
+
+    /**
+     * Sets the cell at the specified row and column to be alive (state 1) or dead (state 0).
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param alive Alive status
+     */
+    void GenerationsGrid::setAlive(const int row, const int col, const bool alive) {
+        setState(row, col, alive);
+    }
+
+    /**
+     * Checks if the cell at the specified row and column is in a living state.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @return True if the cell is alive, false otherwise
+     */
+    bool GenerationsGrid::isAlive(const int row, const int col) const {
+        return rule.isAlive(getState(row, col));
+    }
+
+    /**
+     * Sets the state of the cell at the specified row and column.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param state State
+     */
+    void GenerationsGrid::setState(const int row, const int col, const uint8_t state) {
+        uint8_t &cell = cells[static_cast<size_t>(row) * cols + col];
+        if (cell != state)
+            changed[static_cast<size_t>(row) * cols + col] = 1;
+        cell = state;
+    }
+
+    /**
+     * Counts the number of living neighbors around the cell at the specified row and column.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param wrap Whether the grid should wrap around the edges
+     * @return Number of living neighbors
+     */
+    int GenerationsGrid::countNeighbors(const int row, const int col, const bool wrap) const {
+        int count = 0;
+
+        for (int i = row - 1; i <= row + 1; i++) {
+            for (int j = col - 1; j <= col + 1; j++) {
+                if (i == row && j == col) {
+                    continue;
+                }
+
+                const int wrappedRow = wrap ? (i + rows) % rows : i;
+                const int wrappedCol = wrap ? (j + cols) % cols : j;
+
+                if (wrappedRow >= 0 && wrappedRow < rows && wrappedCol >= 0 && wrappedCol < cols) {
+                    count += isAlive(wrappedRow, wrappedCol);
+                }
+            }
+        }
+
+        return count;
+    }
+
+    /**
+     * Runs a task over [0, count), in parallel bands if the grid is large enough.
+     *
+     * @param count Number of items
+     * @param task Task to run on each band
+     */
+    void GenerationsGrid::parallelFor(const size_t count, const ThreadPool::Task &task) {
+        if (static_cast<size_t>(rows) * cols <= static_cast<size_t>(multiThreadedThreshold)) {
+            task(0, count, 0);
+            return;
+        }
+
+        if (!pool)
+            pool = std::make_shared<ThreadPool>();
+        const int workers = pool->getWorkerCount();
+        pool->parallelFor(count, (count + workers - 1) / workers, task);
+    }
+
+    /**
+     * Steps the grid to the next generation.
+     *
+     * @param wrap If true, the grid will wrap around the edges. This will disable dynamic resizing.
+     * @param dynamic If true, the grid will resize if a living cell is on the edge (overrides isDynamic property).
+     */
+    void GenerationsGrid::step(const bool wrap, const bool dynamic) {
+        // Check if the grid should be resized, only the living states can spread
+        if (isDynamic && !wrap && dynamic) {
+            bool onEdgeNorth = false, onEdgeEast = false, onEdgeSouth = false, onEdgeWest = false;
+            for (int j = 0; j < cols; j++) {
+                onEdgeNorth |= isAlive(0, j);
+                onEdgeSouth |= isAlive(rows - 1, j);
+            }
+            for (int i = 0; i < rows; i++) {
+                onEdgeWest |= isAlive(i, 0);
+                onEdgeEast |= isAlive(i, cols - 1);
+            }
+            resize(onEdgeNorth ? 1 : 0, onEdgeEast ? 1 : 0, onEdgeSouth ? 1 : 0, onEdgeWest ? 1 : 0);
+        }
+
+        // Pack the living states, every row must be packed before its neighbors are stepped
+        parallelFor(rows, [&](const size_t begin, const size_t end, int) {
+            for (size_t i = begin; i < end; i++) {
+                StepKernel::packStates(&cells[i * cols], &plane[i * wordsPerRow], cols, rule);
+            }
+        });
+
+        // Step the living plane, then apply it to the states
+        const std::vector<uint64_t> empty(wordsPerRow);
+        parallelFor(rows, [&](const size_t begin, const size_t end, int) {
+            for (int i = static_cast<int>(begin); i < static_cast<int>(end); i++) {
+                const uint64_t *above = i > 0 ? &plane[static_cast<size_t>(i - 1) * wordsPerRow] :
+                    wrap ? &plane[static_cast<size_t>(rows - 1) * wordsPerRow] : empty.data();
+                const uint64_t *below = i < rows - 1 ? &plane[static_cast<size_t>(i + 1) * wordsPerRow] :
+                    wrap ? &plane[0] : empty.data();
+                uint64_t *out = &nextPlane[static_cast<size_t>(i) * wordsPerRow];
+                StepKernel::stepRow(above, &plane[static_cast<size_t>(i) * wordsPerRow], below, out, wordsPerRow, cols,
+                    wrap, rule.getLifeLike());
+
+                const size_t offset = static_cast<size_t>(i) * cols;
+                StepKernel::stepStates(&cells[offset], out, &next[offset], cols, rule);
+                for (size_t k = offset; k < offset + cols; k++) {
+                    changed[k] = cells[k] != next[k];
+                }
+            }
+        });
+
+        std::swap(cells, next);
+    }
+
+    /**
+     * Steps the grid to the next generation.
+     */
+    void GenerationsGrid::step() {
+        step(false, false);
+    }
+
+    /**
+     * Steps the grid to the next generation.
+     *
+     * @param wrap If true, the grid will wrap around the edges. This will disable dynamic resizing.
+     */
+    void GenerationsGrid::step(const bool wrap) {
+        step(wrap, false);
+    }
+
+    /**
+     * Resizes the grid by adding rows and columns to the north, east, south, and west.
+     *
+     * @param addNorth Number of rows to add to the north
+     * @param addEast Number of columns to add to the east
+     * @param addSouth Number of rows to add to the south
+     * @param addWest Number of columns to add to the west
+     */
+    void GenerationsGrid::resize(const int addNorth, const int addEast, const int addSouth, const int addWest) {
+        // Argument check
+        if (addNorth < 0 || addEast < 0 || addSouth < 0 || addWest < 0) {
+            throw std::invalid_argument("The number of rows and columns to add must be positive.");
+        }
+
+        // Check against the maximum size
+        if (rows + addNorth + addSouth > maxRows || cols + addEast + addWest > maxCols) {
+            return;
+        }
+        if (addNorth == 0 && addEast == 0 && addSouth == 0 && addWest == 0) {
+            return;
+        }
+
+        const int newRows = rows + addNorth + addSouth;
+        const int newCols = cols + addEast + addWest;
+        std::vector<uint8_t> resized(static_cast<size_t>(newRows) * newCols);
+        for (int i = 0; i < rows; i++) {
+            std::copy_n(&cells[static_cast<size_t>(i) * cols], cols,
+                &resized[static_cast<size_t>(i + addNorth) * newCols + addWest]);
+        }
+
+        rows = newRows;
+        cols = newCols;
+        wordsPerRow = (newCols + 63) / 64;
+        cells = std::move(resized);
+        next.assign(cells.size(), 0);
+        changed.assign(cells.size(), 0);
+        for (size_t k = 0; k < cells.size(); k++) {
+            changed[k] = cells[k] != 0;
+        }
+        plane.assign(static_cast<size_t>(rows) * wordsPerRow, 0);
+        nextPlane.assign(plane.size(), 0);
+    }
+
+    /**
+     * Inserts a pattern into the grid.
+     *
+     * @param cells The states to insert
+     * @param row The row to insert the pattern at
+     * @param col The column to insert the pattern at
+     * @param hollow If true, only the non-zero states will be inserted
+     */
+    void GenerationsGrid::insert(const std::vector<std::vector<uint8_t>> &cells, const int row, const int col, const bool hollow) {
+        // Argument check
+        if (row < 0 || row >= rows || col < 0 || col >= cols) {
+            throw std::invalid_argument("The row and column must be within the grid.");
+        }
+
+        // Check against the maximum size
+        if (row + cells.size() > maxRows || col + cells[0].size() > maxCols) {
+            return;
+        }
+
+        // Insert the cells that fit in the grid
+        for (int i = 0; i < cells.size() && row + i < rows; ++i) {
+            for (int j = 0; j < cells[i].size() && col + j < cols; ++j) {
+                if (!hollow || cells[i][j] != 0)
+                    setState(row + i, col + j, cells[i][j]);
+            }
+        }
+    }
+
+    /**
+     * Randomizes the grid with the specified probability of a cell being alive.
+     *
+     * @param aliveProbability Probability of a cell being alive
+     */
+    void GenerationsGrid::randomize(const float aliveProbability) {
+        if (aliveProbability < 0 || aliveProbability > 1)
+            return;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                if ((rand() % 100) < aliveProbability * 100)
+                    setState(i, j, 1);
+            }
+        }
+    }
+
+    /**
+     * Clears the grid.
+     */
+    void GenerationsGrid::clear() {
+        for (size_t k = 0; k < cells.size(); k++) {
+            changed[k] |= cells[k] != 0;
+        }
+        std::fill(cells.begin(), cells.end(), 0);
+        std::fill(next.begin(), next.end(), 0);
+    }
+
+    /**
+     * Prints the grid to the console.
+     */
+    void GenerationsGrid::print() const {
+        print(0, 0, rows, cols);
+    }
+
+    /**
+     * Prints a section of the grid to the console.
+     *
+     * @param fromRow The starting row
+     * @param fromCol The starting column
+     * @param toRow The ending row
+     * @param toCol The ending column
+     */
+    void GenerationsGrid::print(const int fromRow, const int fromCol, const int toRow, const int toCol) const {
+        for (int i = fromRow; i < toRow; i++) {
+            for (int j = fromCol; j < toCol; j++) {
+                std::cout << getSymbol(getState(i, j)) << ' ';
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    /**
+     * Gets the states as a 2D vector.
+     *
+     * @return States
+     */
+    std::vector<std::vector<uint8_t>> GenerationsGrid::getCells() const {
+        std::vector<std::vector<uint8_t>> result(rows);
+        for (int i = 0; i < rows; i++) {
+            result[i].assign(&cells[static_cast<size_t>(i) * cols], &cells[static_cast<size_t>(i) * cols] + cols);
+        }
+        return result;
+    }
+
+    /**
+     * Gets the coordinates of the living cells.
+     *
+     * @return Set of living cells
+     */
+    CoordinateSet GenerationsGrid::getLivingCells() const {
+        CoordinateSet livingCells;
+        for (size_t k = 0; k < cells.size(); k++) {
+            if (rule.isAlive(cells[k]))
+                livingCells.emplace(k / cols, k % cols);
+        }
+        return livingCells;
+    }
+
+    /**
+     * Gets the coordinates of the cells that changed state during the last generation.
+     *
+     * @return Set of changed cells
+     */
+    CoordinateSet GenerationsGrid::getChangedCells() const {
+        CoordinateSet changedCells;
+        for (size_t k = 0; k < changed.size(); k++) {
+            if (changed[k])
+                changedCells.emplace(k / cols, k % cols);
+        }
+        return changedCells;
+    }
+
+    /**
+     * Gets the number of living cells.
+     *
+     * @return Number of living cells
+     */
+    size_t GenerationsGrid::getPopulation() const {
+        return std::count_if(cells.begin(), cells.end(), [this](const uint8_t state) { return rule.isAlive(state); });
+    }
+
+    /**
+     * IWritable implementation.
+     * Gets the grid as a string, the dead and living states with the format characters and the others as in RLE.
+     *
+     * @return The grid as a string
+     */
+    std::string GenerationsGrid::getText() const {
+        std::stringstream ss;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                const uint8_t state = getState(i, j);
+                ss << (state == 0 ? formatConfig.getDeadChar() : state == 1 ? formatConfig.getAliveChar() : getSymbol(state))
+                    << formatConfig.getDelimiterChar();
+            }
+            ss << '\n';
+        }
+        return ss.str();
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef GENERATIONSGRID_H
+#define GENERATIONSGRID_H
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "BaseGrid.h"
+#include "CoordinateSet.h"
+#include "Rules.h"
+#include "ThreadPool.h"
+#include "File/FormatConfig.h"
+
+
+namespace GameOfLife::Game {
+    /**
+     * Grid for multi-state rules (Generations, LifeHistory), one byte per cell.
+     * Each generation packs the living states into a bitplane, steps the plane with the packed Life kernels, and
+     * applies the births, survivals and decays to the bytes with vectorized byte compares.
+     */
+    class GenerationsGrid : public BaseGrid<std::vector<std::vector<uint8_t>>, uint8_t> {
+    private:
+        std::vector<uint8_t> cells;
+        std::vector<uint8_t> next;
+        std::vector<uint8_t> changed;
+        std::vector<uint64_t> plane;
+        std::vector<uint64_t> nextPlane;
+
+        int rows;
+        int cols;
+        int maxRows;
+        int maxCols;
+        int wordsPerRow;
+
+        std::shared_ptr<ThreadPool> pool;
+        int multiThreadedThreshold = 100000;
+        GenerationsRule rule = GenerationsRule::lifeHistory();
+        bool isDynamic;
+
+        File::FormatConfig formatConfig = File::FormatConfig('A', '.', '\0');
+
+        void parallelFor(size_t count, const ThreadPool::Task &task);
+
+    public:
+        GenerationsGrid() = delete;
+        GenerationsGrid(int rows, int cols, int maxRows = 1000, int maxCols = 1000, bool isDynamic = true);
+        GenerationsGrid(const std::vector<std::vector<uint8_t>> &cells, int rows, int cols, int maxRows = 1000,
+            int maxCols = 1000, bool isDynamic = true);
+
+        static char getSymbol(uint8_t state);
+
+        void setAlive(int row, int col, bool alive) override;
+        [[nodiscard]] bool isAlive(int row, int col) const override;
+        void setState(int row, int col, uint8_t state);
+        [[nodiscard]] uint8_t getState(int row, int col) const { return cells[static_cast<size_t>(row) * cols + col]; }
+        [[nodiscard]] int countNeighbors(int row, int col, bool wrap) const override;
+
+        void step() override;
+        void step(bool wrap) override;
+        void step(bool wrap, bool dynamic);
+        void randomize(float aliveProbability) override;
+        void clear() override;
+
+        void resize(int addNorth, int addEast, int addSouth, int addWest);
+        void insert(const std::vector<std::vector<uint8_t>> &cells, int row, int col, bool hollow = false);
+
+        void print() const override;
+        void print(int fromRow, int fromCol, int toRow, int toCol) const override;
+
+        [[nodiscard]] std::vector<std::vector<uint8_t>> getCells() const override;
+
+        [[nodiscard]] int getRows() const override { return rows; }
+        [[nodiscard]] int getCols() const override { return cols; }
+
+        [[nodiscard]] int getMaxRows() const { return maxRows; }
+        [[nodiscard]] int getMaxCols() const { return maxCols; }
+
+        [[nodiscard]] CoordinateSet getLivingCells() const;
+        [[nodiscard]] CoordinateSet getChangedCells() const;
+        [[nodiscard]] size_t getPopulation() const;
+
+        void setRule(const GenerationsRule &rule) { this->rule = rule; }
+        [[nodiscard]] const GenerationsRule &getRule() const { return rule; }
+
+        void setFormatConfig(const File::FormatConfig &formatConfig) { this->formatConfig = formatConfig; }
+        [[nodiscard]] File::FormatConfig getFormatConfig() const { return formatConfig; }
+
+        [[nodiscard]] std::string getText() const override;
+    };
+}
+
+
+#endif //GENERATIONSGRID_H
@@ -1,12 +1,28 @@
 #include "Grid.h"
 
+#include <algorithm>
+#include <bit>
+#include <type_traits>
 #include <iostream>
 #include <sstream>
-#include <thread>
 
-#include "HashFunction.h"
+#include "CoordinateSet.h"
+#include "Random.h"
+#include "StepKernel.h"
 
 namespace GameOfLife::Game {
+    /**
+     * Step of each rule, in the order of the Rule enum.
+     */
+    const std::array<void (Grid::*)(bool), RULE_COUNT> Grid::stepFunctions = {
+        &Grid::presetStep<Conway>,
+        &Grid::presetStep<HighLife>,
+        &Grid::presetStep<Seeds>,
+        &Grid::presetStep<DayAndNight>,
+        &Grid::presetStep<LifeWithoutDeath>,
+        &Grid::presetStep<Maze>
+    };
+
     /**
      * Constructs a grid with the specified number of rows and columns.
      *
@@ -17,8 +33,8 @@ namespace GameOfLife::Game {
      * @param isDynamic Enable dynamic resizing
      */
     Grid::Grid(const int rows, const int cols, const int maxRows, const int maxCols, const bool isDynamic) :
-    rows(rows), cols(cols), maxRows(maxRows), maxCols(maxCols), isDynamic(isDynamic) {
-        cells.resize(rows, std::vector<bool>(cols));
+    rows(rows), cols(cols), maxRows(maxRows), maxCols(maxCols), storageRows(rows + 2), storageCols(cols + 2), isDynamic(isDynamic) {
+        cells.resize(storageRows, std::vector<bool>(storageCols));
         next = cells;
     }
 
@@ -32,17 +48,19 @@ namespace GameOfLife::Game {
      * @param isDynamic Enable dynamic resizing
      */
     Grid::Grid(const std::vector<std::vector<bool>> &cells, const int rows, const int cols, const int maxRows, const int maxCols, const bool isDynamic) :
-    rows(rows), cols(cols), maxRows(maxRows), maxCols(maxCols), isDynamic(isDynamic) {
-        this->cells = cells;
-        next = cells;
+    rows(rows), cols(cols), maxRows(maxRows), maxCols(maxCols), storageRows(rows + 2), storageCols(cols + 2), isDynamic(isDynamic) {
+        this->cells.resize(storageRows, std::vector<bool>(storageCols));
 
         // Populate living cells
         for (int i = 0; i < rows; i++) {
             for (int j = 0; j < cols; j++) {
-                if (cells[i][j])
-                    livingCells.insert(std::make_pair(i, j));
+                if (cells[i][j]) {
+                    this->cells[top + i][left + j] = true;
+                    addLiving(top + i, left + j);
+                }
             }
         }
+        next = this->cells;
 
         changedCells = livingCells;
     }
@@ -54,12 +72,27 @@ namespace GameOfLife::Game {
      * @param col Cell column
      * @param alive Alive status
      */
-    void Grid::setAlive(int row, int col, const bool alive) {
+    void Grid::setAlive(const int row, const int col, const bool alive) {
+        setCell(row + top, col + left, alive);
+    }
+
+    /**
+     * Sets the cell at the specified position of the buffer to be alive or dead.
+     *
+     * @param row Buffer row
+     * @param col Buffer column
+     * @param alive Alive status
+     */
+    void Grid::setCell(const int row, const int col, const bool alive) {
+        if (frontierValid && cells[row][col] != alive)
+            trackChange(row, col, alive, frontierWrap);
+
         cells[row][col] = alive;
+        next[row][col] = alive;
         if (alive)
-            livingCells.insert(std::make_pair(row, col));
+            addLiving(row, col);
         else
-            livingCells.erase(std::make_pair(row, col));
+            removeLiving(row, col);
     }
 
     /**
@@ -71,14 +104,54 @@ namespace GameOfLife::Game {
      */
     void Grid::setAliveNext(int row, int col, const bool alive) {
         next[row][col] = alive;
+
+        // Only the cells that change state need to update the sets
+        if (alive == cells[row][col])
+            return;
         if (alive)
-            livingCells.emplace(row, col);
+            addLiving(row, col);
         else
-            livingCells.erase(std::make_pair(row, col));
+            removeLiving(row, col);
 
         changedCells.emplace(row, col);
     }
 
+    /**
+     * Adds a cell of the buffer to the living cells, counting it on the edges it lies on.
+     *
+     * @param row Buffer row
+     * @param col Buffer column
+     */
+    void Grid::addLiving(const int row, const int col) {
+        if (livingCells.emplace(row, col))
+            countEdges(row, col, 1);
+    }
+
+    /**
+     * Removes a cell of the buffer from the living cells, uncounting it from the edges it lies on.
+     *
+     * @param row Buffer row
+     * @param col Buffer column
+     */
+    void Grid::removeLiving(const int row, const int col) {
+        if (livingCells.erase(std::make_pair(row, col)))
+            countEdges(row, col, -1);
+    }
+
+    /**
+     * Updates the edge counters for a cell of the buffer that was born or died.
+     *
+     * @param row Buffer row
+     * @param col Buffer column
+     * @param delta 1 for a birth, -1 for a death
+     */
+    void Grid::countEdges(const int row, const int col, const int delta) {
+        northCount += row == top ? delta : 0;
+        southCount += row == top + rows - 1 ? delta : 0;
+        westCount += col == left ? delta : 0;
+        eastCount += col == left + cols - 1 ? delta : 0;
+    }
+
     /**
      * Checks if the cell at the specified row and column is alive.
      *
@@ -87,7 +160,7 @@ namespace GameOfLife::Game {
      * @return True if the cell is alive, false otherwise
      */
     bool Grid::isAlive(const int row, const int col) const {
-        return cells[row][col];
+        return cells[row + top][col + left];
     }
 
     /**
@@ -101,16 +174,16 @@ namespace GameOfLife::Game {
     int Grid::countNeighbors(const int row, const int col, const bool wrap) const {
         int count = 0;
 
-        for (int i = row - 1; i <= row + 1; i++) {
-            for (int j = col - 1; j <= col + 1; j++) {
-                if (i == row && j == col) {
+        // The halo is only filled during a step, so the seams are crossed cell by cell
+        for (int i = row + top - 1; i <= row + top + 1; i++) {
+            for (int j = col + left - 1; j <= col + left + 1; j++) {
+                if (i == row + top && j == col + left) {
                     continue;
                 }
 
-                const int wrappedRow = wrap ? (i + rows) % rows : i;
-                const int wrappedCol = wrap ? (j + cols) % cols : j;
-
-                if (wrappedRow >= 0 && wrappedRow < rows && wrappedCol >= 0 && wrappedCol < cols) {
+                int wrappedRow = i;
+                int wrappedCol = j;
+                if (resolve(wrappedRow, wrappedCol, wrap)) {
                     count += cells[wrappedRow][wrappedCol];
                 }
             }
@@ -119,36 +192,186 @@ namespace GameOfLife::Game {
         return count;
     }
 
+    /**
+     * Brings a position of the buffer next to the grid back into the grid, across the seams of the topology.
+     * Crossing the seam between the first and last rows mirrors the column on a Klein bottle and a cross-surface,
+     * crossing the seam between the first and last columns mirrors the row on a cross-surface.
+     *
+     * @param row Buffer row, at most one row away from the grid
+     * @param col Buffer column, at most one column away from the grid
+     * @param wrap If true, the grid will wrap around the edges.
+     * @return True if the position is in the grid or was brought back into it, false if it is past an edge
+     */
+    bool Grid::resolve(int &row, int &col, const bool wrap) const {
+        if (isInside(row, col))
+            return true;
+        if (!wrap || topology == Topology::PLANE)
+            return false;
+
+        if (row < top || row >= top + rows) {
+            row += row < top ? rows : -rows;
+            if (topology != Topology::TORUS)
+                col = 2 * left + cols - 1 - col;
+        }
+        if (col < left || col >= left + cols) {
+            col += col < left ? cols : -cols;
+            if (topology == Topology::CROSS_SURFACE)
+                row = 2 * top + rows - 1 - row;
+        }
+        return true;
+    }
+
+    /**
+     * Fills the halo around the grid with the cells across the seams, for a wrapping step.
+     */
+    void Grid::fillHalo() {
+        const auto fill = [this](const int row, const int col) {
+            int wrappedRow = row;
+            int wrappedCol = col;
+            resolve(wrappedRow, wrappedCol, true);
+            cells[row][col] = cells[wrappedRow][wrappedCol];
+        };
+        for (int j = left - 1; j <= left + cols; j++) {
+            fill(top - 1, j);
+            fill(top + rows, j);
+        }
+        for (int i = top; i < top + rows; i++) {
+            fill(i, left - 1);
+            fill(i, left + cols);
+        }
+    }
+
+    /**
+     * Clears the halo around the grid in both buffers after a wrapping step, the cells past the edges being dead
+     * between steps.
+     */
+    void Grid::clearHalo() {
+        for (auto *buffer : {&cells, &next}) {
+            std::fill_n((*buffer)[top - 1].begin() + (left - 1), cols + 2, false);
+            std::fill_n((*buffer)[top + rows].begin() + (left - 1), cols + 2, false);
+            for (int i = top; i < top + rows; i++) {
+                (*buffer)[i][left - 1] = false;
+                (*buffer)[i][left + cols] = false;
+            }
+        }
+    }
+
+    /**
+     * Counts the number of living neighbors around the cell at the specified position of the buffer.
+     * The cells past the edges are read from the halo, so there is neither a bound check nor a modulo.
+     *
+     * @param row Buffer row
+     * @param col Buffer column
+     * @return Number of living neighbors
+     */
+    int Grid::neighbors(const int row, const int col) const {
+        const std::vector<bool> &above = cells[row - 1];
+        const std::vector<bool> &current = cells[row];
+        const std::vector<bool> &below = cells[row + 1];
+        return above[col - 1] + above[col] + above[col + 1] + current[col - 1] + current[col + 1] +
+            below[col - 1] + below[col] + below[col + 1];
+    }
+
+    /**
+     * Gets the 9-bit neighbourhood index of a cell, bit r * 3 + c set if the cell at row r and column c of its
+     * 3x3 block is alive (the cell itself is bit 4). The cells past the edges are read from the halo.
+     *
+     * @param row Buffer row
+     * @param col Buffer column
+     * @return Neighbourhood index
+     */
+    int Grid::neighborhoodIndex(const int row, const int col) const {
+        const std::vector<bool> &above = cells[row - 1];
+        const std::vector<bool> &current = cells[row];
+        const std::vector<bool> &below = cells[row + 1];
+        return above[col - 1] | above[col] << 1 | above[col + 1] << 2 |
+            current[col - 1] << 3 | current[col] << 4 | current[col + 1] << 5 |
+            below[col - 1] << 6 | below[col] << 7 | below[col + 1] << 8;
+    }
+
+    /**
+     * Gets the next state of a cell, from its neighbor count or from its whole neighbourhood for isotropic rules.
+     *
+     * @tparam TRule Rule policy
+     * @param policy Rule
+     * @param row Buffer row
+     * @param col Buffer column
+     * @return Next state of the cell
+     */
+    template<typename TRule>
+    bool Grid::nextState(const TRule &policy, const int row, const int col) const {
+        if constexpr (std::is_same_v<TRule, IsotropicRule>)
+            return policy.next(neighborhoodIndex(row, col));
+        else
+            return policy.next(cells[row][col], neighbors(row, col));
+    }
+
     /**
      * Steps the grid to the next generation.
      *
      * @param wrap If true, the grid will wrap around the edges. This will disable dynamic resizing.
      * @param dynamic If true, the grid will resize if a living cell is on the edge (overrides isDynamic property).
      */
-    void Grid::step(const bool wrap, const bool dynamic) {
+    void Grid::step(bool wrap, const bool dynamic) {
         // Clear the changed cells
         changedCells.clear();
+        bytesCopied = 0;
+        wrap = wrap && topology != Topology::PLANE;
 
-        // Check if the grid should be resized
-        if (isDynamic && !wrap && dynamic) {
-            // Check if a living cell is on the edge
-            bool onEdgeNorth = false, onEdgeEast = false, onEdgeSouth = false, onEdgeWest = false;
-            for (auto &cell : livingCells) {
-                if (cell.first == 0) {
-                    onEdgeNorth = true;
-                } else if (cell.first == rows - 1) {
-                    onEdgeSouth = true;
-                } else if (cell.second == 0) {
-                    onEdgeWest = true;
-                } else if (cell.second == cols - 1) {
-                    onEdgeEast = true;
-                }
-            }
-            resize(onEdgeNorth ? 1 : 0, onEdgeEast ? 1 : 0, onEdgeSouth ? 1 : 0, onEdgeWest ? 1 : 0);
+        // Grow towards the edges with a living cell, the counters telling which ones without a scan
+        if (isDynamic && !wrap && dynamic)
+            resize(northCount > 0 ? 1 : 0, eastCount > 0 ? 1 : 0, southCount > 0 ? 1 : 0, westCount > 0 ? 1 : 0);
+
+        // The seams are crossed once per generation, by filling the halo that the steps read
+        if (wrap)
+            fillHalo();
+
+        // Each preset rule has its own instantiation of the step, picked once per generation
+        // Other outer-totalistic rules go through the count table, isotropic rules through the neighbourhood table
+        if (preset)
+            (this->*stepFunctions[static_cast<int>(*preset)])(wrap);
+        else if (rule.isTotalistic())
+            ruleStep(wrap, *rule.getTotalistic());
+        else
+            ruleStep(wrap, rule);
+
+        if (wrap)
+            clearHalo();
+    }
+
+    /**
+     * Steps the grid to the next generation under a preset rule.
+     *
+     * @tparam TRule Rule policy
+     * @param wrap If true, the grid will wrap around the edges.
+     */
+    template<typename TRule>
+    void Grid::presetStep(const bool wrap) {
+        ruleStep(wrap, TRule{});
+    }
+
+    /**
+     * Steps the grid to the next generation under a rule.
+     *
+     * @tparam TRule Rule policy, a LifeLike instantiation, a LifeLikeRule or an IsotropicRule
+     * @param wrap If true, the grid will wrap around the edges.
+     * @param policy Rule
+     */
+    template<typename TRule>
+    void Grid::ruleStep(const bool wrap, const TRule &policy) {
+        if (stepMode != StepMode::REGULAR) {
+            frontierStep(wrap, policy);
+            return;
+        }
+
+        // Dense grids are faster to step as a whole with the packed kernel, whose rows only wrap without a twist
+        if (livingCells.size() * denseRatio >= static_cast<size_t>(rows) * cols && (!wrap || topology != Topology::CROSS_SURFACE)) {
+            denseStep(wrap);
+            return;
         }
 
         if (livingCells.size() > multiThreadedThreshold) {
-            multiThreadedStep(wrap);
+            multiThreadedStep(wrap, policy);
             return;
         }
 
@@ -158,54 +381,36 @@ namespace GameOfLife::Game {
             { 1, -1 }, { 1, 0 }, { 1, 1 }
         };
 
-        auto cellsToCheck = std::unordered_set<std::pair<int, int>, HashFunction>();
+        auto cellsToCheck = CoordinateSet();
 
-        for (auto &cell : livingCells) {
+        for (const auto &cell : livingCells) {
             const int row = cell.first;
             const int col = cell.second;
 
             for (auto &direction : directions) {
-                const int newRow = row + direction.first;
-                const int newCol = col + direction.second;
+                int newRow = row + direction.first;
+                int newCol = col + direction.second;
 
-                int wrappedRow = wrap ? (newRow + rows) % rows : newRow;
-                int wrappedCol = wrap ? (newCol + cols) % cols : newCol;
-
-                if (wrappedRow >= 0 && wrappedRow < rows && wrappedCol >= 0 && wrappedCol < cols) {
-                    cellsToCheck.insert(std::make_pair(wrappedRow, wrappedCol));
+                if (resolve(newRow, newCol, wrap)) {
+                    cellsToCheck.insert(std::make_pair(newRow, newCol));
                 }
             }
         }
 
         // Check each cell
-        for (auto &cell : cellsToCheck) {
+        for (const auto &cell : cellsToCheck) {
             const int row = cell.first;
             const int col = cell.second;
 
-            const int neighbors = countNeighbors(row, col, wrap);
-
-            if (cells[row][col]) {
-                if (neighbors < 2 || neighbors > 3) {
-                    setAliveNext(row, col, false);
-                } else {
-                    setAliveNext(row, col, true);
-                }
-            } else {
-                if (neighbors == 3) {
-                    setAliveNext(row, col, true);
-                } else {
-                    setAliveNext(row, col, false);
-                }
-            }
+            setAliveNext(row, col, nextState(policy, row, col));
         }
 
-        // Move the next generation to the current generation
-        cells = next;
-
-        // Clear the next generation
-        for (auto &cell : livingCells) {
-            next[cell.first][cell.second] = false;
+        // Flip the buffers, the back buffer only differs from the new generation at the changed cells
+        std::swap(cells, next);
+        for (const auto &[row, col] : changedCells) {
+            next[row][col] = cells[row][col];
         }
+        bytesCopied += changedCells.size() * sizeof(bool);
     }
 
     /**
@@ -224,111 +429,285 @@ namespace GameOfLife::Game {
         step(wrap, false);
     }
 
+    /**
+     * Steps the whole grid to the next generation with the packed (SIMD) kernel.
+     * Each worker of the thread pool gets a contiguous band of rows: it reads its rows and one halo row above and below,
+     * and only writes its own rows, so no lock is needed. The changes are merged into the sets once at the end.
+     * The halo rows of the buffer are packed around the grid, so the first and last rows need no special case.
+     *
+     * @param wrap If true, the grid will wrap around the edges.
+     */
+    void Grid::denseStep(const bool wrap) {
+        if (!pool)
+            pool = std::make_shared<ThreadPool>();
+
+        // Rows start on a cache line (8 words), so neighboring bands never share one
+        const int words = (cols + 63) / 64;
+        const size_t stride = (words + 7) & ~7;
+        packed.assign(static_cast<size_t>(rows + 2) * stride + 8, 0);
+        packedNext.resize(packed.size());
+        auto align = [](uint64_t *data) {
+            return reinterpret_cast<uint64_t *>((reinterpret_cast<uintptr_t>(data) + 63) & ~static_cast<uintptr_t>(63));
+        };
+        uint64_t *current = align(packed.data());
+        uint64_t *stepped = align(packedNext.data());
+
+        const int workers = pool->getWorkerCount();
+        const size_t band = (rows + workers - 1) / workers;
+
+        // Pack the current generation, packed row i + 1 being row i of the grid
+        pool->parallelFor(rows + 2, band, [&](const size_t begin, const size_t end, int) {
+            for (size_t i = begin; i < end; i++) {
+                uint64_t *row = current + i * stride;
+                const std::vector<bool> &source = cells[top - 1 + i];
+                for (int j = 0; j < cols; j++) {
+                    row[j / 64] |= static_cast<uint64_t>(source[left + j]) << (j % 64);
+                }
+            }
+        });
+
+        // Step each band and write back the cells that changed
+        std::vector<std::vector<std::pair<int, int>>> buffers(workers);
+        pool->parallelFor(rows, band, [&](const size_t begin, const size_t end, const int worker) {
+            auto &changes = buffers[worker];
+            for (size_t i = begin; i < end; i++) {
+                const size_t offset = (i + 1) * stride;
+                StepKernel::stepRow(current + i * stride, current + offset, current + offset + stride, stepped + offset,
+                    words, cols, wrap, rule);
+
+                for (int w = 0; w < words; w++) {
+                    const uint64_t now = stepped[offset + w];
+                    for (uint64_t diff = current[offset + w] ^ now; diff != 0; diff &= diff - 1) {
+                        const int bit = std::countr_zero(diff);
+                        const int row = top + static_cast<int>(i);
+                        const int col = left + w * 64 + bit;
+                        cells[row][col] = now >> bit & 1;
+                        next[row][col] = now >> bit & 1;
+                        changes.emplace_back(row, col);
+                    }
+                }
+            }
+        });
+
+        // Merge the changes
+        for (const auto &changes : buffers) {
+            for (const auto &[row, col] : changes) {
+                if (cells[row][col])
+                    addLiving(row, col);
+                else
+                    removeLiving(row, col);
+                changedCells.emplace(row, col);
+            }
+        }
+        bytesCopied += changedCells.size() * sizeof(bool);
+    }
+
     /**
      * Steps the grid to the next generation using multiple threads.
+     * The living cells are split in chunks run by the engine's thread pool, and the changes are applied once at the end.
      *
+     * @tparam TRule Rule policy
      * @param wrap If true, the grid will wrap around the edges. This will disable dynamic resizing.
+     * @param policy Rule
      */
-    void Grid::multiThreadedStep(const bool wrap) {
+    template<typename TRule>
+    void Grid::multiThreadedStep(const bool wrap, const TRule &policy) {
         // Assume that the size check has already been done
+        if (!pool)
+            pool = std::make_shared<ThreadPool>();
 
         // Directions to check
         const std::pair<int, int> directions[] = {
             { -1, -1 }, { -1, 0 }, { -1, 1 },
-            { 0, -1 }, {0, 0}, { 0, 1 },
+            { 0, -1 }, { 0, 0 }, { 0, 1 },
             { 1, -1 }, { 1, 0 }, { 1, 1 }
         };
 
-        auto cellsToCheck = std::unordered_set<std::pair<int, int>, HashFunction>();
-        std::mutex cellsToCheckMutex;
-        std::mutex nextMutex;
+        // Random access copy of the living cells, so the workers can take chunks of it
+        const std::vector<std::pair<int, int>> living(livingCells.begin(), livingCells.end());
 
-        // Function to process a chunk of living cells
-        auto checkCells = [&](const int start, const int end) {
-            for (int idx = start; idx < end; ++idx) {
-                auto cell = *std::next(livingCells.begin(), idx);
-                const int row = cell.first;
-                const int col = cell.second;
+        // Each worker collects the cells that change state in its own buffer
+        std::vector<std::vector<std::pair<int, int>>> buffers(pool->getWorkerCount());
 
-                for (auto &direction : directions) {
-                    const int newRow = row + direction.first;
-                    const int newCol = col + direction.second;
+        pool->parallelFor(living.size(), 4096, [&](const size_t begin, const size_t end, const int worker) {
+            auto &changes = buffers[worker];
+            for (size_t idx = begin; idx < end; ++idx) {
+                const auto cell = living[idx];
 
-                    int wrappedRow = wrap ? (newRow + rows) % rows : newRow;
-                    int wrappedCol = wrap ? (newCol + cols) % cols : newCol;
+                for (auto &direction : directions) {
+                    int targetRow = cell.first + direction.first;
+                    int targetCol = cell.second + direction.second;
+                    if (!resolve(targetRow, targetCol, wrap))
+                        continue;
 
-                    if (wrappedRow >= 0 && wrappedRow < rows && wrappedCol >= 0 && wrappedCol < cols) {
-                        std::lock_guard lock(cellsToCheckMutex);
-                        cellsToCheck.insert(std::make_pair(wrappedRow, wrappedCol));
+                    // A cell is only checked by the smallest living cell around it, so by exactly one worker
+                    int neighbors = 0;
+                    int index = 0;
+                    bool owner = true;
+                    for (auto &around : directions) {
+                        int row = targetRow + around.first;
+                        int col = targetCol + around.second;
+                        if (!resolve(row, col, wrap) || !cells[row][col])
+                            continue;
+                        owner &= std::make_pair(row, col) >= cell;
+                        neighbors += around.first != 0 || around.second != 0;
+                        index |= 1 << ((around.first + 1) * 3 + around.second + 1);
                     }
+                    if (!owner)
+                        continue;
+
+                    bool next;
+                    if constexpr (std::is_same_v<TRule, IsotropicRule>)
+                        next = policy.next(index);
+                    else
+                        next = policy.next(cells[targetRow][targetCol], neighbors);
+                    if (next != static_cast<bool>(cells[targetRow][targetCol]))
+                        changes.emplace_back(targetRow, targetCol);
                 }
             }
-        };
+        });
 
-        int numThreads = std::thread::hardware_concurrency();
-        int cellsPerThread = livingCells.size() / numThreads;
-        std::vector<std::thread> threads;
-
-        for (int i = 0; i < numThreads; ++i) {
-            int start = i * cellsPerThread;
-            int end = (i == numThreads - 1) ? livingCells.size() : start + cellsPerThread;
-            threads.emplace_back(checkCells, start, end);
+        // Merge the buffers once, a cell reached twice on a tiny wrapped grid only flips once
+        // The cells are flipped in place, so the back buffer is kept in sync cell by cell
+        for (const auto &changes : buffers) {
+            for (const auto &[row, col] : changes) {
+                if (changedCells.emplace(row, col)) {
+                    cells[row][col] = !cells[row][col];
+                    next[row][col] = cells[row][col];
+                    if (cells[row][col])
+                        addLiving(row, col);
+                    else
+                        removeLiving(row, col);
+                }
+            }
         }
+        bytesCopied += changedCells.size() * sizeof(bool);
+    }
 
-        for (auto &thread : threads) {
-            thread.join();
-        }
+    /**
+     * Steps the grid to the next generation by only evaluating the frontier.
+     * A cell that did not change and whose neighbors did not change cannot change either,
+     * so the cells to evaluate are exactly the neighborhoods of the previous changes.
+     * In incremental mode, each cell reads its stored count instead of looking at its eight neighbors.
+     *
+     * @tparam TRule Rule policy
+     * @param wrap If true, the grid will wrap around the edges.
+     * @param policy Rule
+     */
+    template<typename TRule>
+    void Grid::frontierStep(const bool wrap, const TRule &policy) {
+        if (!frontierValid || frontierWrap != wrap)
+            rebuildFrontier(wrap);
 
-        // Check each cell
-        // Function to update a chunk of cells
-        auto updateCells = [&](const int start, const int end) {
-            for (int idx = start; idx < end; ++idx) {
-                auto cell = *std::next(cellsToCheck.begin(), idx);
-                const int row = cell.first;
-                const int col = cell.second;
-
-                const int neighbors = countNeighbors(row, col, wrap);
-
-                std::lock_guard nextLock(nextMutex);
-
-                if (cells[row][col]) {
-                    if (neighbors < 2 || neighbors > 3) {
-                        setAliveNext(row, col, false);
-                    } else {
-                        setAliveNext(row, col, true);
-                    }
-                } else {
-                    if (neighbors == 3) {
-                        setAliveNext(row, col, true);
-                    } else {
-                        setAliveNext(row, col, false);
-                    }
-                }
-            }
-        };
+        // Evaluate the whole frontier before anything moves
+        const bool incremental = stepMode == StepMode::INCREMENTAL;
+        std::vector<std::pair<int, int>> changes;
+        for (const auto &[row, col] : frontier) {
+            const size_t index = static_cast<size_t>(row) * storageCols + col;
+            frontierBits[index / 64] = 0;
 
-        cellsPerThread = cellsToCheck.size() / numThreads;
-        threads.clear();
+            // The stored counts are of no use to isotropic rules, which need the whole neighbourhood
+            const bool alive = cells[row][col];
+            bool next;
+            if constexpr (std::is_same_v<TRule, IsotropicRule>)
+                next = nextState(policy, row, col);
+            else
+                next = incremental ? policy.next(alive, neighborCounts[index / 2] >> (index & 1) * 4 & 0xF) :
+                    nextState(policy, row, col);
+            if (next != alive)
+                changes.emplace_back(row, col);
+        }
 
-        for (int i = 0; i < numThreads; ++i) {
-            int start = i * cellsPerThread;
-            int end = (i == numThreads - 1) ? cellsToCheck.size() : start + cellsPerThread;
-            threads.emplace_back(updateCells, start, end);
+        // Apply the changes, the cells around them form the next frontier
+        frontier.clear();
+        for (const auto &[row, col] : changes) {
+            const bool alive = !cells[row][col];
+            trackChange(row, col, alive, wrap);
+            cells[row][col] = alive;
+            next[row][col] = alive;
+            if (alive)
+                addLiving(row, col);
+            else
+                removeLiving(row, col);
+            changedCells.emplace(row, col);
         }
+        bytesCopied += changedCells.size() * sizeof(bool);
+    }
+
+    /**
+     * Rebuilds the frontier, and the neighbor counts in incremental mode, from the living cells.
+     * The frontier becomes every cell around a living cell, as in a regular step.
+     *
+     * @param wrap If true, the grid will wrap around the edges.
+     */
+    void Grid::rebuildFrontier(const bool wrap) {
+        frontierBits.assign((static_cast<size_t>(storageRows) * storageCols + 63) / 64, 0);
+        frontier.clear();
+        if (stepMode == StepMode::INCREMENTAL)
+            neighborCounts.assign((static_cast<size_t>(storageRows) * storageCols + 1) / 2, 0);
 
-        for (auto &thread : threads) {
-            thread.join();
+        frontierValid = true;
+        frontierWrap = wrap;
+        for (const auto &[row, col] : livingCells) {
+            trackChange(row, col, true, wrap);
         }
+    }
+
+    /**
+     * Records a birth or a death: its neighborhood joins the frontier, and in incremental mode,
+     * the counts of its neighbors go up or down by one.
+     *
+     * @param row Buffer row
+     * @param col Buffer column
+     * @param alive True for a birth, false for a death
+     * @param wrap If true, the grid will wrap around the edges.
+     */
+    void Grid::trackChange(const int row, const int col, const bool alive, const bool wrap) {
+        const bool incremental = stepMode == StepMode::INCREMENTAL;
+        for (int i = row - 1; i <= row + 1; i++) {
+            for (int j = col - 1; j <= col + 1; j++) {
+                int wrappedRow = i;
+                int wrappedCol = j;
+                if (!resolve(wrappedRow, wrappedCol, wrap))
+                    continue;
 
-        // Move the next generation to the current generation
-        cells = next;
+                // The bitmap keeps each cell once in the frontier
+                const size_t index = static_cast<size_t>(wrappedRow) * storageCols + wrappedCol;
+                const uint64_t bit = uint64_t{1} << (index % 64);
+                if (!(frontierBits[index / 64] & bit)) {
+                    frontierBits[index / 64] |= bit;
+                    frontier.emplace_back(wrappedRow, wrappedCol);
+                }
 
-        // Clear the next generation
-        for (auto &cell : livingCells) {
-            next[cell.first][cell.second] = false;
+                // A count never goes above 8, so a nibble never carries into its neighbor
+                if (incremental && (i != row || j != col)) {
+                    const auto delta = static_cast<uint8_t>(1 << (index & 1) * 4);
+                    if (alive)
+                        neighborCounts[index / 2] += delta;
+                    else
+                        neighborCounts[index / 2] -= delta;
+                }
+            }
         }
     }
 
+    /**
+     * Sets how the grid finds the cells to evaluate on each step.
+     * The frontier and the counts are built on the next step.
+     *
+     * @param stepMode Step mode
+     */
+    void Grid::setStepMode(const StepMode stepMode) {
+        this->stepMode = stepMode;
+        frontierValid = false;
+        frontierBits.clear();
+        frontierBits.shrink_to_fit();
+        frontier.clear();
+        frontier.shrink_to_fit();
+        neighborCounts.clear();
+        neighborCounts.shrink_to_fit();
+    }
+
     /**
      * Moves a block of cells from one position to another.
      *
@@ -340,11 +719,31 @@ namespace GameOfLife::Game {
      * @param toCol The column to move the block to
      */
     void Grid::move(const int fromRow, const int fromCol, const int numRows, const int numCols, const int toRow, const int toCol) {
-        BaseGrid::move(cells, livingCells, changedCells, fromRow, fromCol, numRows, numCols, toRow, toCol);
+        // Extract the block, then clear it before writing it at its new position, the two may overlap
+        std::vector block(numRows, std::vector<bool>(numCols));
+        for (int i = 0; i < numRows; i++) {
+            for (int j = 0; j < numCols; j++) {
+                block[i][j] = cells[top + fromRow + i][left + fromCol + j];
+            }
+        }
+        for (int i = 0; i < numRows; i++) {
+            for (int j = 0; j < numCols; j++) {
+                setCell(top + fromRow + i, left + fromCol + j, false);
+                changedCells.emplace(top + fromRow + i, left + fromCol + j);
+            }
+        }
+        for (int i = 0; i < numRows; i++) {
+            for (int j = 0; j < numCols; j++) {
+                setCell(top + toRow + i, left + toCol + j, block[i][j]);
+                changedCells.emplace(top + toRow + i, left + toCol + j);
+            }
+        }
     }
 
     /**
      * Resizes the grid by adding rows and columns to the north, east, south, and west.
+     * The grid grows into the padding of the buffer without moving any cell, the buffer is only reallocated once the
+     * padding on a side is used up.
      *
      * @param addNorth Number of rows to add to the north
      * @param addEast Number of columns to add to the east
@@ -352,7 +751,128 @@ namespace GameOfLife::Game {
      * @param addWest Number of columns to add to the west
      */
     void Grid::resize(const int addNorth, const int addEast, const int addSouth, const int addWest) {
-        BaseGrid::resize(cells, next, livingCells, addNorth, addEast, addSouth, addWest, rows, cols, maxRows, maxCols);
+        // Argument check
+        if (addNorth < 0 || addEast < 0 || addSouth < 0 || addWest < 0) {
+            throw std::invalid_argument("The number of rows and columns to add must be positive.");
+        }
+
+        // Check against the maximum size
+        if (static_cast<int64_t>(rows) + addNorth + addSouth > maxRows || static_cast<int64_t>(cols) + addEast + addWest > maxCols)
+            return;
+        if (addNorth + addEast + addSouth + addWest == 0)
+            return;
+
+        // The halo ring stays in the buffer
+        if (top - addNorth < 1 || left - addWest < 1 || top + rows + addSouth >= storageRows || left + cols + addEast >= storageCols)
+            reallocate(addNorth, addEast, addSouth, addWest);
+
+        const int oldTop = top;
+        const int oldLeft = left;
+        const int oldRows = rows;
+        const int oldCols = cols;
+        top -= addNorth;
+        left -= addWest;
+        rows += addNorth + addSouth;
+        cols += addEast + addWest;
+        originRow -= addNorth;
+        originCol -= addWest;
+
+        // The new edges are empty, the other edges only gained dead cells
+        if (addNorth > 0)
+            northCount = 0;
+        if (addEast > 0)
+            eastCount = 0;
+        if (addSouth > 0)
+            southCount = 0;
+        if (addWest > 0)
+            westCount = 0;
+
+        // Wrapping now joins other edges, so the frontier is rebuilt
+        if (!frontierValid || frontierWrap) {
+            frontierValid = false;
+            return;
+        }
+
+        // Otherwise the new cells were only left out of the frontier and the counts, and only the living cells of the
+        // old edges reach them; each old edge cell is visited once, corners included
+        const int oldBottom = oldTop + oldRows - 1;
+        const int oldRight = oldLeft + oldCols - 1;
+        const bool incremental = stepMode == StepMode::INCREMENTAL;
+        const auto reach = [&](const int row, const int col) {
+            if (!cells[row][col])
+                return;
+            for (int i = row - 1; i <= row + 1; i++) {
+                for (int j = col - 1; j <= col + 1; j++) {
+                    if (!isInside(i, j) || (i >= oldTop && i <= oldBottom && j >= oldLeft && j <= oldRight))
+                        continue;
+                    const size_t index = static_cast<size_t>(i) * storageCols + j;
+                    const uint64_t bit = uint64_t{1} << (index % 64);
+                    if (!(frontierBits[index / 64] & bit)) {
+                        frontierBits[index / 64] |= bit;
+                        frontier.emplace_back(i, j);
+                    }
+                    if (incremental)
+                        neighborCounts[index / 2] += static_cast<uint8_t>(1 << (index & 1) * 4);
+                }
+            }
+        };
+        for (int j = oldLeft; j <= oldRight; j++) {
+            if (addNorth > 0)
+                reach(oldTop, j);
+            if (addSouth > 0 && (addNorth == 0 || oldBottom != oldTop))
+                reach(oldBottom, j);
+        }
+        for (int i = oldTop; i <= oldBottom; i++) {
+            if ((addNorth > 0 && i == oldTop) || (addSouth > 0 && i == oldBottom))
+                continue;
+            if (addWest > 0)
+                reach(i, oldLeft);
+            if (addEast > 0 && (addWest == 0 || oldRight != oldLeft))
+                reach(i, oldRight);
+        }
+    }
+
+    /**
+     * Reallocates the buffer for a grid growing past its padding. The new buffer has padding proportional to the grid
+     * on every side, so the number of reallocations is logarithmic in the growth. The cells around the grid being dead,
+     * only the living cells are copied.
+     *
+     * @param addNorth Number of rows about to be added to the north
+     * @param addEast Number of columns about to be added to the east
+     * @param addSouth Number of rows about to be added to the south
+     * @param addWest Number of columns about to be added to the west
+     */
+    void Grid::reallocate(const int addNorth, const int addEast, const int addSouth, const int addWest) {
+        const int newRows = rows + addNorth + addSouth;
+        const int newCols = cols + addEast + addWest;
+        const int padRows = std::max(64, newRows / 2);
+        const int padCols = std::max(64, newCols / 2);
+        const int newTop = padRows + addNorth;
+        const int newLeft = padCols + addWest;
+        storageRows = newRows + 2 * padRows;
+        storageCols = newCols + 2 * padCols;
+        cells.assign(storageRows, std::vector<bool>(storageCols));
+        next = cells;
+
+        // The edge counters are relative to the grid, so they do not change
+        CoordinateSet living(livingCells.size());
+        for (const auto &[row, col] : livingCells) {
+            cells[row - top + newTop][col - left + newLeft] = true;
+            next[row - top + newTop][col - left + newLeft] = true;
+            living.emplace(row - top + newTop, col - left + newLeft);
+        }
+        CoordinateSet changed(changedCells.size());
+        for (const auto &[row, col] : changedCells) {
+            changed.emplace(row - top + newTop, col - left + newLeft);
+        }
+        livingCells = std::move(living);
+        changedCells = std::move(changed);
+        bytesCopied += 2 * livingCells.size() * sizeof(bool);
+        top = newTop;
+        left = newLeft;
+
+        // The frontier is indexed by position in the buffer
+        frontierValid = false;
     }
 
     /**
@@ -364,7 +884,25 @@ namespace GameOfLife::Game {
      * @param hollow If true, only the living cells will be inserted
      */
     void Grid::insert(const std::vector<std::vector<bool>> &cells, const int row, const int col, const bool hollow) {
-        BaseGrid::insert(this->cells, livingCells, changedCells, cells, row, col, rows, cols, maxRows, maxCols, hollow);
+        // Argument check
+        if (row < 0 || row >= rows || col < 0 || col >= cols) {
+            throw std::invalid_argument("The row and column must be within the grid.");
+        }
+
+        // Check against the maximum size
+        if (row + static_cast<int>(cells.size()) > maxRows || col + static_cast<int>(cells[0].size()) > maxCols) {
+            return;
+        }
+
+        // Insert the cells, the part of the pattern past the edges is left out
+        for (int i = 0; i < static_cast<int>(cells.size()) && row + i < rows; ++i) {
+            for (int j = 0; j < static_cast<int>(cells[i].size()) && col + j < cols; ++j) {
+                if (!hollow || cells[i][j]) {
+                    setCell(top + row + i, left + col + j, cells[i][j]);
+                    changedCells.emplace(top + row + i, left + col + j);
+                }
+            }
+        }
     }
 
     /**
@@ -373,13 +911,44 @@ namespace GameOfLife::Game {
      * @param aliveProbability Probability of a cell being alive
      */
     void Grid::randomize(const float aliveProbability) {
+        randomize(aliveProbability, static_cast<uint64_t>(rand()));
+    }
+
+    /**
+     * Randomizes the grid with the specified probability of a cell being alive.
+     * The rows are drawn 64 cells at a time, in parallel on large grids, and give the same cells as the other engines
+     * for the same seed.
+     *
+     * @param aliveProbability Probability of a cell being alive
+     * @param seed Seed
+     */
+    void Grid::randomize(const float aliveProbability, const uint64_t seed) {
         if (aliveProbability < 0 || aliveProbability > 1)
             return;
+        const uint32_t threshold = Random::threshold(aliveProbability);
+        const int words = (cols + 63) / 64;
+        std::vector<uint64_t> drawn(static_cast<size_t>(rows) * words);
+        const auto draw = [&](const size_t begin, const size_t end, int) {
+            for (size_t i = begin; i < end; i++) {
+                Random::bernoulliRow(&drawn[i * words], cols, threshold, seed, 0, static_cast<uint32_t>(i),
+                    Random::Stream::RANDOMIZE);
+            }
+        };
+        if (static_cast<size_t>(rows) * cols > static_cast<size_t>(multiThreadedThreshold)) {
+            if (!pool)
+                pool = std::make_shared<ThreadPool>();
+            pool->parallelFor(rows, (rows + pool->getWorkerCount() - 1) / pool->getWorkerCount(), draw);
+        }
+        else
+            draw(0, rows, 0);
+
+        // The living cells are tracked in a set, so the cells are set on this thread
         for (int i = 0; i < rows; i++) {
-            for (int j = 0; j < cols; j++) {
-                if ((rand() % 100) < aliveProbability * 100) {
-                    setAlive(i, j, true);
-                    changedCells.insert(std::make_pair(i, j));
+            for (int w = 0; w < words; w++) {
+                for (uint64_t bits = drawn[static_cast<size_t>(i) * words + w]; bits != 0; bits &= bits - 1) {
+                    const int j = w * 64 + std::countr_zero(bits);
+                    setCell(top + i, left + j, true);
+                    changedCells.emplace(top + i, left + j);
                 }
             }
         }
@@ -389,12 +958,17 @@ namespace GameOfLife::Game {
      * Clears the grid.
      */
     void Grid::clear() {
-        // Clear the living cells
-        for (auto &row : cells) {
-            std::fill(row.begin(), row.end(), false);
+        // Only the living cells need to be cleared, in both buffers
+        for (const auto &[row, col] : livingCells) {
+            cells[row][col] = false;
+            next[row][col] = false;
         }
         livingCells.clear();
-        next = cells;
+        northCount = 0;
+        eastCount = 0;
+        southCount = 0;
+        westCount = 0;
+        frontierValid = false;
     }
 
     /**
@@ -415,12 +989,39 @@ namespace GameOfLife::Game {
     void Grid::print(const int fromRow, const int fromCol, const int toRow, const int toCol) const {
         for (int i = fromRow; i < toRow; i++) {
             for (int j = fromCol; j < toCol; j++) {
-                std::cout << (cells[i][j] ? 'O' : '.') << ' ';
+                std::cout << (cells[top + i][left + j] ? 'O' : '.') << ' ';
             }
             std::cout << std::endl;
         }
     }
 
+    /**
+     * Gets the cells of the grid, without the padding of the buffer.
+     *
+     * @return The cells of the grid
+     */
+    std::vector<std::vector<bool>> Grid::getCells() const {
+        std::vector grid(rows, std::vector<bool>(cols));
+        for (const auto &[row, col] : livingCells) {
+            grid[row - top][col - left] = true;
+        }
+        return grid;
+    }
+
+    /**
+     * Converts a set of buffer coordinates to grid coordinates.
+     *
+     * @param set Set in buffer coordinates
+     * @return Set in grid coordinates
+     */
+    CoordinateSet Grid::toGrid(const CoordinateSet &set) const {
+        CoordinateSet shifted(set.size());
+        for (const auto &[row, col] : set) {
+            shifted.emplace(row - top, col - left);
+        }
+        return shifted;
+    }
+
     /**
      * IWritable implementation.
      * Gets the grid as a string.
@@ -431,7 +1032,7 @@ namespace GameOfLife::Game {
         std::stringstream ss;
         for (int i = 0; i < rows; i++) {
             for (int j = 0; j < cols; j++) {
-                ss << (cells[i][j] ? formatConfig.getAliveChar() : formatConfig.getDeadChar()) << formatConfig.getDelimiterChar();
+                ss << (cells[top + i][left + j] ? formatConfig.getAliveChar() : formatConfig.getDeadChar()) << formatConfig.getDelimiterChar();
             }
             ss << '\n';
         }
@@ -1,35 +1,117 @@
 #ifndef GRID_H
 #define GRID_H
-#include <unordered_set>
+#include <array>
+#include <cstdint>
 #include <vector>
 
 #include "BaseGrid.h"
-#include "HashFunction.h"
+#include "CoordinateSet.h"
+#include "Rules.h"
+#include "ThreadPool.h"
+#include "Topology.h"
 #include "File/FormatConfig.h"
 
 #define DEFAULT_MAX_ROWS 2048
 #define DEFAULT_MAX_COLS 2048
 
 namespace GameOfLife::Game {
+    /**
+     * How the grid finds the cells to evaluate on each step.
+     */
+    enum class StepMode {
+        // Every cell around a living cell, or the whole grid when it is dense
+        REGULAR,
+        // Only the cells around the last changes, each one counting its neighbors
+        FRONTIER,
+        // Only the cells around the last changes, each one reading a stored neighbor count
+        INCREMENTAL
+    };
 
+    /**
+     * Grid of cells stored in a padded buffer: the grid is the window of rows x cols cells starting at (top, left)
+     * in the buffer, so it can grow by a row or a column without moving any cell. Once the padding on a side is used
+     * up, the buffer is reallocated with padding proportional to the grid, so growing is amortized O(1).
+     * The sets and the frontier work in buffer coordinates, the public methods in grid coordinates.
+     * The buffer always keeps a ring of halo cells around the grid. They are dead, except during a wrapping step, when
+     * they hold the cells across the seams of the topology, so the neighbors of every cell are read the same way.
+     */
     class Grid : public BaseGrid<std::vector<std::vector<bool>>, bool> {
     private:
         std::vector<std::vector<bool>> cells;
         std::vector<std::vector<bool>> next;
-        std::unordered_set<std::pair<int, int>, HashFunction> livingCells;
-        std::unordered_set<std::pair<int, int>, HashFunction> changedCells;
+        CoordinateSet livingCells;
+        CoordinateSet changedCells;
         int rows;
         int cols;
         int maxRows;
         int maxCols;
 
+        // Buffer size and position of the grid in the buffer, the cells around the grid being dead between steps
+        int storageRows;
+        int storageCols;
+        int top = 1;
+        int left = 1;
+        Topology topology = Topology::TORUS;
+
+        // Position of the first cell of the grid on the unbounded plane, moving when the grid grows north or west
+        int64_t originRow = 0;
+        int64_t originCol = 0;
+
+        // Living cells on each edge of the grid, so a dynamic step knows where to grow without a scan
+        int northCount = 0;
+        int eastCount = 0;
+        int southCount = 0;
+        int westCount = 0;
+
+        std::vector<uint64_t> packed;
+        std::vector<uint64_t> packedNext;
+
+        std::shared_ptr<ThreadPool> pool;
         int multiThreadedThreshold = 100000;
+        int denseRatio = 64;
+        size_t bytesCopied = 0;
         bool isDynamic;
 
+        IsotropicRule rule;
+        std::optional<Rule> preset = Rule::CONWAY;
+        static const std::array<void (Grid::*)(bool), RULE_COUNT> stepFunctions;
+
+        // Frontier of the next step, deduplicated with one bit per cell
+        StepMode stepMode = StepMode::REGULAR;
+        bool frontierValid = false;
+        bool frontierWrap = false;
+        std::vector<uint64_t> frontierBits;
+        std::vector<std::pair<int, int>> frontier;
+
+        // Incremental mode: 4-bit neighbor count per cell, two cells per byte, updated on each birth and death
+        std::vector<uint8_t> neighborCounts;
+
         File::FormatConfig formatConfig = File::FormatConfig('O', '.', '\0');
 
+        [[nodiscard]] bool isInside(const int row, const int col) const {
+            return row >= top && row < top + rows && col >= left && col < left + cols;
+        }
+
+        void setCell(int row, int col, bool alive);
         void setAliveNext(int row, int col, bool alive);
-        void multiThreadedStep(bool wrap);
+        void addLiving(int row, int col);
+        void removeLiving(int row, int col);
+        void countEdges(int row, int col, int delta);
+        void reallocate(int addNorth, int addEast, int addSouth, int addWest);
+        [[nodiscard]] CoordinateSet toGrid(const CoordinateSet &set) const;
+        bool resolve(int &row, int &col, bool wrap) const;
+        void fillHalo();
+        void clearHalo();
+        [[nodiscard]] int neighbors(int row, int col) const;
+        [[nodiscard]] int neighborhoodIndex(int row, int col) const;
+        template<typename TRule> [[nodiscard]] bool nextState(const TRule &policy, int row, int col) const;
+        template<typename TRule> void presetStep(bool wrap);
+        template<typename TRule> void ruleStep(bool wrap, const TRule &policy);
+        template<typename TRule> void multiThreadedStep(bool wrap, const TRule &policy);
+        void denseStep(bool wrap);
+        template<typename TRule> void frontierStep(bool wrap, const TRule &policy);
+        void rebuildFrontier(bool wrap);
+        void trackChange(int row, int col, bool alive, bool wrap);
 
     public:
         Grid() = delete;
@@ -46,6 +128,7 @@ namespace GameOfLife::Game {
         void step(bool wrap) override;
         void step(bool wrap, bool dynamic = true);
         void randomize(float aliveProbability) override;
+        void randomize(float aliveProbability, uint64_t seed);
         void clear() override;
 
         void move(int fromRow, int fromCol, int numRows, int numCols, int toRow, int toCol);
@@ -55,7 +138,7 @@ namespace GameOfLife::Game {
         void print() const override;
         void print(int fromRow, int fromCol, int toRow, int toCol) const override;
 
-        [[nodiscard]] std::vector<std::vector<bool>> getCells() const override { return cells; }
+        [[nodiscard]] std::vector<std::vector<bool>> getCells() const override;
 
         [[nodiscard]] int getRows() const override { return rows; }
         [[nodiscard]] int getCols() const override { return cols; }
@@ -63,8 +146,22 @@ namespace GameOfLife::Game {
         [[nodiscard]] int getMaxRows() const { return maxRows; }
         [[nodiscard]] int getMaxCols() const { return maxCols; }
 
-        [[nodiscard]] std::unordered_set<std::pair<int, int>, HashFunction> getLivingCells() const { return livingCells; }
-        [[nodiscard]] std::unordered_set<std::pair<int, int>, HashFunction> getChangedCells() const { return changedCells; }
+        [[nodiscard]] int64_t getOriginRow() const { return originRow; }
+        [[nodiscard]] int64_t getOriginCol() const { return originCol; }
+
+        [[nodiscard]] CoordinateSet getLivingCells() const { return toGrid(livingCells); }
+        [[nodiscard]] CoordinateSet getChangedCells() const { return toGrid(changedCells); }
+        [[nodiscard]] size_t getPopulation() const { return livingCells.size(); }
+        [[nodiscard]] size_t getBytesCopied() const { return bytesCopied; }
+
+        void setStepMode(StepMode stepMode);
+        [[nodiscard]] StepMode getStepMode() const { return stepMode; }
+
+        void setTopology(Topology topology) { this->topology = topology; frontierValid = false; }
+        [[nodiscard]] Topology getTopology() const { return topology; }
+
+        void setRule(const IsotropicRule &rule) { this->rule = rule; preset = rule.getPreset(); frontierValid = false; }
+        [[nodiscard]] const IsotropicRule &getRule() const { return rule; }
 
         void setFormatConfig(const File::FormatConfig &formatConfig) { this->formatConfig = formatConfig; }
         [[nodiscard]] File::FormatConfig getFormatConfig() const { return formatConfig; }
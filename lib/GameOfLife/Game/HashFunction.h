@@ -1,13 +1,21 @@
 #ifndef HASHFUNCTION_H
 #define HASHFUNCTION_H
 
+#include <cstdint>
 #include <utility>
 #include <functional>
 
 namespace GameOfLife::Game {
     struct HashFunction {
         std::size_t operator()(const std::pair<int, int>& p) const noexcept {
-            return std::hash<int>()(p.first) ^ (std::hash<int>()(p.second) << 1);
+            // Pack both coordinates and mix all the bits, so diagonal cells do not collide
+            uint64_t key = static_cast<uint64_t>(static_cast<uint32_t>(p.first)) << 32 | static_cast<uint32_t>(p.second);
+            key ^= key >> 33;
+            key *= 0xFF51AFD7ED558CCDull;
+            key ^= key >> 33;
+            key *= 0xC4CEB9FE1A85EC53ull;
+            key ^= key >> 33;
+            return key;
         }
     };
 }
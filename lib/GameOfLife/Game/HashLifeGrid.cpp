@@ -0,0 +1,686 @@
+#include "HashLifeGrid.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace GameOfLife::Game {
+    /**
+     * Constructs an empty universe with a visible window of the specified size.
+     *
+     * @param rows Number of visible rows
+     * @param cols Number of visible columns
+     */
+    HashLifeGrid::HashLifeGrid(const int rows, const int cols) : rows(rows), cols(cols) {
+        // Level 0 nodes: dead and alive cells
+        nodes.push_back({NONE, NONE, NONE, NONE, NONE, 0, 0, 0});
+        nodes.push_back({NONE, NONE, NONE, NONE, NONE, 0, 0, 1});
+        rehash(1 << 16);
+        buildBaseTable();
+
+        // Start with a root covering the visible window
+        root = emptyNode(3);
+        while (!isContained(rows, cols) && nodes[root].level < MAX_LEVEL) {
+            root = expand(root);
+        }
+    }
+
+    /**
+     * Constructs a universe from existing cells, placed at the top left of the visible window.
+     *
+     * @param cells Cells
+     * @param rows Number of rows
+     * @param cols Number of columns
+     */
+    HashLifeGrid::HashLifeGrid(const std::vector<std::vector<bool>> &cells, const int rows, const int cols) :
+    HashLifeGrid(rows, cols) {
+        insert(cells, 0, 0, true);
+    }
+
+    /**
+     * Gets the canonical node with the specified children, creating it if needed.
+     *
+     * @param nw North west child
+     * @param ne North east child
+     * @param sw South west child
+     * @param se South east child
+     * @return Node id
+     */
+    uint32_t HashLifeGrid::makeNode(const uint32_t nw, const uint32_t ne, const uint32_t sw, const uint32_t se) {
+        uint64_t hash = (static_cast<uint64_t>(nw) * 0x9E3779B97F4A7C15ull) ^ (static_cast<uint64_t>(ne) * 0xC2B2AE3D27D4EB4Full);
+        hash ^= (static_cast<uint64_t>(sw) * 0x165667B19E3779F9ull) ^ (static_cast<uint64_t>(se) * 0xD6E8FEB86659FD93ull);
+        hash ^= hash >> 29;
+
+        // Linear probing
+        const size_t mask = buckets.size() - 1;
+        size_t index = hash & mask;
+        while (buckets[index] != NONE) {
+            const Node &node = nodes[buckets[index]];
+            if (node.nw == nw && node.ne == ne && node.sw == sw && node.se == se)
+                return buckets[index];
+            index = (index + 1) & mask;
+        }
+
+        // Create the node
+        const uint32_t id = nodes.size();
+        nodes.push_back({nw, ne, sw, se, NONE, static_cast<uint8_t>(nodes[nw].level + 1), 0,
+            nodes[nw].population + nodes[ne].population + nodes[sw].population + nodes[se].population});
+        buckets[index] = id;
+        if (nodes.size() * 2 > buckets.size())
+            rehash(buckets.size() * 2);
+        return id;
+    }
+
+    /**
+     * Rebuilds the node table with the specified number of buckets.
+     *
+     * @param size Number of buckets, must be a power of two
+     */
+    void HashLifeGrid::rehash(const size_t size) {
+        buckets.assign(size, NONE);
+        const size_t mask = size - 1;
+        for (uint32_t id = 2; id < nodes.size(); id++) {
+            const Node &node = nodes[id];
+            uint64_t hash = (static_cast<uint64_t>(node.nw) * 0x9E3779B97F4A7C15ull) ^ (static_cast<uint64_t>(node.ne) * 0xC2B2AE3D27D4EB4Full);
+            hash ^= (static_cast<uint64_t>(node.sw) * 0x165667B19E3779F9ull) ^ (static_cast<uint64_t>(node.se) * 0xD6E8FEB86659FD93ull);
+            hash ^= hash >> 29;
+            size_t index = hash & mask;
+            while (buckets[index] != NONE) {
+                index = (index + 1) & mask;
+            }
+            buckets[index] = id;
+        }
+    }
+
+    /**
+     * Gets the empty node of a level.
+     *
+     * @param level Node level
+     * @return Node id
+     */
+    uint32_t HashLifeGrid::emptyNode(const int level) {
+        if (emptyNodes.empty())
+            emptyNodes.push_back(0);
+        while (emptyNodes.size() <= static_cast<size_t>(level)) {
+            const uint32_t child = emptyNodes.back();
+            emptyNodes.push_back(makeNode(child, child, child, child));
+        }
+        return emptyNodes[level];
+    }
+
+    /**
+     * Wraps a node in a node of the next level, keeping it centered.
+     *
+     * @param node Node id
+     * @return Expanded node id
+     */
+    uint32_t HashLifeGrid::expand(const uint32_t node) {
+        const Node n = nodes[node];
+        const uint32_t empty = emptyNode(n.level - 1);
+        return makeNode(makeNode(empty, empty, empty, n.nw), makeNode(empty, empty, n.ne, empty),
+            makeNode(empty, n.sw, empty, empty), makeNode(n.se, empty, empty, empty));
+    }
+
+    /**
+     * Gets the centered node of the previous level.
+     *
+     * @param node Node id, at least level 2
+     * @return Centre node id
+     */
+    uint32_t HashLifeGrid::centre(const uint32_t node) {
+        const Node n = nodes[node];
+        return makeNode(nodes[n.nw].se, nodes[n.ne].sw, nodes[n.sw].ne, nodes[n.se].nw);
+    }
+
+    /**
+     * Builds the lookup table of the base case for the current rule (bit y * 4 + x of a 4x4 block).
+     */
+    void HashLifeGrid::buildBaseTable() {
+        baseTable.fill(0);
+        for (int block = 0; block < 1 << 16; block++) {
+            for (int y = 1; y <= 2; y++) {
+                for (int x = 1; x <= 2; x++) {
+                    int index = 0;
+                    for (int dy = -1; dy <= 1; dy++) {
+                        for (int dx = -1; dx <= 1; dx++) {
+                            index |= (block >> ((y + dy) * 4 + x + dx) & 1) << ((dy + 1) * 3 + dx + 1);
+                        }
+                    }
+                    if (rule.next(index))
+                        baseTable[block] |= 1 << ((y - 1) * 2 + x - 1);
+                }
+            }
+        }
+    }
+
+    /**
+     * Changes the rule. Every memoized result belongs to the previous rule, so all of them are dropped.
+     *
+     * @param rule Rule
+     */
+    void HashLifeGrid::setRule(const IsotropicRule &rule) {
+        if (rule == this->rule)
+            return;
+        this->rule = rule;
+        buildBaseTable();
+        for (auto &node : nodes) {
+            node.result = NONE;
+        }
+    }
+
+    /**
+     * Computes the centre 2x2 of a 4x4 node after one generation, with a lookup table.
+     *
+     * @param node Node id, level 2
+     * @return Level 1 node id
+     */
+    uint32_t HashLifeGrid::baseSuccessor(const uint32_t node) {
+        const Node n = nodes[node];
+        const Node quadrants[4] = {nodes[n.nw], nodes[n.ne], nodes[n.sw], nodes[n.se]};
+        int block = 0;
+        for (int q = 0; q < 4; q++) {
+            const int y = (q / 2) * 2;
+            const int x = (q % 2) * 2;
+            block |= quadrants[q].nw << (y * 4 + x) | quadrants[q].ne << (y * 4 + x + 1) |
+                quadrants[q].sw << ((y + 1) * 4 + x) | quadrants[q].se << ((y + 1) * 4 + x + 1);
+        }
+
+        const int next = baseTable[block];
+        return makeNode(next & 1, next >> 1 & 1, next >> 2 & 1, next >> 3 & 1);
+    }
+
+    /**
+     * Computes the centre of a node, 2^exponent generations later. Results are memoized in the node.
+     *
+     * @param node Node id, level k >= 2
+     * @param exponent Log2 of the number of generations, at most k - 2
+     * @return Node id of level k - 1
+     */
+    uint32_t HashLifeGrid::successor(const uint32_t node, const int exponent) {
+        const Node n = nodes[node];
+        if (n.population == 0)
+            return emptyNode(n.level - 1);
+        if (n.result != NONE && n.resultExponent == exponent)
+            return n.result;
+
+        uint32_t result;
+        if (n.level == 2) {
+            result = baseSuccessor(node);
+        } else {
+            const Node a = nodes[n.nw], b = nodes[n.ne], c = nodes[n.sw], d = nodes[n.se];
+
+            // Nine overlapping sub-nodes of level k - 1
+            uint32_t sub[3][3] = {
+                {n.nw, makeNode(a.ne, b.nw, a.se, b.sw), n.ne},
+                {makeNode(a.sw, a.se, c.nw, c.ne), makeNode(a.se, b.sw, c.ne, d.nw), makeNode(b.sw, b.se, d.nw, d.ne)},
+                {n.sw, makeNode(c.ne, d.nw, c.se, d.sw), n.se}
+            };
+
+            // Full speed: both halves advance, otherwise only the second one does
+            const bool fullSpeed = exponent == n.level - 2;
+            for (auto &row : sub) {
+                for (auto &child : row) {
+                    child = fullSpeed ? successor(child, exponent - 1) : centre(child);
+                }
+            }
+
+            const int next = fullSpeed ? exponent - 1 : exponent;
+            result = makeNode(
+                successor(makeNode(sub[0][0], sub[0][1], sub[1][0], sub[1][1]), next),
+                successor(makeNode(sub[0][1], sub[0][2], sub[1][1], sub[1][2]), next),
+                successor(makeNode(sub[1][0], sub[1][1], sub[2][0], sub[2][1]), next),
+                successor(makeNode(sub[1][1], sub[1][2], sub[2][1], sub[2][2]), next));
+        }
+
+        nodes[node].result = result;
+        nodes[node].resultExponent = exponent;
+        return result;
+    }
+
+    /**
+     * Sets a cell inside a node.
+     *
+     * @param node Node id
+     * @param y Row relative to the top of the node
+     * @param x Column relative to the left of the node
+     * @param alive Alive status
+     * @return New node id
+     */
+    uint32_t HashLifeGrid::setCell(const uint32_t node, const int64_t y, const int64_t x, const bool alive) {
+        const Node n = nodes[node];
+        if (n.level == 0)
+            return alive ? 1 : 0;
+
+        const int64_t half = int64_t{1} << (n.level - 1);
+        if (y < half) {
+            return x < half ? makeNode(setCell(n.nw, y, x, alive), n.ne, n.sw, n.se) :
+                makeNode(n.nw, setCell(n.ne, y, x - half, alive), n.sw, n.se);
+        }
+        return x < half ? makeNode(n.nw, n.ne, setCell(n.sw, y - half, x, alive), n.se) :
+            makeNode(n.nw, n.ne, n.sw, setCell(n.se, y - half, x - half, alive));
+    }
+
+    /**
+     * Gets a cell inside a node.
+     *
+     * @param node Node id
+     * @param y Row relative to the top of the node
+     * @param x Column relative to the left of the node
+     * @return True if the cell is alive, false otherwise
+     */
+    bool HashLifeGrid::getCell(uint32_t node, int64_t y, int64_t x) const {
+        while (nodes[node].level > 0) {
+            const Node &n = nodes[node];
+            if (n.population == 0)
+                return false;
+            const int64_t half = int64_t{1} << (n.level - 1);
+            node = y < half ? (x < half ? n.nw : n.ne) : (x < half ? n.sw : n.se);
+            y = y < half ? y : y - half;
+            x = x < half ? x : x - half;
+        }
+        return node == 1;
+    }
+
+    /**
+     * Collects the living cells of a node, or only those inside the visible window.
+     *
+     * @param node Node id
+     * @param top Universe row of the top of the node
+     * @param left Universe column of the left of the node
+     * @param clip Only collect the cells inside the visible window
+     * @param living Living cells, relative to the visible window
+     */
+    void HashLifeGrid::collectLiving(const uint32_t node, const int64_t top, const int64_t left, const bool clip,
+        std::vector<std::pair<int64_t, int64_t>> &living) const {
+        const Node &n = nodes[node];
+        const int64_t size = int64_t{1} << n.level;
+        if (n.population == 0)
+            return;
+        if (clip && (top >= originRow + rows || left >= originCol + cols || top + size <= originRow || left + size <= originCol))
+            return;
+
+        if (n.level == 0) {
+            living.emplace_back(top - originRow, left - originCol);
+            return;
+        }
+
+        const int64_t half = size / 2;
+        collectLiving(n.nw, top, left, clip, living);
+        collectLiving(n.ne, top, left + half, clip, living);
+        collectLiving(n.sw, top + half, left, clip, living);
+        collectLiving(n.se, top + half, left + half, clip, living);
+    }
+
+    /**
+     * Checks if a universe coordinate is covered by the root node.
+     *
+     * @param y Universe row
+     * @param x Universe column
+     * @return True if covered, false otherwise
+     */
+    bool HashLifeGrid::isContained(const int64_t y, const int64_t x) const {
+        const int64_t half = int64_t{1} << (nodes[root].level - 1);
+        return y >= -half && y < half && x >= -half && x < half;
+    }
+
+    /**
+     * Checks if the whole population is in the inner quarter of the root,
+     * so nothing can escape the result of a step of the root.
+     *
+     * @return True if padded, false otherwise
+     */
+    bool HashLifeGrid::isPadded() const {
+        const Node &n = nodes[root];
+        if (n.level < 3)
+            return false;
+        const uint64_t inner = nodes[nodes[nodes[n.nw].se].se].population + nodes[nodes[nodes[n.ne].sw].sw].population +
+            nodes[nodes[nodes[n.sw].ne].ne].population + nodes[nodes[nodes[n.se].nw].nw].population;
+        return inner == n.population;
+    }
+
+    /**
+     * Frees the nodes that are no longer reachable from the root.
+     * Memoized results are kept when they point to a surviving node.
+     */
+    void HashLifeGrid::collectGarbage() {
+        // Mark the nodes reachable from the root
+        std::vector<bool> marked(nodes.size());
+        marked[0] = marked[1] = true;
+        std::vector<uint32_t> stack = {root};
+        while (!stack.empty()) {
+            const uint32_t id = stack.back();
+            stack.pop_back();
+            if (marked[id])
+                continue;
+            marked[id] = true;
+            stack.insert(stack.end(), {nodes[id].nw, nodes[id].ne, nodes[id].sw, nodes[id].se});
+        }
+
+        // Compact the nodes, children always have a smaller id than their parent
+        std::vector<uint32_t> remap(nodes.size(), NONE);
+        remap[0] = 0;
+        remap[1] = 1;
+        uint32_t count = 2;
+        for (uint32_t id = 2; id < nodes.size(); id++) {
+            if (!marked[id])
+                continue;
+            Node node = nodes[id];
+            node.nw = remap[node.nw];
+            node.ne = remap[node.ne];
+            node.sw = remap[node.sw];
+            node.se = remap[node.se];
+            remap[id] = count;
+            nodes[count++] = node;
+        }
+        for (uint32_t id = 2; id < count; id++) {
+            const uint32_t result = nodes[id].result;
+            nodes[id].result = result != NONE && marked[result] ? remap[result] : NONE;
+        }
+
+        root = remap[root];
+        nodes.resize(count);
+        nodes.shrink_to_fit();
+        emptyNodes.clear();
+        rehash(std::max<size_t>(std::bit_ceil(static_cast<size_t>(count) * 2), 1 << 16));
+        collections++;
+    }
+
+    /**
+     * Sets the cell at the specified row and column to be alive or dead.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param alive Alive status
+     */
+    void HashLifeGrid::setAlive(const int row, const int col, const bool alive) {
+        const int64_t y = originRow + row;
+        const int64_t x = originCol + col;
+        while (!isContained(y, x)) {
+            if (nodes[root].level >= MAX_LEVEL)
+                throw std::out_of_range("The cell is outside of the universe.");
+            root = expand(root);
+        }
+
+        const int64_t half = int64_t{1} << (nodes[root].level - 1);
+        root = setCell(root, y + half, x + half, alive);
+    }
+
+    /**
+     * Checks if the cell at the specified row and column is alive.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @return True if the cell is alive, false otherwise
+     */
+    bool HashLifeGrid::isAlive(const int row, const int col) const {
+        const int64_t y = originRow + row;
+        const int64_t x = originCol + col;
+        if (!isContained(y, x))
+            return false;
+
+        const int64_t half = int64_t{1} << (nodes[root].level - 1);
+        return getCell(root, y + half, x + half);
+    }
+
+    /**
+     * Counts the number of living neighbors around the cell at the specified row and column.
+     * The universe is unbounded, so it never wraps.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param wrap Unused
+     * @return Number of living neighbors
+     */
+    int HashLifeGrid::countNeighbors(const int row, const int col, [[maybe_unused]] const bool wrap) const {
+        int count = 0;
+        for (int i = row - 1; i <= row + 1; i++) {
+            for (int j = col - 1; j <= col + 1; j++) {
+                if (i != row || j != col)
+                    count += isAlive(i, j);
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Advances the universe by 2^exponent generations.
+     *
+     * @param exponent Log2 of the number of generations
+     */
+    void HashLifeGrid::stepPow2(const int exponent) {
+        if (exponent < 0 || exponent > MAX_LEVEL - 3) {
+            throw std::invalid_argument("The step exponent must be between 0 and " + std::to_string(MAX_LEVEL - 3) + ".");
+        }
+
+        // Free memory between steps, so the nodes in use are only reachable from the root
+        if (getMemoryUsage() > memoryLimit)
+            collectGarbage();
+
+        // Pad the root so the pattern cannot escape the result
+        while (nodes[root].level < exponent + 3 || !isPadded()) {
+            if (nodes[root].level >= MAX_LEVEL)
+                throw std::out_of_range("The pattern does not fit in the universe.");
+            root = expand(root);
+        }
+
+        root = successor(root, exponent);
+        generation += uint64_t{1} << exponent;
+    }
+
+    /**
+     * Advances the universe by any number of generations, as a sum of powers of two.
+     *
+     * @param generations Number of generations
+     */
+    void HashLifeGrid::advance(const uint64_t generations) {
+        for (int exponent = 63; exponent >= 0; exponent--) {
+            if (generations >> exponent & 1)
+                stepPow2(exponent);
+        }
+    }
+
+    /**
+     * Steps the universe by 2^stepExponent generations.
+     */
+    void HashLifeGrid::step() {
+        stepPow2(stepExponent);
+    }
+
+    /**
+     * Steps the universe by 2^stepExponent generations.
+     *
+     * @param wrap Unused, the universe is unbounded
+     */
+    void HashLifeGrid::step([[maybe_unused]] const bool wrap) {
+        step();
+    }
+
+    /**
+     * Steps the universe by 2^stepExponent generations.
+     *
+     * @param wrap Unused, the universe is unbounded
+     * @param dynamic Unused, the universe is unbounded
+     */
+    void HashLifeGrid::step([[maybe_unused]] const bool wrap, [[maybe_unused]] const bool dynamic) {
+        step();
+    }
+
+    /**
+     * Sets the number of generations of a step, as a power of two.
+     *
+     * @param stepExponent Log2 of the number of generations per step
+     */
+    void HashLifeGrid::setStepExponent(const int stepExponent) {
+        if (stepExponent < 0 || stepExponent > MAX_LEVEL - 3) {
+            throw std::invalid_argument("The step exponent must be between 0 and " + std::to_string(MAX_LEVEL - 3) + ".");
+        }
+        this->stepExponent = stepExponent;
+    }
+
+    /**
+     * Moves the visible window, adding rows and columns to the north, east, south, and west.
+     *
+     * @param addNorth Number of rows to add to the north
+     * @param addEast Number of columns to add to the east
+     * @param addSouth Number of rows to add to the south
+     * @param addWest Number of columns to add to the west
+     */
+    void HashLifeGrid::resize(const int addNorth, const int addEast, const int addSouth, const int addWest) {
+        // Argument check
+        if (addNorth < 0 || addEast < 0 || addSouth < 0 || addWest < 0) {
+            throw std::invalid_argument("The number of rows and columns to add must be positive.");
+        }
+
+        originRow -= addNorth;
+        originCol -= addWest;
+        rows += addNorth + addSouth;
+        cols += addEast + addWest;
+    }
+
+    /**
+     * Inserts a pattern into the universe.
+     *
+     * @param cells The pattern to insert
+     * @param row The row to insert the pattern at
+     * @param col The column to insert the pattern at
+     * @param hollow If true, only the living cells will be inserted
+     */
+    void HashLifeGrid::insert(const std::vector<std::vector<bool>> &cells, const int row, const int col, const bool hollow) {
+        for (int i = 0; i < static_cast<int>(cells.size()); ++i) {
+            for (int j = 0; j < static_cast<int>(cells[i].size()); ++j) {
+                if (!hollow || cells[i][j])
+                    setAlive(row + i, col + j, cells[i][j]);
+            }
+        }
+    }
+
+    /**
+     * Randomizes the visible window with the specified probability of a cell being alive.
+     *
+     * @param aliveProbability Probability of a cell being alive
+     */
+    void HashLifeGrid::randomize(const float aliveProbability) {
+        if (aliveProbability < 0 || aliveProbability > 1)
+            return;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                if ((rand() % 100) < aliveProbability * 100)
+                    setAlive(i, j, true);
+            }
+        }
+    }
+
+    /**
+     * Clears the universe.
+     */
+    void HashLifeGrid::clear() {
+        root = emptyNode(nodes[root].level);
+    }
+
+    /**
+     * Prints the visible window to the console.
+     */
+    void HashLifeGrid::print() const {
+        print(0, 0, rows, cols);
+    }
+
+    /**
+     * Prints a section of the universe to the console.
+     *
+     * @param fromRow The starting row
+     * @param fromCol The starting column
+     * @param toRow The ending row
+     * @param toCol The ending column
+     */
+    void HashLifeGrid::print(const int fromRow, const int fromCol, const int toRow, const int toCol) const {
+        for (int i = fromRow; i < toRow; i++) {
+            for (int j = fromCol; j < toCol; j++) {
+                std::cout << (isAlive(i, j) ? 'O' : '.') << ' ';
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    /**
+     * Gets the visible window as a 2D vector.
+     *
+     * @return Visible cells
+     */
+    std::vector<std::vector<bool>> HashLifeGrid::getCells() const {
+        std::vector visible(rows, std::vector<bool>(cols));
+        for (const auto &[row, col] : getLivingCells()) {
+            visible[row][col] = true;
+        }
+        return visible;
+    }
+
+    /**
+     * Gets the coordinates of the living cells in the visible window.
+     *
+     * @return Set of living cells
+     */
+    CoordinateSet HashLifeGrid::getLivingCells() const {
+        std::vector<std::pair<int64_t, int64_t>> living;
+        const int64_t half = int64_t{1} << (nodes[root].level - 1);
+        collectLiving(root, -half, -half, true, living);
+        CoordinateSet result;
+        for (const auto &[row, col] : living) {
+            result.emplace(static_cast<int>(row), static_cast<int>(col));
+        }
+        return result;
+    }
+
+    /**
+     * Gets the coordinates of every living cell of the universe, inside the visible window or not.
+     *
+     * @return Living cells, relative to the visible window
+     */
+    std::vector<std::pair<int64_t, int64_t>> HashLifeGrid::getUniverseCells() const {
+        std::vector<std::pair<int64_t, int64_t>> living;
+        living.reserve(nodes[root].population);
+        const int64_t half = int64_t{1} << (nodes[root].level - 1);
+        collectLiving(root, -half, -half, false, living);
+        return living;
+    }
+
+    /**
+     * Moves the whole pattern relative to the visible window, by moving the window the other way.
+     *
+     * @param dRow Rows to move the pattern by, positive to the south
+     * @param dCol Columns to move the pattern by, positive to the east
+     */
+    void HashLifeGrid::translate(const int64_t dRow, const int64_t dCol) {
+        originRow -= dRow;
+        originCol -= dCol;
+    }
+
+    /**
+     * Gets the approximate memory used by the node cache.
+     *
+     * @return Memory usage in bytes
+     */
+    size_t HashLifeGrid::getMemoryUsage() const {
+        return nodes.capacity() * sizeof(Node) + buckets.capacity() * sizeof(uint32_t);
+    }
+
+    /**
+     * IWritable implementation.
+     * Gets the visible window as a string.
+     *
+     * @return The visible window as a string
+     */
+    std::string HashLifeGrid::getText() const {
+        const auto visible = getCells();
+        std::stringstream ss;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                ss << (visible[i][j] ? formatConfig.getAliveChar() : formatConfig.getDeadChar()) << formatConfig.getDelimiterChar();
+            }
+            ss << '\n';
+        }
+        return ss.str();
+    }
+}
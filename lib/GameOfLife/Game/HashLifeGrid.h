@@ -0,0 +1,126 @@
+#ifndef HASHLIFEGRID_H
+#define HASHLIFEGRID_H
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "BaseGrid.h"
+#include "CoordinateSet.h"
+#include "Rules.h"
+#include "File/FormatConfig.h"
+
+#define DEFAULT_HASHLIFE_MEMORY (512ull << 20)
+
+namespace GameOfLife::Game {
+    /**
+     * HashLife implementation of an unbounded grid.
+     * The universe is a quadtree of canonical (hash-consed) nodes, each memoizing its own future,
+     * so a single step can advance 2^k generations. Rows and columns only define the visible window.
+     */
+    class HashLifeGrid : public BaseGrid<std::vector<std::vector<bool>>, bool> {
+    private:
+        /**
+         * Quadtree node covering 2^level x 2^level cells. Level 0 nodes are the dead (0) and alive (1) cells.
+         */
+        struct Node {
+            uint32_t nw, ne, sw, se;
+            uint32_t result;
+            uint8_t level;
+            uint8_t resultExponent;
+            uint64_t population;
+        };
+
+        static constexpr uint32_t NONE = UINT32_MAX;
+        static constexpr int MAX_LEVEL = 62;
+
+        std::vector<Node> nodes;
+        std::vector<uint32_t> buckets;
+        std::vector<uint32_t> emptyNodes;
+        uint32_t root;
+
+        int rows;
+        int cols;
+        int64_t originRow = 0;
+        int64_t originCol = 0;
+
+        uint64_t generation = 0;
+        int stepExponent = 0;
+        size_t memoryLimit = DEFAULT_HASHLIFE_MEMORY;
+        int collections = 0;
+
+        // Next state of the centre 2x2 of every 4x4 block under the rule
+        IsotropicRule rule;
+        std::array<uint8_t, 1 << 16> baseTable{};
+
+        File::FormatConfig formatConfig = File::FormatConfig('O', '.', '\0');
+
+        uint32_t makeNode(uint32_t nw, uint32_t ne, uint32_t sw, uint32_t se);
+        uint32_t emptyNode(int level);
+        uint32_t expand(uint32_t node);
+        uint32_t centre(uint32_t node);
+        uint32_t successor(uint32_t node, int exponent);
+        uint32_t baseSuccessor(uint32_t node);
+        void buildBaseTable();
+        uint32_t setCell(uint32_t node, int64_t y, int64_t x, bool alive);
+        [[nodiscard]] bool getCell(uint32_t node, int64_t y, int64_t x) const;
+        void collectLiving(uint32_t node, int64_t top, int64_t left, bool clip,
+            std::vector<std::pair<int64_t, int64_t>> &living) const;
+        [[nodiscard]] bool isContained(int64_t y, int64_t x) const;
+        [[nodiscard]] bool isPadded() const;
+        void rehash(size_t size);
+        void collectGarbage();
+
+    public:
+        HashLifeGrid() = delete;
+        HashLifeGrid(int rows, int cols);
+        HashLifeGrid(const std::vector<std::vector<bool>> &cells, int rows, int cols);
+        ~HashLifeGrid() override = default;
+
+        void setAlive(int row, int col, bool alive) override;
+        [[nodiscard]] bool isAlive(int row, int col) const override;
+        [[nodiscard]] int countNeighbors(int row, int col, bool wrap) const override;
+
+        void step() override;
+        void step(bool wrap) override;
+        void step(bool wrap, bool dynamic);
+        void stepPow2(int exponent);
+        void advance(uint64_t generations);
+        void randomize(float aliveProbability) override;
+        void clear() override;
+
+        void resize(int addNorth, int addEast, int addSouth, int addWest);
+        void insert(const std::vector<std::vector<bool>> &cells, int row, int col, bool hollow = false);
+
+        void print() const override;
+        void print(int fromRow, int fromCol, int toRow, int toCol) const override;
+
+        [[nodiscard]] std::vector<std::vector<bool>> getCells() const override;
+
+        [[nodiscard]] int getRows() const override { return rows; }
+        [[nodiscard]] int getCols() const override { return cols; }
+
+        [[nodiscard]] CoordinateSet getLivingCells() const;
+        [[nodiscard]] std::vector<std::pair<int64_t, int64_t>> getUniverseCells() const;
+        [[nodiscard]] size_t getPopulation() const { return nodes[root].population; }
+        void translate(int64_t dRow, int64_t dCol);
+
+        [[nodiscard]] uint64_t getGeneration() const { return generation; }
+        void setStepExponent(int stepExponent);
+        [[nodiscard]] int getStepExponent() const { return stepExponent; }
+        void setMemoryLimit(size_t memoryLimit) { this->memoryLimit = memoryLimit; }
+        [[nodiscard]] size_t getMemoryLimit() const { return memoryLimit; }
+        [[nodiscard]] size_t getMemoryUsage() const;
+        [[nodiscard]] size_t getNodeCount() const { return nodes.size(); }
+        [[nodiscard]] int getCollections() const { return collections; }
+
+        void setRule(const IsotropicRule &rule);
+        [[nodiscard]] const IsotropicRule &getRule() const { return rule; }
+
+        void setFormatConfig(const File::FormatConfig &formatConfig) { this->formatConfig = formatConfig; }
+        [[nodiscard]] File::FormatConfig getFormatConfig() const { return formatConfig; }
+
+        [[nodiscard]] std::string getText() const override;
+    };
+}
+
+#endif //HASHLIFEGRID_H
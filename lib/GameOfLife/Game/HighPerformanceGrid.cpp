@@ -0,0 +1,604 @@
+#include "HighPerformanceGrid.h"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+#include <sstream>
+
+#include "StepKernel.h"
+
+namespace GameOfLife::Game {
+    /**
+     * Constructs a grid with the specified number of rows and columns.
+     *
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param maxRows Maximum number of rows
+     * @param maxCols Maximum number of columns
+     * @param isDynamic Enable dynamic resizing
+     */
+    HighPerformanceGrid::HighPerformanceGrid(const int rows, const int cols, const int maxRows, const int maxCols, const bool isDynamic) :
+    rows(rows), cols(cols), maxRows(maxRows), maxCols(maxCols), wordsPerRow((cols + 63) / 64), isDynamic(isDynamic) {
+        cells.resize(static_cast<size_t>(rows) * wordsPerRow);
+        next.resize(cells.size());
+        changed.resize(cells.size());
+    }
+
+    /**
+     * Constructs a grid from existing cells.
+     *
+     * @param cells Cells to pack
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param maxRows Maximum number of rows
+     * @param maxCols Maximum number of columns
+     * @param isDynamic Enable dynamic resizing
+     */
+    HighPerformanceGrid::HighPerformanceGrid(const std::vector<std::vector<bool>> &cells, const int rows, const int cols,
+        const int maxRows, const int maxCols, const bool isDynamic) :
+    HighPerformanceGrid(rows, cols, maxRows, maxCols, isDynamic) {
+        // Pack the cells
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                if (cells[i][j])
+                    this->cells[static_cast<size_t>(i) * wordsPerRow + j / 64] |= uint64_t{1} << (j % 64);
+            }
+        }
+
+        changed = this->cells;
+    }
+
+    /**
+     * Marks a cell as changed, so it is redrawn by the GUI.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     */
+    void HighPerformanceGrid::markChanged(const int row, const int col) {
+        changed[static_cast<size_t>(row) * wordsPerRow + col / 64] |= uint64_t{1} << (col % 64);
+    }
+
+    /**
+     * Runs a loop over the rows on the thread pool, or on the calling thread for small grids.
+     *
+     * @param count Number of rows
+     * @param task Task run on each range of rows
+     */
+    void HighPerformanceGrid::parallelFor(const size_t count, const ThreadPool::Task &task) {
+        if (static_cast<size_t>(rows) * cols <= static_cast<size_t>(multiThreadedThreshold)) {
+            task(0, count, 0);
+            return;
+        }
+
+        if (!pool)
+            pool = std::make_shared<ThreadPool>();
+        const int workers = pool->getWorkerCount();
+        pool->parallelFor(count, (count + workers - 1) / workers, task);
+    }
+
+    /**
+     * Sets the cell at the specified row and column to be alive or dead.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param alive Alive status
+     */
+    void HighPerformanceGrid::setAlive(const int row, const int col, const bool alive) {
+        uint64_t &word = cells[static_cast<size_t>(row) * wordsPerRow + col / 64];
+        const uint64_t bit = uint64_t{1} << (col % 64);
+        if (((word & bit) != 0) != alive)
+            markChanged(row, col);
+        word = alive ? word | bit : word & ~bit;
+    }
+
+    /**
+     * Checks if the cell at the specified row and column is alive.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @return True if the cell is alive, false otherwise
+     */
+    bool HighPerformanceGrid::isAlive(const int row, const int col) const {
+        return cells[static_cast<size_t>(row) * wordsPerRow + col / 64] >> (col % 64) & 1;
+    }
+
+    /**
+     * Counts the number of living neighbors around the cell at the specified row and column.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param wrap Whether the grid should wrap around the edges
+     * @return Number of living neighbors
+     */
+    int HighPerformanceGrid::countNeighbors(const int row, const int col, const bool wrap) const {
+        int count = 0;
+
+        for (int i = row - 1; i <= row + 1; i++) {
+            for (int j = col - 1; j <= col + 1; j++) {
+                if (i == row && j == col) {
+                    continue;
+                }
+
+                const int wrappedRow = wrap ? (i + rows) % rows : i;
+                const int wrappedCol = wrap ? (j + cols) % cols : j;
+
+                if (wrappedRow >= 0 && wrappedRow < rows && wrappedCol >= 0 && wrappedCol < cols) {
+                    count += isAlive(wrappedRow, wrappedCol);
+                }
+            }
+        }
+
+        return count;
+    }
+
+    /**
+     * Steps the grid to the next generation, or by the block depth with temporal blocking.
+     *
+     * @param wrap If true, the grid will wrap around the edges. This will disable dynamic resizing.
+     * @param dynamic If true, the grid will resize if a living cell is on the edge (overrides isDynamic property).
+     */
+    void HighPerformanceGrid::step(const bool wrap, const bool dynamic) {
+        // Check if the grid should be resized
+        if (isDynamic && !wrap && dynamic) {
+            // Check if a living cell is on the edge
+            bool onEdgeNorth = false, onEdgeEast = false, onEdgeSouth = false, onEdgeWest = false;
+            for (int w = 0; w < wordsPerRow; w++) {
+                onEdgeNorth |= cells[w] != 0;
+                onEdgeSouth |= cells[static_cast<size_t>(rows - 1) * wordsPerRow + w] != 0;
+            }
+            for (int i = 0; i < rows; i++) {
+                onEdgeWest |= isAlive(i, 0);
+                onEdgeEast |= isAlive(i, cols - 1);
+            }
+            resize(onEdgeNorth ? 1 : 0, onEdgeEast ? 1 : 0, onEdgeSouth ? 1 : 0, onEdgeWest ? 1 : 0);
+        }
+
+        // A growing grid needs its edges checked on each generation, so it is not blocked
+        const int depth = isDynamic && !wrap && dynamic ? 1 : getEffectiveBlockDepth();
+        if (depth > 1)
+            blockedStep(wrap, depth);
+        else {
+            const std::vector<uint64_t> empty(wordsPerRow);
+            parallelFor(rows, [&](const size_t begin, const size_t end, int) {
+                thread_local std::vector<uint64_t> births, survivals;
+                births.resize(wordsPerRow);
+                survivals.resize(wordsPerRow);
+                for (int i = static_cast<int>(begin); i < static_cast<int>(end); i++) {
+                    const uint64_t *above = i > 0 ? &cells[static_cast<size_t>(i - 1) * wordsPerRow] :
+                        wrap ? &cells[static_cast<size_t>(rows - 1) * wordsPerRow] : empty.data();
+                    const uint64_t *below = i < rows - 1 ? &cells[static_cast<size_t>(i + 1) * wordsPerRow] :
+                        wrap ? &cells[0] : empty.data();
+                    stepRow(above, &cells[static_cast<size_t>(i) * wordsPerRow], below, &next[static_cast<size_t>(i) * wordsPerRow],
+                        i, generation, wrap, births.data(), survivals.data());
+                }
+            });
+            generation++;
+        }
+
+        // Record the changed cells and swap the generations
+        for (size_t w = 0; w < cells.size(); w++) {
+            changed[w] = cells[w] ^ next[w];
+        }
+        std::swap(cells, next);
+    }
+
+    /**
+     * Steps a row to the next generation, keeping each birth and survival with its probability in stochastic mode.
+     *
+     * @param above Row above
+     * @param current Row to step
+     * @param below Row below
+     * @param out Next generation of the row
+     * @param row Index of the row in the grid
+     * @param generation Generation of the row
+     * @param wrap If true, the first and last columns are adjacent
+     * @param births Buffer of a row for the birth draws
+     * @param survivals Buffer of a row for the survival draws
+     */
+    void HighPerformanceGrid::stepRow(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+        const int row, const uint64_t generation, const bool wrap, uint64_t *births, uint64_t *survivals) const {
+        StepKernel::stepRow(above, current, below, out, wordsPerRow, cols, wrap, rule);
+        if (!isStochastic())
+            return;
+
+        Random::bernoulliRow(births, cols, birthThreshold, seed, static_cast<uint32_t>(generation), row, Random::Stream::BIRTH);
+        Random::bernoulliRow(survivals, cols, survivalThreshold, seed, static_cast<uint32_t>(generation), row,
+            Random::Stream::SURVIVAL);
+        for (int w = 0; w < wordsPerRow; w++) {
+            out[w] &= (~current[w] & births[w]) | (current[w] & survivals[w]);
+        }
+    }
+
+    /**
+     * Advances the grid by several generations with temporal blocking.
+     * Each band of rows is copied with a halo of depth rows on both sides, then stepped depth times in two local
+     * buffers, the valid rows shrinking by one on each side per generation (a trapezoid), so only the band is left
+     * valid at the end. Bands only read the current generation and only write their own rows of the next one, so they
+     * need no synchronization; the halo rows are computed twice, by both neighboring bands.
+     * The grid is read and written once per step instead of once per generation.
+     *
+     * @param wrap If true, the grid will wrap around the edges.
+     * @param depth Number of generations to advance
+     */
+    void HighPerformanceGrid::blockedStep(const bool wrap, const int depth) {
+        const int band = getBandRows(depth);
+        const int bands = (rows + band - 1) / band;
+        parallelFor(bands, [&](const size_t begin, const size_t end, int) {
+            thread_local std::vector<uint64_t> front, back, births, survivals;
+            births.resize(wordsPerRow);
+            survivals.resize(wordsPerRow);
+            for (int b = static_cast<int>(begin); b < static_cast<int>(end); b++) {
+                const int first = b * band;
+                const int count = std::min(band, rows - first);
+                const int height = count + 2 * depth;
+                // Each generation writes every row the next one reads, so the buffers are not cleared
+                front.resize(static_cast<size_t>(height) * wordsPerRow);
+                back.resize(front.size());
+
+                // Local row l is row first - depth + l of the grid, past the edges it wraps or stays dead
+                const auto gridRow = [&](const int l) {
+                    const int row = first - depth + l;
+                    return wrap ? (row % rows + rows) % rows : row;
+                };
+                for (int l = 0; l < height; l++) {
+                    const int row = gridRow(l);
+                    if (row >= 0 && row < rows)
+                        std::copy_n(&cells[static_cast<size_t>(row) * wordsPerRow], wordsPerRow, &front[static_cast<size_t>(l) * wordsPerRow]);
+                    else
+                        std::fill_n(&front[static_cast<size_t>(l) * wordsPerRow], wordsPerRow, 0);
+                }
+
+                for (int g = 0; g < depth; g++) {
+                    for (int l = g + 1; l < height - g - 1; l++) {
+                        const int row = gridRow(l);
+                        uint64_t *out = &back[static_cast<size_t>(l) * wordsPerRow];
+                        if (row < 0 || row >= rows) {
+                            std::fill_n(out, wordsPerRow, 0);
+                            continue;
+                        }
+                        const uint64_t *current = &front[static_cast<size_t>(l) * wordsPerRow];
+                        stepRow(current - wordsPerRow, current, current + wordsPerRow, out, row, generation + g, wrap,
+                            births.data(), survivals.data());
+                    }
+                    std::swap(front, back);
+                }
+
+                std::copy_n(&front[static_cast<size_t>(depth) * wordsPerRow], static_cast<size_t>(count) * wordsPerRow,
+                    &next[static_cast<size_t>(first) * wordsPerRow]);
+            }
+        });
+        generation += depth;
+    }
+
+    /**
+     * Sets the number of generations advanced by each step, with temporal blocking above 1.
+     *
+     * @param blockDepth Generations per step, or 0 to pick it from the grid size
+     */
+    void HighPerformanceGrid::setBlockDepth(const int blockDepth) {
+        if (blockDepth < 0)
+            throw std::invalid_argument("The block depth must be positive.");
+        this->blockDepth = blockDepth;
+    }
+
+    /**
+     * Gets the number of generations advanced by each step. In automatic mode, grids that fit in cache are stepped one
+     * generation at a time, larger grids are blocked.
+     *
+     * @return Generations per step
+     */
+    int HighPerformanceGrid::getEffectiveBlockDepth() const {
+        if (blockDepth > 0)
+            return blockDepth;
+        return cells.size() * sizeof(uint64_t) * 2 <= 4 * BAND_BYTES ? 1 : AUTO_BLOCK_DEPTH;
+    }
+
+    /**
+     * Sets the number of rows of the bands advanced by a blocked step.
+     *
+     * @param bandRows Rows per band, or 0 to fit a band with its halo in the cache
+     */
+    void HighPerformanceGrid::setBandRows(const int bandRows) {
+        if (bandRows < 0)
+            throw std::invalid_argument("The number of rows per band must be positive.");
+        this->bandRows = bandRows;
+    }
+
+    /**
+     * Gets the number of rows of a band. By default, a band and its halo fit in BAND_BYTES in both local buffers,
+     * while keeping the halo small next to the band.
+     *
+     * @param depth Generations per step
+     * @return Rows per band
+     */
+    int HighPerformanceGrid::getBandRows(const int depth) const {
+        if (bandRows > 0)
+            return bandRows;
+        const auto fitting = static_cast<int>(BAND_BYTES / (2 * sizeof(uint64_t) * std::max(wordsPerRow, 1))) - 2 * depth;
+        return std::max(fitting, 4 * depth);
+    }
+
+    /**
+     * Steps the grid to the next generation.
+     */
+    void HighPerformanceGrid::step() {
+        step(false, false);
+    }
+
+    /**
+     * Steps the grid to the next generation.
+     *
+     * @param wrap If true, the grid will wrap around the edges. This will disable dynamic resizing.
+     */
+    void HighPerformanceGrid::step(const bool wrap) {
+        step(wrap, false);
+    }
+
+    /**
+     * Moves a block of cells from one position to another.
+     *
+     * @param fromRow The starting row
+     * @param fromCol The starting column
+     * @param numRows The number of rows to move
+     * @param numCols The number of columns to move
+     * @param toRow The row to move the block to
+     * @param toCol The column to move the block to
+     */
+    void HighPerformanceGrid::move(const int fromRow, const int fromCol, const int numRows, const int numCols,
+        const int toRow, const int toCol) {
+        // Extract the submatrix and clear the original location
+        std::vector submatrix(numRows, std::vector<bool>(numCols));
+        for (int i = 0; i < numRows; ++i) {
+            for (int j = 0; j < numCols; ++j) {
+                submatrix[i][j] = isAlive(fromRow + i, fromCol + j);
+                setAlive(fromRow + i, fromCol + j, false);
+            }
+        }
+
+        // Insert the submatrix at the new location
+        for (int i = 0; i < numRows; ++i) {
+            for (int j = 0; j < numCols; ++j) {
+                setAlive(toRow + i, toCol + j, submatrix[i][j]);
+                markChanged(toRow + i, toCol + j);
+            }
+        }
+    }
+
+    /**
+     * Resizes the grid by adding rows and columns to the north, east, south, and west.
+     *
+     * @param addNorth Number of rows to add to the north
+     * @param addEast Number of columns to add to the east
+     * @param addSouth Number of rows to add to the south
+     * @param addWest Number of columns to add to the west
+     */
+    void HighPerformanceGrid::resize(const int addNorth, const int addEast, const int addSouth, const int addWest) {
+        // Argument check
+        if (addNorth < 0 || addEast < 0 || addSouth < 0 || addWest < 0) {
+            throw std::invalid_argument("The number of rows and columns to add must be positive.");
+        }
+
+        // Check against the maximum size
+        if (rows + addNorth + addSouth > maxRows || cols + addEast + addWest > maxCols) {
+            return;
+        }
+        if (addNorth == 0 && addEast == 0 && addSouth == 0 && addWest == 0) {
+            return;
+        }
+
+        const int newRows = rows + addNorth + addSouth;
+        const int newCols = cols + addEast + addWest;
+        const int newWordsPerRow = (newCols + 63) / 64;
+        std::vector<uint64_t> resized(static_cast<size_t>(newRows) * newWordsPerRow);
+
+        // Copy each row, shifting its bits by the number of columns added to the west
+        const int wordShift = addWest / 64;
+        const int bitShift = addWest % 64;
+        for (int i = 0; i < rows; i++) {
+            const uint64_t *source = &cells[static_cast<size_t>(i) * wordsPerRow];
+            uint64_t *destination = &resized[static_cast<size_t>(i + addNorth) * newWordsPerRow];
+            for (int w = 0; w < wordsPerRow; w++) {
+                destination[w + wordShift] |= source[w] << bitShift;
+                if (bitShift != 0 && w + wordShift + 1 < newWordsPerRow)
+                    destination[w + wordShift + 1] |= source[w] >> (64 - bitShift);
+            }
+        }
+
+        rows = newRows;
+        cols = newCols;
+        wordsPerRow = newWordsPerRow;
+        cells = std::move(resized);
+        next.assign(cells.size(), 0);
+        changed = cells;
+    }
+
+    /**
+     * Inserts a pattern into the grid.
+     *
+     * @param cells The pattern to insert
+     * @param row The row to insert the pattern at
+     * @param col The column to insert the pattern at
+     * @param hollow If true, only the living cells will be inserted
+     */
+    void HighPerformanceGrid::insert(const std::vector<std::vector<bool>> &cells, const int row, const int col, const bool hollow) {
+        // Argument check
+        if (row < 0 || row >= rows || col < 0 || col >= cols) {
+            throw std::invalid_argument("The row and column must be within the grid.");
+        }
+
+        // Check against the maximum size
+        if (row + static_cast<int>(cells.size()) > maxRows || col + static_cast<int>(cells[0].size()) > maxCols) {
+            return;
+        }
+
+        // Insert the cells that fit in the grid
+        for (int i = 0; i < static_cast<int>(cells.size()) && row + i < rows; ++i) {
+            for (int j = 0; j < static_cast<int>(cells[i].size()) && col + j < cols; ++j) {
+                if (!hollow || cells[i][j]) {
+                    setAlive(row + i, col + j, cells[i][j]);
+                    markChanged(row + i, col + j);
+                }
+            }
+        }
+    }
+
+    /**
+     * Randomizes the grid with the specified probability of a cell being alive.
+     *
+     * @param aliveProbability Probability of a cell being alive
+     */
+    void HighPerformanceGrid::randomize(const float aliveProbability) {
+        randomize(aliveProbability, static_cast<uint64_t>(rand()));
+    }
+
+    /**
+     * Randomizes the grid with the specified probability of a cell being alive, 64 cells at a time.
+     * A cell only depends on the seed and its position, so the same seed always gives the same grid.
+     *
+     * @param aliveProbability Probability of a cell being alive
+     * @param seed Seed
+     */
+    void HighPerformanceGrid::randomize(const float aliveProbability, const uint64_t seed) {
+        if (aliveProbability < 0 || aliveProbability > 1)
+            return;
+        const uint32_t threshold = Random::threshold(aliveProbability);
+        parallelFor(rows, [&](const size_t begin, const size_t end, int) {
+            thread_local std::vector<uint64_t> drawn;
+            drawn.resize(wordsPerRow);
+            for (size_t i = begin; i < end; i++) {
+                Random::bernoulliRow(drawn.data(), cols, threshold, seed, 0, static_cast<uint32_t>(i),
+                    Random::Stream::RANDOMIZE);
+                for (int w = 0; w < wordsPerRow; w++) {
+                    const size_t index = i * wordsPerRow + w;
+                    changed[index] |= drawn[w] & ~cells[index];
+                    cells[index] |= drawn[w];
+                }
+            }
+        });
+    }
+
+    /**
+     * Enables the stochastic mode: each birth and each survival of the rule only happens with its probability.
+     * Probabilities of 1 go back to the deterministic rule.
+     *
+     * @param birthProbability Probability of a birth
+     * @param survivalProbability Probability of a survival
+     * @param seed Seed of the run
+     */
+    void HighPerformanceGrid::setStochastic(const float birthProbability, const float survivalProbability,
+        const uint64_t seed) {
+        birthThreshold = Random::threshold(birthProbability);
+        survivalThreshold = Random::threshold(survivalProbability);
+        this->seed = seed;
+    }
+
+    /**
+     * Clears the grid.
+     */
+    void HighPerformanceGrid::clear() {
+        for (size_t w = 0; w < cells.size(); w++) {
+            changed[w] |= cells[w];
+        }
+        std::fill(cells.begin(), cells.end(), 0);
+        std::fill(next.begin(), next.end(), 0);
+    }
+
+    /**
+     * Prints the grid to the console.
+     */
+    void HighPerformanceGrid::print() const {
+        print(0, 0, rows, cols);
+    }
+
+    /**
+     * Prints a section of the grid to the console.
+     *
+     * @param fromRow The starting row
+     * @param fromCol The starting column
+     * @param toRow The ending row
+     * @param toCol The ending column
+     */
+    void HighPerformanceGrid::print(const int fromRow, const int fromCol, const int toRow, const int toCol) const {
+        for (int i = fromRow; i < toRow; i++) {
+            for (int j = fromCol; j < toCol; j++) {
+                std::cout << (isAlive(i, j) ? 'O' : '.') << ' ';
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    /**
+     * Gets the cells as a 2D vector.
+     *
+     * @return Unpacked cells
+     */
+    std::vector<std::vector<bool>> HighPerformanceGrid::getCells() const {
+        std::vector unpacked(rows, std::vector<bool>(cols));
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                unpacked[i][j] = isAlive(i, j);
+            }
+        }
+        return unpacked;
+    }
+
+    /**
+     * Gets the coordinates of the living cells.
+     *
+     * @return Set of living cells
+     */
+    CoordinateSet HighPerformanceGrid::getLivingCells() const {
+        CoordinateSet livingCells;
+        for (size_t w = 0; w < cells.size(); w++) {
+            for (uint64_t word = cells[w]; word != 0; word &= word - 1) {
+                livingCells.emplace(w / wordsPerRow, (w % wordsPerRow) * 64 + std::countr_zero(word));
+            }
+        }
+        return livingCells;
+    }
+
+    /**
+     * Gets the coordinates of the cells that changed during the last generation.
+     *
+     * @return Set of changed cells
+     */
+    CoordinateSet HighPerformanceGrid::getChangedCells() const {
+        CoordinateSet changedCells;
+        for (size_t w = 0; w < changed.size(); w++) {
+            for (uint64_t word = changed[w]; word != 0; word &= word - 1) {
+                changedCells.emplace(w / wordsPerRow, (w % wordsPerRow) * 64 + std::countr_zero(word));
+            }
+        }
+        return changedCells;
+    }
+
+    /**
+     * Gets the number of living cells.
+     *
+     * @return Number of living cells
+     */
+    size_t HighPerformanceGrid::getPopulation() const {
+        size_t population = 0;
+        for (const uint64_t word : cells) {
+            population += std::popcount(word);
+        }
+        return population;
+    }
+
+    /**
+     * IWritable implementation.
+     * Gets the grid as a string.
+     *
+     * @return The grid as a string
+     */
+    std::string HighPerformanceGrid::getText() const {
+        std::stringstream ss;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                ss << (isAlive(i, j) ? formatConfig.getAliveChar() : formatConfig.getDeadChar()) << formatConfig.getDelimiterChar();
+            }
+            ss << '\n';
+        }
+        return ss.str();
+    }
+}
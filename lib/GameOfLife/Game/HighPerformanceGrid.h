@@ -0,0 +1,117 @@
+#ifndef HIGHPERFORMANCEGRID_H
+#define HIGHPERFORMANCEGRID_H
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "BaseGrid.h"
+#include "Grid.h"
+#include "CoordinateSet.h"
+#include "Random.h"
+#include "Rules.h"
+#include "ThreadPool.h"
+#include "File/FormatConfig.h"
+
+namespace GameOfLife::Game {
+    /**
+     * Bit-packed implementation of a grid, one bit per cell stored in contiguous 64-bit words.
+     * The next generation is computed with bitwise adders by the StepKernel, 64 cells or more at a time.
+     * In stochastic mode, births and survivals only happen with a given probability, drawn from a counter-based
+     * generator keyed by the seed, the generation and the cell, so a run does not depend on the number of threads.
+     * With temporal blocking, a step advances several generations: each band of rows is copied with a halo of one row
+     * per generation, and advanced while it stays in cache.
+     */
+    class HighPerformanceGrid : public BaseGrid<std::vector<std::vector<bool>>, bool> {
+    private:
+        std::vector<uint64_t> cells;
+        std::vector<uint64_t> next;
+        std::vector<uint64_t> changed;
+        int rows;
+        int cols;
+        int maxRows;
+        int maxCols;
+        int wordsPerRow;
+
+        std::shared_ptr<ThreadPool> pool;
+        int multiThreadedThreshold = 100000;
+        IsotropicRule rule;
+        bool isDynamic;
+
+        uint64_t generation = 0;
+        uint64_t seed = 0;
+        uint32_t birthThreshold = Random::ONE;
+        uint32_t survivalThreshold = Random::ONE;
+
+        // Generations per step, 0 to pick it from the grid size, and rows per band, 0 to fit a band with its halo in
+        // BAND_BYTES in both local buffers
+        int blockDepth = 1;
+        int bandRows = 0;
+        static constexpr size_t BAND_BYTES = 256 << 10;
+        static constexpr int AUTO_BLOCK_DEPTH = 8;
+
+        File::FormatConfig formatConfig = File::FormatConfig('O', '.', '\0');
+
+        void markChanged(int row, int col);
+        void parallelFor(size_t count, const ThreadPool::Task &task);
+        void stepRow(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out, int row,
+            uint64_t generation, bool wrap, uint64_t *births, uint64_t *survivals) const;
+        void blockedStep(bool wrap, int depth);
+
+    public:
+        HighPerformanceGrid() = delete;
+        HighPerformanceGrid(int rows, int cols, int maxRows = DEFAULT_MAX_ROWS, int maxCols = DEFAULT_MAX_COLS, bool isDynamic = true);
+        HighPerformanceGrid(const std::vector<std::vector<bool>> &cells, int rows, int cols, int maxRows = DEFAULT_MAX_ROWS,
+            int maxCols = DEFAULT_MAX_COLS, bool isDynamic = true);
+        ~HighPerformanceGrid() override = default;
+
+        void setAlive(int row, int col, bool alive) override;
+        [[nodiscard]] bool isAlive(int row, int col) const override;
+        [[nodiscard]] int countNeighbors(int row, int col, bool wrap) const override;
+
+        void step() override;
+        void step(bool wrap) override;
+        void step(bool wrap, bool dynamic = true);
+        void randomize(float aliveProbability) override;
+        void randomize(float aliveProbability, uint64_t seed);
+        void clear() override;
+
+        void move(int fromRow, int fromCol, int numRows, int numCols, int toRow, int toCol);
+        void resize(int addNorth, int addEast, int addSouth, int addWest);
+        void insert(const std::vector<std::vector<bool>> &cells, int row, int col, bool hollow = false);
+
+        void print() const override;
+        void print(int fromRow, int fromCol, int toRow, int toCol) const override;
+
+        [[nodiscard]] std::vector<std::vector<bool>> getCells() const override;
+
+        [[nodiscard]] int getRows() const override { return rows; }
+        [[nodiscard]] int getCols() const override { return cols; }
+
+        [[nodiscard]] int getMaxRows() const { return maxRows; }
+        [[nodiscard]] int getMaxCols() const { return maxCols; }
+
+        [[nodiscard]] CoordinateSet getLivingCells() const;
+        [[nodiscard]] CoordinateSet getChangedCells() const;
+        [[nodiscard]] size_t getPopulation() const;
+
+        void setRule(const IsotropicRule &rule) { this->rule = rule; }
+        [[nodiscard]] const IsotropicRule &getRule() const { return rule; }
+
+        void setStochastic(float birthProbability, float survivalProbability, uint64_t seed);
+        [[nodiscard]] bool isStochastic() const { return birthThreshold != Random::ONE || survivalThreshold != Random::ONE; }
+        [[nodiscard]] uint64_t getGeneration() const { return generation; }
+
+        void setBlockDepth(int blockDepth);
+        [[nodiscard]] int getBlockDepth() const { return blockDepth; }
+        [[nodiscard]] int getEffectiveBlockDepth() const;
+        void setBandRows(int bandRows);
+        [[nodiscard]] int getBandRows(int depth) const;
+
+        void setFormatConfig(const File::FormatConfig &formatConfig) { this->formatConfig = formatConfig; }
+        [[nodiscard]] File::FormatConfig getFormatConfig() const { return formatConfig; }
+
+        [[nodiscard]] std::string getText() const override;
+    };
+}
+
+#endif //HIGHPERFORMANCEGRID_H
@@ -0,0 +1,494 @@
+#include "LargerThanLifeGrid.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace GameOfLife::Game {
+    /**
+     * Constructs a grid with the specified number of rows and columns.
+     *
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param maxRows Maximum number of rows
+     * @param maxCols Maximum number of columns
+     * @param isDynamic Enable dynamic resizing
+     */
+    LargerThanLifeGrid::LargerThanLifeGrid(const int rows, const int cols, const int maxRows, const int maxCols, const bool isDynamic) :
+    rows(rows), cols(cols), maxRows(maxRows), maxCols(maxCols), isDynamic(isDynamic) {
+        cells.resize(static_cast<size_t>(rows) * cols);
+        next.resize(cells.size());
+        changed.resize(cells.size());
+    }
+
+    /**
+     * Constructs a grid from existing cells.
+     *
+     * @param cells Cells to copy
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param maxRows Maximum number of rows
+     * @param maxCols Maximum number of columns
+     * @param isDynamic Enable dynamic resizing
+     */
+    LargerThanLifeGrid::LargerThanLifeGrid(const std::vector<std::vector<bool>> &cells, const int rows, const int cols,
+        const int maxRows, const int maxCols, const bool isDynamic) :
+    LargerThanLifeGrid(rows, cols, maxRows, maxCols, isDynamic) {
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                this->cells[static_cast<size_t>(i) * cols + j] = cells[i][j];
+            }
+        }
+
+        changed = this->cells;
+    }
+
+    /**
+     * Sets the cell at the specified row and column to be alive or dead.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param alive Alive status
+     */
+    void LargerThanLifeGrid::setAlive(const int row, const int col, const bool alive) {
+        uint8_t &cell = cells[static_cast<size_t>(row) * cols + col];
+        if (cell != alive)
+            changed[static_cast<size_t>(row) * cols + col] = 1;
+        cell = alive;
+    }
+
+    /**
+     * Checks if the cell at the specified row and column is alive.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @return True if the cell is alive, false otherwise
+     */
+    bool LargerThanLifeGrid::isAlive(const int row, const int col) const {
+        return cells[static_cast<size_t>(row) * cols + col];
+    }
+
+    /**
+     * Counts the living cells in the neighbourhood of the rule around the cell at the specified row and column, the
+     * cell itself included if the rule counts it. This visits the whole neighbourhood, the step uses the tables instead.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param wrap Whether the grid should wrap around the edges
+     * @return Number of living cells
+     */
+    int LargerThanLifeGrid::countNeighbors(const int row, const int col, const bool wrap) const {
+        const int range = rule.getRange();
+        int count = 0;
+
+        for (int i = row - range; i <= row + range; i++) {
+            // Width of the diamond on this row
+            const int width = rule.getNeighborhood() == LargerThanLifeRule::Neighborhood::MOORE ? range : range - std::abs(i - row);
+            for (int j = col - width; j <= col + width; j++) {
+                if (i == row && j == col && !rule.isMiddleIncluded()) {
+                    continue;
+                }
+
+                const int wrappedRow = wrap ? ((i % rows) + rows) % rows : i;
+                const int wrappedCol = wrap ? ((j % cols) + cols) % cols : j;
+
+                if (wrappedRow >= 0 && wrappedRow < rows && wrappedCol >= 0 && wrappedCol < cols) {
+                    count += isAlive(wrappedRow, wrappedCol);
+                }
+            }
+        }
+
+        return count;
+    }
+
+    /**
+     * Runs a task over [0, count), in parallel bands if the grid is large enough.
+     *
+     * @param count Number of items
+     * @param task Task to run on each band
+     */
+    void LargerThanLifeGrid::parallelFor(const size_t count, const ThreadPool::Task &task) {
+        if (static_cast<size_t>(rows) * cols <= static_cast<size_t>(multiThreadedThreshold)) {
+            task(0, count, 0);
+            return;
+        }
+
+        if (!pool)
+            pool = std::make_shared<ThreadPool>();
+        const int workers = pool->getWorkerCount();
+        pool->parallelFor(count, (count + workers - 1) / workers, task);
+    }
+
+    /**
+     * Builds the padded grid and its prefix sums.
+     * The summed-area table is built by rows, each row summing its own cells, then by columns, each column adding the
+     * rows above. The diagonal sums are built by bands of diagonals, which do not depend on each other.
+     *
+     * @param wrap If true, the padding is read from the opposite edges, else it is dead
+     */
+    void LargerThanLifeGrid::buildTables(const bool wrap) {
+        const int range = rule.getRange();
+        const int height = rows + 2 * range;
+        const int width = cols + 2 * range;
+
+        padded.resize(static_cast<size_t>(height) * width);
+        sums.assign(static_cast<size_t>(height + 1) * (width + 1), 0);
+
+        // Pad each row, then sum its cells
+        parallelFor(height, [&](const size_t begin, const size_t end, int) {
+            for (int y = static_cast<int>(begin); y < static_cast<int>(end); y++) {
+                uint8_t *row = &padded[static_cast<size_t>(y) * width];
+                const int i = wrap ? ((y - range) % rows + rows) % rows : y - range;
+                if (i < 0 || i >= rows)
+                    std::fill(row, row + width, 0);
+                else {
+                    const uint8_t *source = &cells[static_cast<size_t>(i) * cols];
+                    for (int x = 0; x < width; x++) {
+                        const int j = wrap ? ((x - range) % cols + cols) % cols : x - range;
+                        row[x] = j >= 0 && j < cols ? source[j] : 0;
+                    }
+                }
+
+                uint32_t *sum = &sums[static_cast<size_t>(y + 1) * (width + 1)];
+                for (int x = 0; x < width; x++) {
+                    sum[x + 1] = sum[x] + row[x];
+                }
+            }
+        });
+
+        // Add the rows above to each column
+        parallelFor(width, [&](const size_t begin, const size_t end, int) {
+            for (int y = 1; y <= height; y++) {
+                uint32_t *sum = &sums[static_cast<size_t>(y) * (width + 1)];
+                const uint32_t *above = sum - (width + 1);
+                for (size_t x = begin + 1; x <= end; x++) {
+                    sum[x] += above[x];
+                }
+            }
+        });
+
+        if (rule.getNeighborhood() != LargerThanLifeRule::Neighborhood::VON_NEUMANN)
+            return;
+
+        // Sum each diagonal (x - y constant) and anti-diagonal (x + y constant) from the top, after a row of zeros
+        diagonals.assign(static_cast<size_t>(height + 1) * width, 0);
+        antiDiagonals.assign(diagonals.size(), 0);
+        parallelFor(static_cast<size_t>(height) + width - 1, [&](const size_t begin, const size_t end, int) {
+            for (int y = 0; y < height; y++) {
+                const uint8_t *row = &padded[static_cast<size_t>(y) * width];
+                uint32_t *diagonal = &diagonals[static_cast<size_t>(y + 1) * width];
+                uint32_t *antiDiagonal = &antiDiagonals[static_cast<size_t>(y + 1) * width];
+
+                // Diagonal x - y = k - (height - 1)
+                const int diagonalBegin = std::max(0, static_cast<int>(begin) - (height - 1) + y);
+                const int diagonalEnd = std::min(width, static_cast<int>(end) - (height - 1) + y);
+                for (int x = diagonalBegin; x < diagonalEnd; x++) {
+                    diagonal[x] = row[x] + (x > 0 ? diagonal[x - 1 - width] : 0);
+                }
+
+                // Anti-diagonal x + y = k
+                const int antiBegin = std::max(0, static_cast<int>(begin) - y);
+                const int antiEnd = std::min(width, static_cast<int>(end) - y);
+                for (int x = antiBegin; x < antiEnd; x++) {
+                    antiDiagonal[x] = row[x] + (x + 1 < width ? antiDiagonal[x + 1 - width] : 0);
+                }
+            }
+        });
+    }
+
+    /**
+     * Steps a band of rows into the next generation, and records the changed cells.
+     *
+     * @param begin First row
+     * @param end Row after the last one
+     */
+    void LargerThanLifeGrid::stepRows(const int begin, const int end) {
+        const int range = rule.getRange();
+        const int width = cols + 2 * range;
+        const bool middle = rule.isMiddleIncluded();
+
+        // Sum of the padded cells in [y0, y1) x [x0, x1)
+        const auto box = [&](const int y0, const int x0, const int y1, const int x1) {
+            return sums[static_cast<size_t>(y1) * (width + 1) + x1] - sums[static_cast<size_t>(y0) * (width + 1) + x1] -
+                sums[static_cast<size_t>(y1) * (width + 1) + x0] + sums[static_cast<size_t>(y0) * (width + 1) + x0];
+        };
+        // Sums from the top down to (y, x) included, y = -1 being the row of zeros
+        const auto diagonal = [&](const int y, const int x) { return diagonals[static_cast<size_t>(y + 1) * width + x]; };
+        const auto antiDiagonal = [&](const int y, const int x) { return antiDiagonals[static_cast<size_t>(y + 1) * width + x]; };
+
+        for (int i = begin; i < end; i++) {
+            const uint8_t *row = &cells[static_cast<size_t>(i) * cols];
+            uint8_t *nextRow = &next[static_cast<size_t>(i) * cols];
+            uint8_t *changedRow = &changed[static_cast<size_t>(i) * cols];
+
+            if (rule.getNeighborhood() == LargerThanLifeRule::Neighborhood::MOORE) {
+                // The square around (i, j) is [i, i + 2 * range] x [j, j + 2 * range] in the padded grid
+                for (int j = 0; j < cols; j++) {
+                    const int count = static_cast<int>(box(i, j, i + 2 * range + 1, j + 2 * range + 1)) - (middle ? 0 : row[j]);
+                    nextRow[j] = rule.next(row[j], count);
+                    changedRow[j] = nextRow[j] != row[j];
+                }
+                continue;
+            }
+
+            // The first diamond of the row is summed line by line
+            const int y = i + range;
+            int x = range;
+            uint32_t count = 0;
+            for (int dy = -range; dy <= range; dy++) {
+                const int half = range - std::abs(dy);
+                count += box(y + dy, x - half, y + dy + 1, x + half + 1);
+            }
+
+            // Then it slides right, gaining its two right edges and losing its two left edges
+            for (int j = 0; j < cols; j++, x++) {
+                nextRow[j] = rule.next(row[j], static_cast<int>(count) - (middle ? 0 : row[j]));
+                changedRow[j] = nextRow[j] != row[j];
+                if (j + 1 == cols)
+                    break;
+
+                count += diagonal(y, x + range + 1) - diagonal(y - range - 1, x) +
+                    antiDiagonal(y + range, x + 1) - antiDiagonal(y, x + range + 1);
+                count -= antiDiagonal(y, x - range) - antiDiagonal(y - range - 1, x + 1) +
+                    diagonal(y + range, x) - diagonal(y, x - range);
+            }
+        }
+    }
+
+    /**
+     * Steps the grid to the next generation.
+     *
+     * @param wrap If true, the grid will wrap around the edges. This will disable dynamic resizing.
+     * @param dynamic If true, the grid will resize if a living cell is within range of the edge (overrides isDynamic property).
+     */
+    void LargerThanLifeGrid::step(const bool wrap, const bool dynamic) {
+        // Check if the grid should be resized, a pattern can grow by the range on each generation
+        const int range = rule.getRange();
+        if (isDynamic && !wrap && dynamic) {
+            bool nearNorth = false, nearEast = false, nearSouth = false, nearWest = false;
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    if (!isAlive(i, j))
+                        continue;
+                    nearNorth |= i < range;
+                    nearSouth |= i >= rows - range;
+                    nearWest |= j < range;
+                    nearEast |= j >= cols - range;
+                }
+            }
+            resize(nearNorth ? range : 0, nearEast ? range : 0, nearSouth ? range : 0, nearWest ? range : 0);
+        }
+
+        buildTables(wrap);
+        parallelFor(rows, [&](const size_t begin, const size_t end, int) {
+            stepRows(static_cast<int>(begin), static_cast<int>(end));
+        });
+
+        std::swap(cells, next);
+    }
+
+    /**
+     * Steps the grid to the next generation.
+     */
+    void LargerThanLifeGrid::step() {
+        step(false, false);
+    }
+
+    /**
+     * Steps the grid to the next generation.
+     *
+     * @param wrap If true, the grid will wrap around the edges. This will disable dynamic resizing.
+     */
+    void LargerThanLifeGrid::step(const bool wrap) {
+        step(wrap, false);
+    }
+
+    /**
+     * Resizes the grid by adding rows and columns to the north, east, south, and west.
+     *
+     * @param addNorth Number of rows to add to the north
+     * @param addEast Number of columns to add to the east
+     * @param addSouth Number of rows to add to the south
+     * @param addWest Number of columns to add to the west
+     */
+    void LargerThanLifeGrid::resize(const int addNorth, const int addEast, const int addSouth, const int addWest) {
+        // Argument check
+        if (addNorth < 0 || addEast < 0 || addSouth < 0 || addWest < 0) {
+            throw std::invalid_argument("The number of rows and columns to add must be positive.");
+        }
+
+        // Check against the maximum size
+        if (rows + addNorth + addSouth > maxRows || cols + addEast + addWest > maxCols) {
+            return;
+        }
+        if (addNorth == 0 && addEast == 0 && addSouth == 0 && addWest == 0) {
+            return;
+        }
+
+        const int newRows = rows + addNorth + addSouth;
+        const int newCols = cols + addEast + addWest;
+        std::vector<uint8_t> resized(static_cast<size_t>(newRows) * newCols);
+        for (int i = 0; i < rows; i++) {
+            std::copy_n(&cells[static_cast<size_t>(i) * cols], cols,
+                &resized[static_cast<size_t>(i + addNorth) * newCols + addWest]);
+        }
+
+        rows = newRows;
+        cols = newCols;
+        cells = std::move(resized);
+        next.assign(cells.size(), 0);
+        changed = cells;
+    }
+
+    /**
+     * Inserts a pattern into the grid.
+     *
+     * @param cells The pattern to insert
+     * @param row The row to insert the pattern at
+     * @param col The column to insert the pattern at
+     * @param hollow If true, only the living cells will be inserted
+     */
+    void LargerThanLifeGrid::insert(const std::vector<std::vector<bool>> &cells, const int row, const int col, const bool hollow) {
+        // Argument check
+        if (row < 0 || row >= rows || col < 0 || col >= cols) {
+            throw std::invalid_argument("The row and column must be within the grid.");
+        }
+
+        // Check against the maximum size
+        if (row + cells.size() > maxRows || col + cells[0].size() > maxCols) {
+            return;
+        }
+
+        // Insert the cells that fit in the grid
+        for (int i = 0; i < cells.size() && row + i < rows; ++i) {
+            for (int j = 0; j < cells[i].size() && col + j < cols; ++j) {
+                if (!hollow || cells[i][j]) {
+                    setAlive(row + i, col + j, cells[i][j]);
+                    changed[static_cast<size_t>(row + i) * this->cols + col + j] = 1;
+                }
+            }
+        }
+    }
+
+    /**
+     * Randomizes the grid with the specified probability of a cell being alive.
+     *
+     * @param aliveProbability Probability of a cell being alive
+     */
+    void LargerThanLifeGrid::randomize(const float aliveProbability) {
+        if (aliveProbability < 0 || aliveProbability > 1)
+            return;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                if ((rand() % 100) < aliveProbability * 100)
+                    setAlive(i, j, true);
+            }
+        }
+    }
+
+    /**
+     * Clears the grid.
+     */
+    void LargerThanLifeGrid::clear() {
+        for (size_t k = 0; k < cells.size(); k++) {
+            changed[k] |= cells[k];
+        }
+        std::fill(cells.begin(), cells.end(), 0);
+        std::fill(next.begin(), next.end(), 0);
+    }
+
+    /**
+     * Prints the grid to the console.
+     */
+    void LargerThanLifeGrid::print() const {
+        print(0, 0, rows, cols);
+    }
+
+    /**
+     * Prints a section of the grid to the console.
+     *
+     * @param fromRow The starting row
+     * @param fromCol The starting column
+     * @param toRow The ending row
+     * @param toCol The ending column
+     */
+    void LargerThanLifeGrid::print(const int fromRow, const int fromCol, const int toRow, const int toCol) const {
+        for (int i = fromRow; i < toRow; i++) {
+            for (int j = fromCol; j < toCol; j++) {
+                std::cout << (isAlive(i, j) ? 'O' : '.') << ' ';
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    /**
+     * Gets the cells as a 2D vector.
+     *
+     * @return Cells
+     */
+    std::vector<std::vector<bool>> LargerThanLifeGrid::getCells() const {
+        std::vector result(rows, std::vector<bool>(cols));
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                result[i][j] = isAlive(i, j);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Gets the coordinates of the living cells.
+     *
+     * @return Set of living cells
+     */
+    CoordinateSet LargerThanLifeGrid::getLivingCells() const {
+        CoordinateSet livingCells;
+        for (size_t k = 0; k < cells.size(); k++) {
+            if (cells[k])
+                livingCells.emplace(k / cols, k % cols);
+        }
+        return livingCells;
+    }
+
+    /**
+     * Gets the coordinates of the cells that changed during the last generation.
+     *
+     * @return Set of changed cells
+     */
+    CoordinateSet LargerThanLifeGrid::getChangedCells() const {
+        CoordinateSet changedCells;
+        for (size_t k = 0; k < changed.size(); k++) {
+            if (changed[k])
+                changedCells.emplace(k / cols, k % cols);
+        }
+        return changedCells;
+    }
+
+    /**
+     * Gets the number of living cells.
+     *
+     * @return Number of living cells
+     */
+    size_t LargerThanLifeGrid::getPopulation() const {
+        return std::count(cells.begin(), cells.end(), 1);
+    }
+
+    /**
+     * IWritable implementation.
+     * Gets the grid as a string.
+     *
+     * @return The grid as a string
+     */
+    std::string LargerThanLifeGrid::getText() const {
+        std::stringstream ss;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                ss << (isAlive(i, j) ? formatConfig.getAliveChar() : formatConfig.getDeadChar()) << formatConfig.getDelimiterChar();
+            }
+            ss << '\n';
+        }
+        return ss.str();
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef LARGERTHANLIFEGRID_H
+#define LARGERTHANLIFEGRID_H
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "BaseGrid.h"
+#include "CoordinateSet.h"
+#include "Rules.h"
+#include "ThreadPool.h"
+#include "File/FormatConfig.h"
+
+
+namespace GameOfLife::Game {
+    /**
+     * Grid for Larger than Life rules, where each cell counts the living cells within a range of up to 500 cells.
+     * Each generation builds a summed-area table of the grid padded by the range, so the count of the square
+     * neighbourhood is four lookups whatever the range. The diamond neighbourhood slides along each row, and its four
+     * edges are read from prefix sums along the diagonals and anti-diagonals.
+     * The tables and the next generation are built in parallel bands on large grids.
+     */
+    class LargerThanLifeGrid : public BaseGrid<std::vector<std::vector<bool>>, bool> {
+    private:
+        std::vector<uint8_t> cells;
+        std::vector<uint8_t> next;
+        std::vector<uint8_t> changed;
+
+        // Grid padded by the range on each side, and its prefix sums
+        std::vector<uint8_t> padded;
+        std::vector<uint32_t> sums;
+        std::vector<uint32_t> diagonals;
+        std::vector<uint32_t> antiDiagonals;
+
+        int rows;
+        int cols;
+        int maxRows;
+        int maxCols;
+
+        std::shared_ptr<ThreadPool> pool;
+        int multiThreadedThreshold = 100000;
+        LargerThanLifeRule rule;
+        bool isDynamic;
+
+        File::FormatConfig formatConfig = File::FormatConfig('O', '.', '\0');
+
+        void parallelFor(size_t count, const ThreadPool::Task &task);
+        void buildTables(bool wrap);
+        void stepRows(int begin, int end);
+
+    public:
+        LargerThanLifeGrid() = delete;
+        LargerThanLifeGrid(int rows, int cols, int maxRows = 1000, int maxCols = 1000, bool isDynamic = true);
+        LargerThanLifeGrid(const std::vector<std::vector<bool>> &cells, int rows, int cols, int maxRows = 1000,
+            int maxCols = 1000, bool isDynamic = true);
+
+        void setAlive(int row, int col, bool alive) override;
+        [[nodiscard]] bool isAlive(int row, int col) const override;
+        [[nodiscard]] int countNeighbors(int row, int col, bool wrap) const override;
+
+        void step() override;
+        void step(bool wrap) override;
+        void step(bool wrap, bool dynamic);
+        void randomize(float aliveProbability) override;
+        void clear() override;
+
+        void resize(int addNorth, int addEast, int addSouth, int addWest);
+        void insert(const std::vector<std::vector<bool>> &cells, int row, int col, bool hollow = false);
+
+        void print() const override;
+        void print(int fromRow, int fromCol, int toRow, int toCol) const override;
+
+        [[nodiscard]] std::vector<std::vector<bool>> getCells() const override;
+
+        [[nodiscard]] int getRows() const override { return rows; }
+        [[nodiscard]] int getCols() const override { return cols; }
+
+        [[nodiscard]] int getMaxRows() const { return maxRows; }
+        [[nodiscard]] int getMaxCols() const { return maxCols; }
+
+        [[nodiscard]] CoordinateSet getLivingCells() const;
+        [[nodiscard]] CoordinateSet getChangedCells() const;
+        [[nodiscard]] size_t getPopulation() const;
+
+        void setRule(const LargerThanLifeRule &rule) { this->rule = rule; }
+        [[nodiscard]] const LargerThanLifeRule &getRule() const { return rule; }
+
+        void setFormatConfig(const File::FormatConfig &formatConfig) { this->formatConfig = formatConfig; }
+        [[nodiscard]] File::FormatConfig getFormatConfig() const { return formatConfig; }
+
+        [[nodiscard]] std::string getText() const override;
+    };
+}
+
+
+#endif //LARGERTHANLIFEGRID_H
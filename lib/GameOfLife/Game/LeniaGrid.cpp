@@ -0,0 +1,649 @@
+#include "LeniaGrid.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+#include "Random.h"
+
+namespace GameOfLife::Game {
+    // Characters of the values, from dead to fully alive
+    static constexpr char ramp[] = ".-:=+*#%@";
+
+    /**
+     * Constructs a grid with the specified number of rows and columns.
+     *
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param maxRows Maximum number of rows
+     * @param maxCols Maximum number of columns
+     * @param isDynamic Enable dynamic resizing
+     */
+    LeniaGrid::LeniaGrid(const int rows, const int cols, const int maxRows, const int maxCols, const bool isDynamic) :
+    rows(rows), cols(cols), maxRows(maxRows), maxCols(maxCols), isDynamic(isDynamic) {
+        cells.resize(static_cast<size_t>(rows) * cols);
+        changed.resize(cells.size());
+    }
+
+    /**
+     * Constructs a grid from existing values.
+     *
+     * @param cells Values to copy, clamped to [0, 1]
+     * @param rows Number of rows
+     * @param cols Number of columns
+     * @param maxRows Maximum number of rows
+     * @param maxCols Maximum number of columns
+     * @param isDynamic Enable dynamic resizing
+     */
+    LeniaGrid::LeniaGrid(const std::vector<std::vector<float>> &cells, const int rows, const int cols,
+        const int maxRows, const int maxCols, const bool isDynamic) :
+    LeniaGrid(rows, cols, maxRows, maxCols, isDynamic) {
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                setValue(i, j, cells[i][j]);
+            }
+        }
+    }
+
+    /**
+     * Gets the 8-bit level of a value, as written in multi-state RLE and drawn by the GUI.
+     *
+     * @param value Value in [0, 1]
+     * @return Level in [0, 255]
+     */
+    uint8_t LeniaGrid::getLevel(const float value) {
+        return static_cast<uint8_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255));
+    }
+
+    /**
+     * Converts the levels of a multi-state pattern into values. A two-state pattern has its living cells fully alive,
+     * so Life patterns can seed Lenia; otherwise level 255 is a value of 1.
+     *
+     * @param levels Levels of the cells
+     * @return Values of the cells
+     */
+    std::vector<std::vector<float>> LeniaGrid::getValues(const std::vector<std::vector<uint8_t>> &levels) {
+        uint8_t highest = 0;
+        for (const auto &row : levels) {
+            for (const uint8_t level : row) {
+                highest = std::max(highest, level);
+            }
+        }
+        const float scale = highest <= 1 ? 1.0f : 1.0f / 255;
+
+        std::vector<std::vector<float>> values;
+        values.reserve(levels.size());
+        for (const auto &row : levels) {
+            auto &value = values.emplace_back(row.size());
+            std::transform(row.begin(), row.end(), value.begin(), [scale](const uint8_t level) { return level * scale; });
+        }
+        return values;
+    }
+
+    /**
+     * Sets the cell at the specified row and column to be fully alive (1) or dead (0).
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param alive Alive status
+     */
+    void LeniaGrid::setAlive(const int row, const int col, const bool alive) {
+        setValue(row, col, alive ? 1.0f : 0.0f);
+    }
+
+    /**
+     * Checks if the cell at the specified row and column has a positive value.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @return True if the cell is alive, false otherwise
+     */
+    bool LeniaGrid::isAlive(const int row, const int col) const {
+        return getValue(row, col) > 0;
+    }
+
+    /**
+     * Sets the value of the cell at the specified row and column.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param value Value, clamped to [0, 1]
+     */
+    void LeniaGrid::setValue(const int row, const int col, const float value) {
+        float &cell = cells[static_cast<size_t>(row) * cols + col];
+        const float clamped = std::clamp(value, 0.0f, 1.0f);
+        if (cell != clamped)
+            changed[static_cast<size_t>(row) * cols + col] = 1;
+        cell = clamped;
+    }
+
+    /**
+     * Counts the number of living neighbors around the cell at the specified row and column.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param wrap Whether the grid should wrap around the edges
+     * @return Number of living neighbors
+     */
+    int LeniaGrid::countNeighbors(const int row, const int col, const bool wrap) const {
+        int count = 0;
+
+        for (int i = row - 1; i <= row + 1; i++) {
+            for (int j = col - 1; j <= col + 1; j++) {
+                if (i == row && j == col) {
+                    continue;
+                }
+
+                const int wrappedRow = wrap ? (i + rows) % rows : i;
+                const int wrappedCol = wrap ? (j + cols) % cols : j;
+
+                if (wrappedRow >= 0 && wrappedRow < rows && wrappedCol >= 0 && wrappedCol < cols) {
+                    count += isAlive(wrappedRow, wrappedCol);
+                }
+            }
+        }
+
+        return count;
+    }
+
+    /**
+     * Runs a task over [0, count), in parallel bands if the grid is large enough.
+     *
+     * @param count Number of items
+     * @param task Task to run on each band
+     */
+    void LeniaGrid::parallelFor(const size_t count, const ThreadPool::Task &task) {
+        if (static_cast<size_t>(rows) * cols <= static_cast<size_t>(multiThreadedThreshold)) {
+            task(0, count, 0);
+            return;
+        }
+
+        if (!pool)
+            pool = std::make_shared<ThreadPool>();
+        const int workers = pool->getWorkerCount();
+        pool->parallelFor(count, (count + workers - 1) / workers, task);
+    }
+
+    /**
+     * Sizes the frame and its FFT plans, and computes the spectrum of the kernel if the frame or the rule changed.
+     * The frame holds the grid and a halo of the radius on each side, rounded up to powers of two, so the circular
+     * convolution of the FFT never folds one edge of the grid onto the other. A wrapped grid whose sides are powers of
+     * two is its own frame, the circular convolution being the toroidal one.
+     *
+     * @param wrap Whether the grid wraps around the edges
+     */
+    void LeniaGrid::preparePlan(const bool wrap) {
+        const int radius = rule.getRadius();
+        const bool exact = wrap && rows >= 2 && cols >= 2 && std::has_single_bit(static_cast<unsigned>(rows)) &&
+            std::has_single_bit(static_cast<unsigned>(cols));
+        const int newRows = exact ? rows : FFT::nextPowerOfTwo(rows + 2 * radius);
+        const int newCols = exact ? cols : FFT::nextPowerOfTwo(cols + 2 * radius);
+        if (newRows != frameRows || newCols != frameCols) {
+            frameRows = newRows;
+            frameCols = newCols;
+            rowPlan.emplace(frameCols);
+            colPlan.emplace(frameRows);
+            frame.assign(static_cast<size_t>(frameRows) * frameCols, 0);
+            spectrum.assign(static_cast<size_t>(frameRows) * (frameCols / 2 + 1), {});
+            kernelValid = false;
+        }
+        if (kernelValid)
+            return;
+
+        // Kernel centred on the origin of the frame, the negative offsets wrapped to the other end
+        std::fill(frame.begin(), frame.end(), 0.0f);
+        double total = 0;
+        for (int dy = -radius; dy <= radius; dy++) {
+            for (int dx = -radius; dx <= radius; dx++) {
+                const float weight = rule.kernel(std::sqrt(static_cast<float>(dy * dy + dx * dx)));
+                if (weight <= 0)
+                    continue;
+                const int y = ((dy % frameRows) + frameRows) % frameRows;
+                const int x = ((dx % frameCols) + frameCols) % frameCols;
+                frame[static_cast<size_t>(y) * frameCols + x] += weight;
+                total += weight;
+            }
+        }
+
+        // Normalize the kernel, and fold in the 1 / size of the inverse transforms
+        const double scale = total > 0 ? 1 / (total * frameRows * frameCols) : 0;
+        for (float &value : frame) {
+            value = static_cast<float>(value * scale);
+        }
+        forwardRows(frameRows);
+        convolveColumns(false);
+        kernelSpectrum = spectrum;
+        kernelValid = true;
+    }
+
+    /**
+     * Copies the grid to the frame, with the wrapped cells or zeros in the halo.
+     *
+     * @param wrap Whether the grid wraps around the edges
+     */
+    void LeniaGrid::fillFrame(const bool wrap) {
+        // Grid cell read by each frame cell, -1 for a zero. The north and west halos are at the end of the frame.
+        const auto source = [wrap](const int index, const int size, const int frameSize, const int radius) {
+            if (index < size)
+                return index;
+            if (!wrap)
+                return -1;
+            if (index < size + radius)
+                return index % size;
+            if (index >= frameSize - radius)
+                return ((index - frameSize) % size + size) % size;
+            return -1;
+        };
+        const int radius = rule.getRadius();
+        std::vector<int> colSources(frameCols);
+        for (int x = 0; x < frameCols; x++) {
+            colSources[x] = source(x, cols, frameCols, radius);
+        }
+
+        parallelFor(frameRows, [&](const size_t begin, const size_t end, int) {
+            for (size_t y = begin; y < end; y++) {
+                float *out = &frame[y * frameCols];
+                const int row = source(static_cast<int>(y), rows, frameRows, radius);
+                if (row < 0) {
+                    std::fill(out, out + frameCols, 0.0f);
+                    continue;
+                }
+                const float *in = &cells[static_cast<size_t>(row) * cols];
+                std::copy_n(in, cols, out);
+                for (int x = cols; x < frameCols; x++) {
+                    out[x] = colSources[x] < 0 ? 0 : in[colSources[x]];
+                }
+            }
+        });
+    }
+
+    /**
+     * Transforms the first rows of the frame to the spectrum, two real rows per complex transform.
+     *
+     * @param count Number of rows, even
+     */
+    void LeniaGrid::forwardRows(const int count) {
+        const size_t bins = frameCols / 2 + 1;
+        parallelFor(count / 2, [&](const size_t begin, const size_t end, int) {
+            thread_local std::vector<std::complex<float>> buffer;
+            buffer.resize(frameCols);
+            for (size_t pair = begin; pair < end; pair++) {
+                rowPlan->forwardReal(&frame[2 * pair * frameCols], &frame[(2 * pair + 1) * frameCols],
+                    &spectrum[2 * pair * bins], &spectrum[(2 * pair + 1) * bins], buffer.data());
+            }
+        });
+    }
+
+    /**
+     * Transforms the columns of the spectrum. If multiply is set, each column is multiplied by the spectrum of the
+     * kernel and transformed back, which completes the convolution but for the inverse row transforms.
+     *
+     * @param multiply Multiply by the kernel and transform back
+     */
+    void LeniaGrid::convolveColumns(const bool multiply) {
+        // Columns are gathered in blocks of adjacent bins, so each row of the spectrum is read one cache line at a time
+        constexpr size_t block = 8;
+        const size_t bins = frameCols / 2 + 1;
+        parallelFor((bins + block - 1) / block, [&](const size_t begin, const size_t end, int) {
+            thread_local std::vector<std::complex<float>> buffer;
+            buffer.resize(block * frameRows);
+            for (size_t first = begin * block; first < std::min(end * block, bins); first += block) {
+                const size_t width = std::min(block, bins - first);
+                for (int y = 0; y < frameRows; y++) {
+                    for (size_t b = 0; b < width; b++) {
+                        buffer[b * frameRows + y] = spectrum[y * bins + first + b];
+                    }
+                }
+                for (size_t b = 0; b < width; b++) {
+                    std::complex<float> *column = &buffer[b * frameRows];
+                    colPlan->transform(column, false);
+                    if (!multiply)
+                        continue;
+                    for (int y = 0; y < frameRows; y++) {
+                        const std::complex<float> a = column[y];
+                        const std::complex<float> k = kernelSpectrum[y * bins + first + b];
+                        column[y] = {a.real() * k.real() - a.imag() * k.imag(), a.real() * k.imag() + a.imag() * k.real()};
+                    }
+                    colPlan->transform(column, true);
+                }
+                for (int y = 0; y < frameRows; y++) {
+                    for (size_t b = 0; b < width; b++) {
+                        spectrum[y * bins + first + b] = buffer[b * frameRows + y];
+                    }
+                }
+            }
+        });
+    }
+
+    /**
+     * Transforms the first rows of the spectrum back to the frame.
+     *
+     * @param count Number of rows, even
+     */
+    void LeniaGrid::inverseRows(const int count) {
+        const size_t bins = frameCols / 2 + 1;
+        parallelFor(count / 2, [&](const size_t begin, const size_t end, int) {
+            thread_local std::vector<std::complex<float>> buffer;
+            buffer.resize(frameCols);
+            for (size_t pair = begin; pair < end; pair++) {
+                rowPlan->inverseReal(&spectrum[2 * pair * bins], &spectrum[(2 * pair + 1) * bins],
+                    &frame[2 * pair * frameCols], &frame[(2 * pair + 1) * frameCols], buffer.data());
+            }
+        });
+    }
+
+    /**
+     * Computes the potential of every cell, the weighted sum of its neighbourhood by the normalized kernel.
+     *
+     * @param wrap Whether the grid wraps around the edges
+     * @return Potential of each cell
+     */
+    std::vector<std::vector<float>> LeniaGrid::getPotential(const bool wrap) {
+        preparePlan(wrap);
+        fillFrame(wrap);
+        forwardRows(frameRows);
+        convolveColumns(true);
+        inverseRows(std::min(frameRows, rows + rows % 2));
+
+        std::vector<std::vector<float>> potential(rows);
+        for (int i = 0; i < rows; i++) {
+            potential[i].assign(&frame[static_cast<size_t>(i) * frameCols], &frame[static_cast<size_t>(i) * frameCols] + cols);
+        }
+        return potential;
+    }
+
+    /**
+     * Steps the grid to the next generation.
+     *
+     * @param wrap If true, the grid will wrap around the edges. This will disable dynamic resizing.
+     * @param dynamic If true, the grid will resize if a living cell is within the radius of an edge (overrides isDynamic property).
+     */
+    void LeniaGrid::step(const bool wrap, const bool dynamic) {
+        // Check if the grid should be resized, a cell within the radius of an edge reaches beyond it
+        if (isDynamic && !wrap && dynamic) {
+            const int radius = rule.getRadius();
+            bool nearNorth = false, nearEast = false, nearSouth = false, nearWest = false;
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    if (getValue(i, j) <= 0)
+                        continue;
+                    nearNorth |= i < radius;
+                    nearSouth |= i >= rows - radius;
+                    nearWest |= j < radius;
+                    nearEast |= j >= cols - radius;
+                }
+            }
+            resize(nearNorth ? radius : 0, nearEast ? radius : 0, nearSouth ? radius : 0, nearWest ? radius : 0);
+        }
+
+        preparePlan(wrap);
+        fillFrame(wrap);
+        forwardRows(frameRows);
+        convolveColumns(true);
+        inverseRows(std::min(frameRows, rows + rows % 2));
+
+        // Grow each cell by its potential, the GUI redraws the cells whose level changed
+        parallelFor(rows, [&](const size_t begin, const size_t end, int) {
+            for (size_t i = begin; i < end; i++) {
+                const float *potential = &frame[i * frameCols];
+                for (int j = 0; j < cols; j++) {
+                    float &cell = cells[i * cols + j];
+                    const float next = rule.next(cell, potential[j]);
+                    changed[i * cols + j] = getLevel(cell) != getLevel(next);
+                    cell = next;
+                }
+            }
+        });
+    }
+
+    /**
+     * Steps the grid to the next generation.
+     */
+    void LeniaGrid::step() {
+        step(false, false);
+    }
+
+    /**
+     * Steps the grid to the next generation.
+     *
+     * @param wrap If true, the grid will wrap around the edges. This will disable dynamic resizing.
+     */
+    void LeniaGrid::step(const bool wrap) {
+        step(wrap, false);
+    }
+
+    /**
+     * Resizes the grid by adding rows and columns to the north, east, south, and west.
+     *
+     * @param addNorth Number of rows to add to the north
+     * @param addEast Number of columns to add to the east
+     * @param addSouth Number of rows to add to the south
+     * @param addWest Number of columns to add to the west
+     */
+    void LeniaGrid::resize(const int addNorth, const int addEast, const int addSouth, const int addWest) {
+        // Argument check
+        if (addNorth < 0 || addEast < 0 || addSouth < 0 || addWest < 0) {
+            throw std::invalid_argument("The number of rows and columns to add must be positive.");
+        }
+
+        // Check against the maximum size
+        if (rows + addNorth + addSouth > maxRows || cols + addEast + addWest > maxCols) {
+            return;
+        }
+        if (addNorth == 0 && addEast == 0 && addSouth == 0 && addWest == 0) {
+            return;
+        }
+
+        const int newRows = rows + addNorth + addSouth;
+        const int newCols = cols + addEast + addWest;
+        std::vector<float> resized(static_cast<size_t>(newRows) * newCols);
+        for (int i = 0; i < rows; i++) {
+            std::copy_n(&cells[static_cast<size_t>(i) * cols], cols,
+                &resized[static_cast<size_t>(i + addNorth) * newCols + addWest]);
+        }
+
+        // The frame follows on the next step
+        rows = newRows;
+        cols = newCols;
+        cells = std::move(resized);
+        changed.assign(cells.size(), 0);
+        for (size_t k = 0; k < cells.size(); k++) {
+            changed[k] = cells[k] > 0;
+        }
+    }
+
+    /**
+     * Inserts a pattern into the grid.
+     *
+     * @param cells The values to insert
+     * @param row The row to insert the pattern at
+     * @param col The column to insert the pattern at
+     * @param hollow If true, only the positive values will be inserted
+     */
+    void LeniaGrid::insert(const std::vector<std::vector<float>> &cells, const int row, const int col, const bool hollow) {
+        // Argument check
+        if (row < 0 || row >= rows || col < 0 || col >= cols) {
+            throw std::invalid_argument("The row and column must be within the grid.");
+        }
+
+        // Check against the maximum size
+        if (row + cells.size() > maxRows || col + cells[0].size() > maxCols) {
+            return;
+        }
+
+        // Insert the cells that fit in the grid
+        for (int i = 0; i < cells.size() && row + i < rows; ++i) {
+            for (int j = 0; j < cells[i].size() && col + j < cols; ++j) {
+                if (!hollow || cells[i][j] > 0)
+                    setValue(row + i, col + j, cells[i][j]);
+            }
+        }
+    }
+
+    /**
+     * Randomizes the grid: each cell gets a random value with the specified probability.
+     *
+     * @param aliveProbability Probability of a cell being alive
+     */
+    void LeniaGrid::randomize(const float aliveProbability) {
+        randomize(aliveProbability, static_cast<uint64_t>(rand()));
+    }
+
+    /**
+     * Randomizes the grid: each cell gets a uniform value in (0, 1] with the specified probability.
+     * A cell only depends on the seed and its position, so the same seed always gives the same grid.
+     *
+     * @param aliveProbability Probability of a cell being alive
+     * @param seed Seed
+     */
+    void LeniaGrid::randomize(const float aliveProbability, const uint64_t seed) {
+        if (aliveProbability < 0 || aliveProbability > 1)
+            return;
+        const uint32_t threshold = Random::threshold(aliveProbability);
+        parallelFor(rows, [&](const size_t begin, const size_t end, int) {
+            for (size_t i = begin; i < end; i++) {
+                for (int j = 0; j < cols; j++) {
+                    const auto block = Random::philox({static_cast<uint32_t>(j), static_cast<uint32_t>(i), 0,
+                        static_cast<uint32_t>(Random::Stream::VALUE) << 8}, seed);
+                    if ((block[0] >> 16) >= threshold)
+                        continue;
+                    cells[i * cols + j] = static_cast<float>((block[1] >> 8) + 1) / (1 << 24);
+                    changed[i * cols + j] = 1;
+                }
+            }
+        });
+    }
+
+    /**
+     * Clears the grid.
+     */
+    void LeniaGrid::clear() {
+        for (size_t k = 0; k < cells.size(); k++) {
+            changed[k] |= cells[k] > 0;
+        }
+        std::fill(cells.begin(), cells.end(), 0.0f);
+    }
+
+    /**
+     * Prints the grid to the console.
+     */
+    void LeniaGrid::print() const {
+        print(0, 0, rows, cols);
+    }
+
+    /**
+     * Prints a section of the grid to the console.
+     *
+     * @param fromRow The starting row
+     * @param fromCol The starting column
+     * @param toRow The ending row
+     * @param toCol The ending column
+     */
+    void LeniaGrid::print(const int fromRow, const int fromCol, const int toRow, const int toCol) const {
+        for (int i = fromRow; i < toRow; i++) {
+            for (int j = fromCol; j < toCol; j++) {
+                const float value = getValue(i, j);
+                std::cout << ramp[value <= 0 ? 0 : 1 + std::min(7, static_cast<int>(value * 8))] << ' ';
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    /**
+     * Gets the values as a 2D vector.
+     *
+     * @return Values
+     */
+    std::vector<std::vector<float>> LeniaGrid::getCells() const {
+        std::vector<std::vector<float>> result(rows);
+        for (int i = 0; i < rows; i++) {
+            result[i].assign(&cells[static_cast<size_t>(i) * cols], &cells[static_cast<size_t>(i) * cols] + cols);
+        }
+        return result;
+    }
+
+    /**
+     * Gets the 8-bit levels of the values, the states of a multi-state RLE file.
+     *
+     * @return Levels
+     */
+    std::vector<std::vector<uint8_t>> LeniaGrid::getLevels() const {
+        std::vector result(rows, std::vector<uint8_t>(cols));
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                result[i][j] = getLevel(getValue(i, j));
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Gets the coordinates of the cells with a positive value.
+     *
+     * @return Set of living cells
+     */
+    CoordinateSet LeniaGrid::getLivingCells() const {
+        CoordinateSet livingCells;
+        for (size_t k = 0; k < cells.size(); k++) {
+            if (cells[k] > 0)
+                livingCells.emplace(k / cols, k % cols);
+        }
+        return livingCells;
+    }
+
+    /**
+     * Gets the coordinates of the cells whose level changed during the last generation.
+     *
+     * @return Set of changed cells
+     */
+    CoordinateSet LeniaGrid::getChangedCells() const {
+        CoordinateSet changedCells;
+        for (size_t k = 0; k < changed.size(); k++) {
+            if (changed[k])
+                changedCells.emplace(k / cols, k % cols);
+        }
+        return changedCells;
+    }
+
+    /**
+     * Gets the number of cells with a positive value.
+     *
+     * @return Number of living cells
+     */
+    size_t LeniaGrid::getPopulation() const {
+        return std::count_if(cells.begin(), cells.end(), [](const float value) { return value > 0; });
+    }
+
+    /**
+     * Gets the total mass of the grid, the sum of the values.
+     *
+     * @return Mass
+     */
+    double LeniaGrid::getMass() const {
+        return std::accumulate(cells.begin(), cells.end(), 0.0);
+    }
+
+    /**
+     * IWritable implementation.
+     * Gets the grid as a string, the dead cells with the dead character and the others by their value.
+     *
+     * @return The grid as a string
+     */
+    std::string LeniaGrid::getText() const {
+        std::stringstream ss;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                const float value = getValue(i, j);
+                ss << (value <= 0 ? formatConfig.getDeadChar() : ramp[1 + std::min(7, static_cast<int>(value * 8))])
+                    << formatConfig.getDelimiterChar();
+            }
+            ss << '\n';
+        }
+        return ss.str();
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef LENIAGRID_H
+#define LENIAGRID_H
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "BaseGrid.h"
+#include "CoordinateSet.h"
+#include "FFT.h"
+#include "Rules.h"
+#include "ThreadPool.h"
+#include "File/FormatConfig.h"
+
+
+namespace GameOfLife::Game {
+    /**
+     * Grid for Lenia, a continuous automaton where each cell is a real value in [0, 1].
+     * The potential of every cell, the convolution of the grid with the kernel of the rule, is computed with FFTs:
+     * the grid is copied in a frame with a halo of the radius (the wrapped cells, or zeros), transformed, multiplied by
+     * the spectrum of the kernel, and transformed back. The FFT plans and the kernel spectrum are kept until the frame
+     * or the rule changes, and the rows and columns are transformed in parallel on large grids.
+     */
+    class LeniaGrid : public BaseGrid<std::vector<std::vector<float>>, float> {
+    private:
+        std::vector<float> cells;
+        std::vector<uint8_t> changed;
+
+        // Frame of the convolution, its spectrum (frameCols / 2 + 1 bins per row) and the spectrum of the kernel
+        std::vector<float> frame;
+        std::vector<std::complex<float>> spectrum;
+        std::vector<std::complex<float>> kernelSpectrum;
+        std::optional<FFT> rowPlan;
+        std::optional<FFT> colPlan;
+        int frameRows = 0;
+        int frameCols = 0;
+        bool kernelValid = false;
+
+        int rows;
+        int cols;
+        int maxRows;
+        int maxCols;
+
+        std::shared_ptr<ThreadPool> pool;
+        int multiThreadedThreshold = 100000;
+        LeniaRule rule;
+        bool isDynamic;
+
+        File::FormatConfig formatConfig = File::FormatConfig('O', '.', '\0');
+
+        void parallelFor(size_t count, const ThreadPool::Task &task);
+        void preparePlan(bool wrap);
+        void fillFrame(bool wrap);
+        void forwardRows(int count);
+        void convolveColumns(bool multiply);
+        void inverseRows(int count);
+
+    public:
+        LeniaGrid() = delete;
+        LeniaGrid(int rows, int cols, int maxRows = 1000, int maxCols = 1000, bool isDynamic = true);
+        LeniaGrid(const std::vector<std::vector<float>> &cells, int rows, int cols, int maxRows = 1000,
+            int maxCols = 1000, bool isDynamic = true);
+
+        [[nodiscard]] static uint8_t getLevel(float value);
+        [[nodiscard]] static std::vector<std::vector<float>> getValues(const std::vector<std::vector<uint8_t>> &levels);
+
+        void setAlive(int row, int col, bool alive) override;
+        [[nodiscard]] bool isAlive(int row, int col) const override;
+        void setValue(int row, int col, float value);
+        [[nodiscard]] float getValue(int row, int col) const { return cells[static_cast<size_t>(row) * cols + col]; }
+        [[nodiscard]] int countNeighbors(int row, int col, bool wrap) const override;
+        [[nodiscard]] std::vector<std::vector<float>> getPotential(bool wrap);
+
+        void step() override;
+        void step(bool wrap) override;
+        void step(bool wrap, bool dynamic);
+        void randomize(float aliveProbability) override;
+        void randomize(float aliveProbability, uint64_t seed);
+        void clear() override;
+
+        void resize(int addNorth, int addEast, int addSouth, int addWest);
+        void insert(const std::vector<std::vector<float>> &cells, int row, int col, bool hollow = false);
+
+        void print() const override;
+        void print(int fromRow, int fromCol, int toRow, int toCol) const override;
+
+        [[nodiscard]] std::vector<std::vector<float>> getCells() const override;
+        [[nodiscard]] std::vector<std::vector<uint8_t>> getLevels() const;
+
+        [[nodiscard]] int getRows() const override { return rows; }
+        [[nodiscard]] int getCols() const override { return cols; }
+
+        [[nodiscard]] int getMaxRows() const { return maxRows; }
+        [[nodiscard]] int getMaxCols() const { return maxCols; }
+        [[nodiscard]] int getFrameRows() const { return frameRows; }
+        [[nodiscard]] int getFrameCols() const { return frameCols; }
+
+        [[nodiscard]] CoordinateSet getLivingCells() const;
+        [[nodiscard]] CoordinateSet getChangedCells() const;
+        [[nodiscard]] size_t getPopulation() const;
+        [[nodiscard]] double getMass() const;
+
+        void setRule(const LeniaRule &rule) { this->rule = rule; kernelValid = false; }
+        [[nodiscard]] const LeniaRule &getRule() const { return rule; }
+
+        void setFormatConfig(const File::FormatConfig &formatConfig) { this->formatConfig = formatConfig; }
+        [[nodiscard]] File::FormatConfig getFormatConfig() const { return formatConfig; }
+
+        [[nodiscard]] std::string getText() const override;
+    };
+}
+
+
+#endif //LENIAGRID_H
@@ -0,0 +1,65 @@
+#include "Random.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <vector>
+
+#include "StepKernel.h"
+
+namespace GameOfLife::Game {
+    /**
+     * Rounds a probability to the precision of the generator.
+     *
+     * @param probability Probability, clamped to [0, 1]
+     * @return Probability in units of 1 / ONE
+     */
+    uint32_t Random::threshold(const float probability) {
+        return static_cast<uint32_t>(std::lround(std::clamp(probability, 0.0f, 1.0f) * ONE));
+    }
+
+    /**
+     * Draws a packed row of cells, each one set with the given probability.
+     * The probability is built from its binary digits, from the lowest set one: each digit draws one random word, and
+     * ors it in if the digit is set, or ands it if not. A probability of k / 2^n costs n words, so 1/2 costs one.
+     *
+     * @param out Destination row, one bit per cell
+     * @param cols Number of columns, the bits after the last column are cleared
+     * @param threshold Probability in units of 1 / ONE
+     * @param seed Seed
+     * @param generation Generation the row is drawn for
+     * @param row Row
+     * @param stream Stream the row is drawn from
+     */
+    void Random::bernoulliRow(uint64_t *out, const int cols, const uint32_t threshold, const uint64_t seed,
+        const uint32_t generation, const uint32_t row, const Stream stream) {
+        const int words = (cols + 63) / 64;
+        if (words == 0)
+            return;
+        std::fill(out, out + words, threshold >= ONE ? ~uint64_t{0} : 0);
+
+        if (threshold != 0 && threshold < ONE) {
+            // Each block gives two random words per cell word
+            thread_local std::vector<uint64_t> low, high;
+            low.resize(words);
+            high.resize(words);
+            int pair = 0;
+            for (int digit = std::countr_zero(threshold); digit < 16; digit += 2, pair++) {
+                StepKernel::randomRow(low.data(), high.data(), words, row, generation,
+                    static_cast<uint32_t>(stream) << 8 | pair, seed);
+                const bool lowSet = threshold >> digit & 1;
+                const bool highSet = threshold >> (digit + 1) & 1;
+                const bool hasHigh = digit + 1 < 16;
+                for (int w = 0; w < words; w++) {
+                    uint64_t word = lowSet ? out[w] | low[w] : out[w] & low[w];
+                    if (hasHigh)
+                        word = highSet ? word | high[w] : word & high[w];
+                    out[w] = word;
+                }
+            }
+        }
+
+        if (cols % 64 != 0)
+            out[words - 1] &= (uint64_t{1} << (cols % 64)) - 1;
+    }
+}
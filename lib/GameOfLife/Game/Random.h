@@ -0,0 +1,54 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+#include <array>
+#include <cstdint>
+
+namespace GameOfLife::Game {
+    /**
+     * Counter-based random numbers (Philox4x32-10).
+     * Each block of 128 bits is a pure function of a seed and a counter made of the word, row, generation and stream
+     * it is drawn for, so the cells get the same numbers whatever the order, the thread or the kernel that draws them.
+     */
+    class Random {
+    public:
+        /**
+         * Independent sequences drawn from the same seed.
+         */
+        enum class Stream : uint32_t {
+            RANDOMIZE,
+            BIRTH,
+            SURVIVAL,
+            VALUE
+        };
+
+        // Probabilities are rounded to a multiple of 1 / ONE
+        static constexpr uint32_t ONE = 1 << 16;
+
+        /**
+         * Computes a Philox4x32-10 block.
+         *
+         * @param counter Counter
+         * @param key Key, the low word first
+         * @return Block of four random words
+         */
+        [[nodiscard]] static constexpr std::array<uint32_t, 4> philox(std::array<uint32_t, 4> counter, uint64_t key) {
+            auto k0 = static_cast<uint32_t>(key);
+            auto k1 = static_cast<uint32_t>(key >> 32);
+            for (int round = 0; round < 10; round++) {
+                const uint64_t product0 = static_cast<uint64_t>(0xD2511F53) * counter[0];
+                const uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57) * counter[2];
+                counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ k0, static_cast<uint32_t>(product1),
+                    static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ k1, static_cast<uint32_t>(product0)};
+                k0 += 0x9E3779B9;
+                k1 += 0xBB67AE85;
+            }
+            return counter;
+        }
+
+        [[nodiscard]] static uint32_t threshold(float probability);
+        static void bernoulliRow(uint64_t *out, int cols, uint32_t threshold, uint64_t seed, uint32_t generation,
+            uint32_t row, Stream stream);
+    };
+}
+
+#endif //RANDOM_H
@@ -0,0 +1,745 @@
+#include "Rules.h"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace GameOfLife::Game {
+    /**
+     * Birth and survival masks of the preset rules, in the order of the Rule enum.
+     */
+    static constexpr std::pair<uint16_t, uint16_t> presets[RULE_COUNT] = {
+        { Conway::birth, Conway::survival },
+        { HighLife::birth, HighLife::survival },
+        { Seeds::birth, Seeds::survival },
+        { DayAndNight::birth, DayAndNight::survival },
+        { LifeWithoutDeath::birth, LifeWithoutDeath::survival },
+        { Maze::birth, Maze::survival }
+    };
+
+    /**
+     * Names accepted for the preset rules, in the order of the Rule enum.
+     */
+    static constexpr const char *presetNames[RULE_COUNT] = {
+        "conway", "highlife", "seeds", "daynight", "lifewithoutdeath", "maze"
+    };
+
+    /**
+     * Hensel letters of each number of neighbors up to 4, in canonical order.
+     * The letters of n > 4 neighbors are the ones of the complementary configuration of 8 - n neighbors.
+     */
+    static constexpr const char *henselLetters[5] = {"", "ce", "ceaikn", "ceaiknjqry", "ceaiknjqrytwz"};
+
+    /**
+     * Neighbourhood of each Hensel letter, as a 9-bit index without the centre cell.
+     */
+    static constexpr int henselNeighborhoods[5][13] = {
+        {},
+        {1, 2},
+        {5, 10, 3, 40, 33, 68},
+        {69, 42, 11, 7, 98, 13, 14, 70, 41, 97},
+        {325, 170, 15, 45, 99, 71, 106, 102, 43, 101, 105, 78, 108}
+    };
+
+    // Every neighbor of the 3x3 block, without the centre cell
+    static constexpr int NEIGHBORS = 0x1EF;
+
+    /**
+     * Lowercases a rule and removes its whitespace and its Golly suffix.
+     *
+     * @param notation Rule notation
+     * @return Normalized notation
+     */
+    static std::string normalize(const std::string &notation) {
+        std::string rule;
+        for (const char c : notation.substr(0, notation.find(':'))) {
+            if (!std::isspace(static_cast<unsigned char>(c)))
+                rule += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return rule;
+    }
+
+    /**
+     * Gets the Hensel letter of every neighbourhood, by rotating and reflecting the neighbourhood of each letter.
+     *
+     * @return Letter of each 9-bit index without the centre cell, 0 for 0 and 8 neighbors
+     */
+    static const std::array<char, 512> &getLetters() {
+        static const auto letters = [] {
+            std::array<char, 512> result{};
+            for (int count = 1; count <= 4; count++) {
+                for (int l = 0; henselLetters[count][l] != '\0'; l++) {
+                    for (int symmetry = 0; symmetry < 8; symmetry++) {
+                        int index = 0;
+                        for (int bit = 0; bit < 9; bit++) {
+                            if (!(henselNeighborhoods[count][l] >> bit & 1))
+                                continue;
+                            int row = bit / 3, col = bit % 3;
+                            for (int rotation = 0; rotation < symmetry / 2; rotation++) {
+                                row = std::exchange(col, 2 - row);
+                            }
+                            if (symmetry % 2 == 1)
+                                col = 2 - col;
+                            index |= 1 << (row * 3 + col);
+                        }
+                        result[index] = henselLetters[count][l];
+                        if (count < 4)
+                            result[~index & NEIGHBORS] = henselLetters[count][l];
+                    }
+                }
+            }
+            return result;
+        }();
+        return letters;
+    }
+
+    /**
+     * Constructs a rule from its birth and survival masks.
+     *
+     * @param birth Birth mask, bit n set if a dead cell with n living neighbors is born
+     * @param survival Survival mask, bit n set if a living cell with n living neighbors survives
+     */
+    LifeLikeRule::LifeLikeRule(const uint16_t birth, const uint16_t survival) : birth(birth), survival(survival) {
+        if (birth >> 9 != 0 || survival >> 9 != 0)
+            throw std::invalid_argument("Neighbor counts must be between 0 and 8.");
+        // The engines only visit the cells around living cells, so empty space must stay empty
+        if (birth & 1)
+            throw std::invalid_argument("Rules with B0 are not supported.");
+
+        for (int n = 0; n <= 8; n++) {
+            table[0][n] = birth >> n & 1;
+            table[1][n] = survival >> n & 1;
+        }
+    }
+
+    /**
+     * Constructs a preset rule.
+     *
+     * @param preset Preset rule
+     */
+    LifeLikeRule::LifeLikeRule(const Rule preset) :
+    LifeLikeRule(presets[static_cast<int>(preset)].first, presets[static_cast<int>(preset)].second) {}
+
+    /**
+     * Parses a rule, in B/S notation (B3/S23, b3/s23, S23/B3), in S/B notation (23/3), or by preset name.
+     * Golly suffixes, such as a topology (B3/S23:T100,100), are ignored.
+     *
+     * @param notation Rule notation
+     * @return Parsed rule
+     */
+    LifeLikeRule LifeLikeRule::parse(const std::string &notation) {
+        const std::string rule = normalize(notation);
+
+        if (rule == "life")
+            return {Conway::birth, Conway::survival};
+        for (int i = 0; i < RULE_COUNT; i++) {
+            if (rule == presetNames[i])
+                return {static_cast<Rule>(i)};
+        }
+
+        const size_t slash = rule.find('/');
+        if (slash == std::string::npos || rule.find('/', slash + 1) != std::string::npos)
+            throw std::invalid_argument("Invalid rule: " + notation);
+
+        // Each part is a list of neighbor counts, prefixed by b or s, or in S/B order without prefixes
+        std::string parts[2] = {rule.substr(0, slash), rule.substr(slash + 1)};
+        uint16_t masks[2] = {0, 0};
+        const bool prefixed = (!parts[0].empty() && !std::isdigit(static_cast<unsigned char>(parts[0][0]))) ||
+            (!parts[1].empty() && !std::isdigit(static_cast<unsigned char>(parts[1][0])));
+        for (int i = 0; i < 2; i++) {
+            std::string &part = parts[i];
+            int target = i == 0 ? 1 : 0;
+            if (prefixed) {
+                if (part.empty() || (part[0] != 'b' && part[0] != 's'))
+                    throw std::invalid_argument("Invalid rule: " + notation);
+                target = part[0] == 'b' ? 0 : 1;
+                part.erase(0, 1);
+            }
+            for (const char c : part) {
+                if (c < '0' || c > '8')
+                    throw std::invalid_argument("Invalid rule: " + notation);
+                masks[target] |= 1 << (c - '0');
+            }
+        }
+        if (prefixed && (parts[0].empty() && parts[1].empty()))
+            throw std::invalid_argument("Invalid rule: " + notation);
+
+        return {masks[0], masks[1]};
+    }
+
+    /**
+     * Gets the preset matching this rule, if any.
+     *
+     * @return Preset rule, or nothing
+     */
+    std::optional<Rule> LifeLikeRule::getPreset() const {
+        for (int i = 0; i < RULE_COUNT; i++) {
+            if (presets[i].first == birth && presets[i].second == survival)
+                return static_cast<Rule>(i);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Gets the rule in normalized B/S notation.
+     *
+     * @return Rule notation, such as B3/S23
+     */
+    std::string LifeLikeRule::toString() const {
+        std::string result = "B";
+        for (int n = 0; n <= 8; n++) {
+            if (birth >> n & 1)
+                result += static_cast<char>('0' + n);
+        }
+        result += "/S";
+        for (int n = 0; n <= 8; n++) {
+            if (survival >> n & 1)
+                result += static_cast<char>('0' + n);
+        }
+        return result;
+    }
+
+    /**
+     * Constructs the isotropic form of an outer-totalistic rule.
+     *
+     * @param rule Outer-totalistic rule
+     */
+    IsotropicRule::IsotropicRule(const LifeLikeRule &rule) : totalistic(rule) {
+        for (int index = 0; index < 512; index++) {
+            if (rule.next(index >> 4 & 1, std::popcount(static_cast<unsigned>(index & NEIGHBORS))))
+                table[index >> 6] |= uint64_t{1} << (index & 63);
+        }
+        compile();
+    }
+
+    /**
+     * Constructs a rule from its table, keeping its outer-totalistic form if it has one.
+     *
+     * @param table Next state of each neighbourhood
+     */
+    IsotropicRule::IsotropicRule(const std::array<uint64_t, 8> &table) : table(table) {
+        // Outer-totalistic if all the neighbourhoods with the same state and count share their next state
+        uint16_t masks[2] = {0, 0};
+        uint16_t seen[2] = {0, 0};
+        bool uniform = true;
+        for (int index = 0; index < 512; index++) {
+            const int alive = index >> 4 & 1;
+            const int count = std::popcount(static_cast<unsigned>(index & NEIGHBORS));
+            if (seen[alive] >> count & 1)
+                uniform &= (masks[alive] >> count & 1) == next(index);
+            seen[alive] |= 1 << count;
+            masks[alive] |= next(index) << count;
+        }
+        if (uniform)
+            totalistic = LifeLikeRule(masks[0], masks[1]);
+        compile();
+    }
+
+    /**
+     * Parses a rule in Hensel notation, such as B2n3/S23-q, or any notation accepted by LifeLikeRule::parse.
+     * A number of neighbors followed by letters only includes these configurations, followed by a minus sign
+     * and letters it includes all the other ones.
+     *
+     * @param notation Rule notation
+     * @return Parsed rule
+     */
+    IsotropicRule IsotropicRule::parse(const std::string &notation) {
+        try {
+            return LifeLikeRule::parse(notation);
+        } catch (const std::invalid_argument &) {
+            // Not outer-totalistic, try the Hensel notation
+        }
+
+        const std::string rule = normalize(notation);
+        const size_t slash = rule.find('/');
+        if (slash == std::string::npos || rule.find('/', slash + 1) != std::string::npos)
+            throw std::invalid_argument("Invalid rule: " + notation);
+
+        const std::string parts[2] = {rule.substr(0, slash), rule.substr(slash + 1)};
+        if (parts[0].empty() || parts[1].empty() || (parts[0][0] != 'b' && parts[0][0] != 's') ||
+            (parts[1][0] != 'b' && parts[1][0] != 's') || parts[0][0] == parts[1][0])
+            throw std::invalid_argument("Invalid rule: " + notation);
+
+        const auto &letters = getLetters();
+        std::array<uint64_t, 8> table{};
+        for (const auto &part : parts) {
+            const int centre = part[0] == 's' ? 16 : 0;
+            size_t i = 1;
+            while (i < part.size()) {
+                if (part[i] < '0' || part[i] > '8')
+                    throw std::invalid_argument("Invalid rule: " + notation);
+                const int count = part[i++] - '0';
+
+                const bool negate = i < part.size() && part[i] == '-';
+                i += negate;
+                std::string selected;
+                while (i < part.size() && std::isalpha(static_cast<unsigned char>(part[i]))) {
+                    if (std::string(henselLetters[std::min(count, 8 - count)]).find(part[i]) == std::string::npos)
+                        throw std::invalid_argument("Invalid rule: " + notation);
+                    selected += part[i++];
+                }
+                if (negate && selected.empty())
+                    throw std::invalid_argument("Invalid rule: " + notation);
+
+                for (int index = 0; index < 512; index++) {
+                    if (index & 16 || std::popcount(static_cast<unsigned>(index)) != count)
+                        continue;
+                    if (selected.empty() || (selected.find(letters[index]) != std::string::npos) != negate)
+                        table[(index | centre) >> 6] |= uint64_t{1} << ((index | centre) & 63);
+                }
+            }
+        }
+        if (table[0] & 1)
+            throw std::invalid_argument("Rules with B0 are not supported.");
+
+        return IsotropicRule(table);
+    }
+
+    /**
+     * Compiles the table to a reduced decision diagram, merging the neighbourhood bits one at a time.
+     * Both halves of a table that do not depend on a bit collapse to a single node, and equal nodes are shared.
+     * The centre is merged first, then the corners and the edges, which keeps the diagrams of isotropic rules
+     * about a third smaller than the reading order.
+     */
+    void IsotropicRule::compile() {
+        static constexpr int order[9] = {4, 0, 2, 6, 8, 1, 3, 5, 7};
+
+        circuit.clear();
+        std::unordered_map<uint64_t, uint16_t> nodes;
+        std::vector<uint16_t> level(512);
+        for (int position = 0; position < 512; position++) {
+            int index = 0;
+            for (int bit = 0; bit < 9; bit++) {
+                index |= (position >> bit & 1) << order[bit];
+            }
+            level[position] = next(index);
+        }
+
+        for (const int input : order) {
+            std::vector<uint16_t> upper(level.size() / 2);
+            for (size_t i = 0; i < upper.size(); i++) {
+                const uint16_t low = level[2 * i], high = level[2 * i + 1];
+                if (low == high) {
+                    upper[i] = low;
+                    continue;
+                }
+                const uint64_t key = static_cast<uint64_t>(input) << 32 | static_cast<uint64_t>(low) << 16 | high;
+                const auto [it, inserted] = nodes.emplace(key, circuit.size() + 2);
+                if (inserted)
+                    circuit.push_back({static_cast<uint8_t>(input), low, high});
+                upper[i] = it->second;
+            }
+            level = std::move(upper);
+        }
+    }
+
+    /**
+     * Gets the rule in canonical notation, B/S for outer-totalistic rules and Hensel notation otherwise.
+     * Each number of neighbors lists its letters, or the letters it excludes when that is shorter.
+     *
+     * @return Rule notation, such as B2n3/S23-q
+     */
+    std::string IsotropicRule::toString() const {
+        if (totalistic)
+            return totalistic->toString();
+
+        std::string result;
+        for (const int centre : {0, 16}) {
+            result += centre ? "/S" : "B";
+            for (int count = 0; count <= 8; count++) {
+                const int half = std::min(count, 8 - count);
+                if (half == 0) {
+                    if (next((count == 0 ? 0 : NEIGHBORS) | centre))
+                        result += static_cast<char>('0' + count);
+                    continue;
+                }
+
+                std::string present, missing;
+                for (int l = 0; henselLetters[half][l] != '\0'; l++) {
+                    const int index = count <= 4 ? henselNeighborhoods[half][l] : ~henselNeighborhoods[half][l] & NEIGHBORS;
+                    (next(index | centre) ? present : missing) += henselLetters[half][l];
+                }
+                if (present.empty())
+                    continue;
+                result += static_cast<char>('0' + count);
+                if (missing.empty())
+                    continue;
+                result += present.size() <= missing.size() ? present : "-" + missing;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Parses a non-negative integer of a Larger than Life rule.
+     *
+     * @param text Digits
+     * @param notation Whole rule notation, for the error message
+     * @return Parsed integer
+     */
+    static int parseNumber(const std::string &text, const std::string &notation) {
+        if (text.empty() || text.size() > 6 || !std::all_of(text.begin(), text.end(), [](const char c) { return std::isdigit(static_cast<unsigned char>(c)); }))
+            throw std::invalid_argument("Invalid rule: " + notation);
+        return std::stoi(text);
+    }
+
+    /**
+     * Parses an interval of a Larger than Life rule, min..max or a single count.
+     *
+     * @param text Interval
+     * @param notation Whole rule notation, for the error message
+     * @return Bounds of the interval
+     */
+    static std::pair<int, int> parseInterval(const std::string &text, const std::string &notation) {
+        const size_t dots = text.find("..");
+        if (dots == std::string::npos) {
+            const int count = parseNumber(text, notation);
+            return {count, count};
+        }
+        return {parseNumber(text.substr(0, dots), notation), parseNumber(text.substr(dots + 2), notation)};
+    }
+
+    /**
+     * Constructs a Larger than Life rule.
+     *
+     * @param range Range of the neighbourhood
+     * @param middle Whether the cell counts itself
+     * @param survivalMin Lowest count for a living cell to survive
+     * @param survivalMax Highest count for a living cell to survive
+     * @param birthMin Lowest count for a dead cell to be born
+     * @param birthMax Highest count for a dead cell to be born
+     * @param neighborhood Shape of the neighbourhood
+     */
+    LargerThanLifeRule::LargerThanLifeRule(const int range, const bool middle, const int survivalMin, const int survivalMax,
+        const int birthMin, const int birthMax, const Neighborhood neighborhood) :
+    range(range), middle(middle), survivalMin(survivalMin), survivalMax(survivalMax), birthMin(birthMin), birthMax(birthMax),
+    neighborhood(neighborhood) {
+        if (range < 1 || range > MAX_RANGE)
+            throw std::invalid_argument("The range must be between 1 and " + std::to_string(MAX_RANGE) + ".");
+        const int size = getNeighborhoodSize();
+        if (survivalMin > survivalMax || birthMin > birthMax || survivalMax > size || birthMax > size)
+            throw std::invalid_argument("Neighbor counts must be ordered intervals within the neighbourhood.");
+        // Same restriction as the other engines: empty space must stay empty
+        if (birthMin == 0)
+            throw std::invalid_argument("Rules with B0 are not supported.");
+    }
+
+    /**
+     * Parses a rule in Larger than Life notation: R<range>,C<states>,M<0|1>,S<min>..<max>,B<min>..<max>,N<M|N>.
+     * C, M and N are optional, and default to 2 states, M0 and the Moore neighbourhood.
+     * Golly suffixes, such as a topology (R5,C0,M1,S34..58,B34..45,NM:T500,500), are ignored.
+     *
+     * @param notation Rule notation
+     * @return Parsed rule
+     */
+    LargerThanLifeRule LargerThanLifeRule::parse(const std::string &notation) {
+        const std::string rule = normalize(notation);
+
+        std::optional<int> range;
+        std::optional<std::pair<int, int>> survival, birth;
+        std::optional<bool> middle;
+        std::optional<Neighborhood> neighborhood;
+        std::optional<int> states;
+        size_t begin = 0;
+        while (begin <= rule.size()) {
+            const size_t end = std::min(rule.find(',', begin), rule.size());
+            const std::string token = rule.substr(begin, end - begin);
+            begin = end + 1;
+
+            if (token.empty())
+                throw std::invalid_argument("Invalid rule: " + notation);
+            const std::string value = token.substr(1);
+            if (token[0] == 'r' && !range)
+                range = parseNumber(value, notation);
+            else if (token[0] == 'c' && !states)
+                states = parseNumber(value, notation);
+            else if (token[0] == 'm' && !middle && (value == "0" || value == "1"))
+                middle = value == "1";
+            else if (token[0] == 's' && !survival)
+                survival = parseInterval(value, notation);
+            else if (token[0] == 'b' && !birth)
+                birth = parseInterval(value, notation);
+            else if (token[0] == 'n' && !neighborhood && (value == "m" || value == "n"))
+                neighborhood = value == "m" ? Neighborhood::MOORE : Neighborhood::VON_NEUMANN;
+            else
+                throw std::invalid_argument("Invalid rule: " + notation);
+        }
+        if (!range || !survival || !birth)
+            throw std::invalid_argument("Invalid rule: " + notation);
+        // C0 and C2 both mean two states, more states are Generations rules
+        if (states && *states != 0 && *states != 2)
+            throw std::invalid_argument("Larger than Life rules with more than 2 states are not supported.");
+
+        return {*range, middle.value_or(false), survival->first, survival->second, birth->first, birth->second,
+            neighborhood.value_or(Neighborhood::MOORE)};
+    }
+
+    /**
+     * Gets the number of cells in the neighbourhood, the centre cell included if it is counted.
+     *
+     * @return Number of cells
+     */
+    int LargerThanLifeRule::getNeighborhoodSize() const {
+        const int cells = neighborhood == Neighborhood::MOORE ? (2 * range + 1) * (2 * range + 1) : 2 * range * (range + 1) + 1;
+        return middle ? cells : cells - 1;
+    }
+
+    /**
+     * Gets the rule in canonical Larger than Life notation.
+     *
+     * @return Rule notation, such as R5,C0,M1,S34..58,B34..45,NM
+     */
+    std::string LargerThanLifeRule::toString() const {
+        return "R" + std::to_string(range) + ",C0,M" + (middle ? "1" : "0") +
+            ",S" + std::to_string(survivalMin) + ".." + std::to_string(survivalMax) +
+            ",B" + std::to_string(birthMin) + ".." + std::to_string(birthMax) +
+            ",N" + (neighborhood == Neighborhood::MOORE ? "M" : "N");
+    }
+
+    /**
+     * Names accepted for some Generations rules.
+     */
+    static const std::pair<const char *, const char *> generationsNames[] = {
+        {"briansbrain", "B2/S/C3"},
+        {"starwars", "B2/S345/C4"}
+    };
+
+    /**
+     * Constructs a Generations rule.
+     *
+     * @param lifeLike Birth and survival of the living state
+     * @param states Number of states, 2 being the rule itself without decay
+     */
+    GenerationsRule::GenerationsRule(const LifeLikeRule &lifeLike, const int states) :
+    lifeLike(lifeLike), states(states), history(false) {
+        if (states < 2 || states > MAX_STATES)
+            throw std::invalid_argument("The number of states must be between 2 and " + std::to_string(MAX_STATES) + ".");
+    }
+
+    /**
+     * Gets the LifeHistory rule.
+     *
+     * @return LifeHistory
+     */
+    GenerationsRule GenerationsRule::lifeHistory() {
+        GenerationsRule rule({}, 7);
+        rule.history = true;
+        return rule;
+    }
+
+    /**
+     * Parses a multi-state rule: LifeHistory, a Generations rule in B/S/C notation (B2/S/C3, B2/S345/G4), in S/B/C
+     * notation (/2/3, 345/2/4), or by name (briansbrain, starwars). Two-state rules in B/S notation are accepted as well.
+     *
+     * @param notation Rule notation
+     * @return Parsed rule
+     */
+    GenerationsRule GenerationsRule::parse(const std::string &notation) {
+        const std::string rule = normalize(notation);
+        if (rule == "lifehistory")
+            return lifeHistory();
+        for (const auto &[name, named] : generationsNames) {
+            if (rule == name)
+                return parse(named);
+        }
+
+        const size_t last = rule.rfind('/');
+        if (last == std::string::npos || rule.find('/') == last)
+            return {LifeLikeRule::parse(rule), 2};
+
+        // The number of states is the last part, prefixed by c or g, or the third number without prefixes
+        std::string count = rule.substr(last + 1);
+        if (!count.empty() && (count[0] == 'c' || count[0] == 'g'))
+            count.erase(0, 1);
+        if (count.empty() || count.size() > 3 || !std::all_of(count.begin(), count.end(), [](const char c) { return std::isdigit(static_cast<unsigned char>(c)); }))
+            throw std::invalid_argument("Invalid rule: " + notation);
+        return {LifeLikeRule::parse(rule.substr(0, last)), std::stoi(count)};
+    }
+
+    /**
+     * Gets the next state of a cell.
+     *
+     * @param state State of the cell
+     * @param neighbors Number of living neighbors
+     * @return Next state
+     */
+    uint8_t GenerationsRule::next(const uint8_t state, const int neighbors) const {
+        const bool alive = isAlive(state);
+        const bool nextAlive = lifeLike.next(alive, neighbors);
+        if (history) {
+            if (alive)
+                return nextAlive ? state : state + 1;
+            return nextAlive ? (state == 4 ? 3 : 1) : state;
+        }
+        if (state == 0)
+            return nextAlive;
+        if (state == 1 && nextAlive)
+            return 1;
+        return state + 1 == states ? 0 : state + 1;
+    }
+
+    /**
+     * Gets the rule in normalized notation.
+     *
+     * @return Rule notation, such as B2/S/C3, B3/S23 for two states, or LifeHistory
+     */
+    std::string GenerationsRule::toString() const {
+        if (history)
+            return "LifeHistory";
+        return states == 2 ? lifeLike.toString() : lifeLike.toString() + "/C" + std::to_string(states);
+    }
+
+    /**
+     * Constructs a Lenia rule.
+     *
+     * @param radius Radius of the kernel, in cells
+     * @param timeScale Number of steps per unit of time, each step adds G(u) / T
+     * @param mu Centre of the growth function
+     * @param sigma Width of the growth function
+     * @param peaks Height of each ring of the kernel, from the centre
+     */
+    LeniaRule::LeniaRule(const int radius, const int timeScale, const float mu, const float sigma, std::vector<float> peaks) :
+    radius(radius), timeScale(timeScale), mu(mu), sigma(sigma), peaks(std::move(peaks)) {
+        if (radius < 1 || radius > MAX_RADIUS)
+            throw std::invalid_argument("The radius must be between 1 and " + std::to_string(MAX_RADIUS) + ".");
+        if (timeScale < 1)
+            throw std::invalid_argument("The time scale must be positive.");
+        if (!(mu >= 0 && mu <= 1) || !(sigma > 0 && sigma <= 1))
+            throw std::invalid_argument("The growth centre must be in [0, 1] and its width in (0, 1].");
+        if (this->peaks.empty() || this->peaks.size() > MAX_PEAKS ||
+            !std::all_of(this->peaks.begin(), this->peaks.end(), [](const float peak) { return peak >= 0 && peak <= 1; }) ||
+            std::all_of(this->peaks.begin(), this->peaks.end(), [](const float peak) { return peak == 0; }))
+            throw std::invalid_argument("The kernel needs 1 to " + std::to_string(MAX_PEAKS) + " peaks in [0, 1], one of them positive.");
+    }
+
+    /**
+     * Parses a real number of a Lenia rule, in decimal or as a fraction (1/3).
+     *
+     * @param text Number
+     * @param notation Whole rule notation, for the error message
+     * @return Parsed number
+     */
+    static float parseReal(const std::string &text, const std::string &notation) {
+        const size_t slash = text.find('/');
+        if (slash != std::string::npos && text.find('/', slash + 1) == std::string::npos)
+            return parseReal(text.substr(0, slash), notation) / parseReal(text.substr(slash + 1), notation);
+        if (text.empty() || !std::all_of(text.begin(), text.end(), [](const char c) { return std::isdigit(static_cast<unsigned char>(c)) || c == '.'; }))
+            throw std::invalid_argument("Invalid rule: " + notation);
+        try {
+            size_t end;
+            const float value = std::stof(text, &end);
+            if (end == text.size())
+                return value;
+        } catch (const std::logic_error &) {}
+        throw std::invalid_argument("Invalid rule: " + notation);
+    }
+
+    /**
+     * Parses a rule in Lenia notation: R=<radius>;T=<time scale>;m=<mu>;s=<sigma>;b=<peaks>, the peaks separated by
+     * commas (b=1,1/3). T and b are optional, and default to 10 and a single ring. "lenia" is Orbium's rule.
+     *
+     * @param notation Rule notation
+     * @return Parsed rule
+     */
+    LeniaRule LeniaRule::parse(const std::string &notation) {
+        const std::string rule = normalize(notation);
+        if (rule == "lenia")
+            return {};
+
+        std::optional<int> radius, timeScale;
+        std::optional<float> mu, sigma;
+        std::optional<std::vector<float>> peaks;
+        size_t begin = 0;
+        while (begin <= rule.size()) {
+            const size_t end = std::min(rule.find(';', begin), rule.size());
+            const std::string token = rule.substr(begin, end - begin);
+            begin = end + 1;
+
+            if (token.size() < 3 || token[1] != '=')
+                throw std::invalid_argument("Invalid rule: " + notation);
+            const std::string value = token.substr(2);
+            if (token[0] == 'r' && !radius)
+                radius = parseNumber(value, notation);
+            else if (token[0] == 't' && !timeScale)
+                timeScale = parseNumber(value, notation);
+            else if (token[0] == 'm' && !mu)
+                mu = parseReal(value, notation);
+            else if (token[0] == 's' && !sigma)
+                sigma = parseReal(value, notation);
+            else if (token[0] == 'b' && !peaks) {
+                peaks.emplace();
+                size_t peakBegin = 0;
+                while (peakBegin <= value.size()) {
+                    const size_t peakEnd = std::min(value.find(',', peakBegin), value.size());
+                    peaks->push_back(parseReal(value.substr(peakBegin, peakEnd - peakBegin), notation));
+                    peakBegin = peakEnd + 1;
+                }
+            }
+            else
+                throw std::invalid_argument("Invalid rule: " + notation);
+        }
+        if (!radius || !mu || !sigma)
+            throw std::invalid_argument("Invalid rule: " + notation);
+
+        return {*radius, timeScale.value_or(10), *mu, *sigma, peaks.value_or(std::vector<float>{1})};
+    }
+
+    /**
+     * Gets the weight of a cell in the kernel, before normalization.
+     * The kernel is made of one ring per peak, each ring shaped by the smooth bump exp(4 - 1 / (r (1 - r))).
+     *
+     * @param distance Distance to the centre, in cells
+     * @return Weight of the cell
+     */
+    float LeniaRule::kernel(const float distance) const {
+        const float scaled = distance / static_cast<float>(radius) * static_cast<float>(peaks.size());
+        if (scaled >= static_cast<float>(peaks.size()))
+            return 0;
+        const auto ring = static_cast<size_t>(scaled);
+        const float r = scaled - static_cast<float>(ring);
+        if (r <= 0)
+            return 0;
+        return peaks[ring] * std::exp(4 - 1 / (r * (1 - r)));
+    }
+
+    /**
+     * Gets the growth of a cell from its potential, the weighted sum of its neighbourhood.
+     *
+     * @param potential Potential, in [0, 1]
+     * @return Growth, in [-1, 1]
+     */
+    float LeniaRule::growth(const float potential) const {
+        const float z = (potential - mu) / sigma;
+        return 2 * std::exp(-z * z / 2) - 1;
+    }
+
+    /**
+     * Gets the next value of a cell.
+     *
+     * @param value Value of the cell
+     * @param potential Potential of the cell
+     * @return Next value, in [0, 1]
+     */
+    float LeniaRule::next(const float value, const float potential) const {
+        return std::clamp(value + growth(potential) / static_cast<float>(timeScale), 0.0f, 1.0f);
+    }
+
+    /**
+     * Gets the rule in Lenia notation.
+     *
+     * @return Rule notation, such as R=13;T=10;m=0.15;s=0.015;b=1
+     */
+    std::string LeniaRule::toString() const {
+        std::ostringstream result;
+        result << "R=" << radius << ";T=" << timeScale << ";m=" << mu << ";s=" << sigma << ";b=";
+        for (size_t i = 0; i < peaks.size(); i++) {
+            result << (i > 0 ? "," : "") << peaks[i];
+        }
+        return result.str();
+    }
+}
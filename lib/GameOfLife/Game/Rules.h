@@ -0,0 +1,240 @@
+#ifndef RULES_H
+#define RULES_H
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#define RULE_COUNT 6
+
+namespace GameOfLife::Game {
+    /**
+     * Outer-totalistic rule known at compile time.
+     * Bit n of the birth (or survival) mask is set if a dead (or living) cell with n living neighbors is alive on the next generation.
+     * Both masks are merged in a single 18-bit table, so the transition is one shift and one mask, without any branch.
+     *
+     * @tparam Birth Birth mask
+     * @tparam Survival Survival mask
+     */
+    template<uint16_t Birth, uint16_t Survival>
+    struct LifeLike {
+        static constexpr uint16_t birth = Birth;
+        static constexpr uint16_t survival = Survival;
+        static constexpr uint32_t table = Birth | static_cast<uint32_t>(Survival) << 9;
+
+        [[nodiscard]] static constexpr bool next(const bool alive, const int neighbors) {
+            return table >> (alive * 9 + neighbors) & 1;
+        }
+    };
+
+    // B3/S23
+    using Conway = LifeLike<0b1000, 0b1100>;
+    // B36/S23
+    using HighLife = LifeLike<0b1001000, 0b1100>;
+    // B2/S
+    using Seeds = LifeLike<0b100, 0>;
+    // B3678/S34678
+    using DayAndNight = LifeLike<0b111001000, 0b111011000>;
+    // B3/S012345678
+    using LifeWithoutDeath = LifeLike<0b1000, 0b111111111>;
+    // B3/S12345
+    using Maze = LifeLike<0b1000, 0b111110>;
+
+    /**
+     * Rules instantiated in the engines, selected at runtime.
+     */
+    enum class Rule {
+        CONWAY,
+        HIGHLIFE,
+        SEEDS,
+        DAY_AND_NIGHT,
+        LIFE_WITHOUT_DEATH,
+        MAZE
+    };
+
+    /**
+     * Outer-totalistic rule chosen at runtime, such as a rule read from an RLE header.
+     * The transition is a 2x9 lookup table indexed by the state of the cell and its number of living neighbors.
+     */
+    class LifeLikeRule {
+    private:
+        uint16_t birth;
+        uint16_t survival;
+        std::array<std::array<bool, 9>, 2> table{};
+
+    public:
+        LifeLikeRule(uint16_t birth = Conway::birth, uint16_t survival = Conway::survival);
+        LifeLikeRule(Rule preset);
+
+        static LifeLikeRule parse(const std::string &notation);
+
+        [[nodiscard]] bool next(const bool alive, const int neighbors) const { return table[alive][neighbors]; }
+
+        [[nodiscard]] uint16_t getBirth() const { return birth; }
+        [[nodiscard]] uint16_t getSurvival() const { return survival; }
+        [[nodiscard]] std::optional<Rule> getPreset() const;
+        [[nodiscard]] bool isConway() const { return birth == Conway::birth && survival == Conway::survival; }
+        [[nodiscard]] std::string toString() const;
+
+        bool operator==(const LifeLikeRule &other) const { return birth == other.birth && survival == other.survival; }
+    };
+
+    /**
+     * Isotropic non-totalistic rule, in Hensel notation (B2n3/S23-q).
+     * The transition is a 512-entry table indexed by the whole neighbourhood, bit r * 3 + c set if the cell at row r and
+     * column c of the 3x3 block is alive (the centre cell is bit 4). Outer-totalistic rules are a special case, and keep
+     * their LifeLikeRule so the engines can use the faster counting paths.
+     * The table is also compiled to a circuit of multiplexers, a reduced decision diagram over the nine neighbourhood
+     * bits, which the packed engines evaluate on 64 cells at a time.
+     */
+    class IsotropicRule {
+    public:
+        /**
+         * Node of the circuit: input ? high : low. Nodes 0 and 1 are the constants, node i + 2 is circuit[i].
+         */
+        struct Multiplexer {
+            uint8_t input;
+            uint16_t low;
+            uint16_t high;
+        };
+
+        // A reduced diagram over 9 variables has at most 145 nodes
+        static constexpr int MAX_CIRCUIT = 160;
+
+        IsotropicRule(const LifeLikeRule &rule = {});
+        IsotropicRule(Rule preset) : IsotropicRule(LifeLikeRule(preset)) {}
+
+        static IsotropicRule parse(const std::string &notation);
+
+        [[nodiscard]] bool next(const int index) const { return table[index >> 6] >> (index & 63) & 1; }
+
+        [[nodiscard]] bool isTotalistic() const { return totalistic.has_value(); }
+        [[nodiscard]] const std::optional<LifeLikeRule> &getTotalistic() const { return totalistic; }
+        [[nodiscard]] std::optional<Rule> getPreset() const { return totalistic ? totalistic->getPreset() : std::nullopt; }
+        [[nodiscard]] const std::vector<Multiplexer> &getCircuit() const { return circuit; }
+        [[nodiscard]] std::string toString() const;
+
+        bool operator==(const IsotropicRule &other) const { return table == other.table; }
+
+    private:
+        std::array<uint64_t, 8> table{};
+        std::optional<LifeLikeRule> totalistic;
+        std::vector<Multiplexer> circuit;
+
+        explicit IsotropicRule(const std::array<uint64_t, 8> &table);
+        void compile();
+    };
+
+    /**
+     * Larger than Life rule, in the notation R5,C0,M1,S34..58,B34..45,NM (Bosco's rule).
+     * A cell counts the living cells within a range R of it, in a square (Moore) or diamond (von Neumann) neighbourhood,
+     * itself included if M is 1. A dead (or living) cell is alive on the next generation if the count is within the
+     * birth (or survival) interval.
+     */
+    class LargerThanLifeRule {
+    public:
+        enum class Neighborhood {
+            MOORE,
+            VON_NEUMANN
+        };
+
+        static constexpr int MAX_RANGE = 500;
+
+        LargerThanLifeRule(int range = 5, bool middle = true, int survivalMin = 34, int survivalMax = 58,
+            int birthMin = 34, int birthMax = 45, Neighborhood neighborhood = Neighborhood::MOORE);
+
+        static LargerThanLifeRule parse(const std::string &notation);
+
+        [[nodiscard]] bool next(const bool alive, const int count) const {
+            return alive ? count >= survivalMin && count <= survivalMax : count >= birthMin && count <= birthMax;
+        }
+
+        [[nodiscard]] int getRange() const { return range; }
+        [[nodiscard]] bool isMiddleIncluded() const { return middle; }
+        [[nodiscard]] Neighborhood getNeighborhood() const { return neighborhood; }
+        [[nodiscard]] int getNeighborhoodSize() const;
+        [[nodiscard]] std::string toString() const;
+
+        bool operator==(const LargerThanLifeRule &other) const = default;
+
+    private:
+        int range;
+        bool middle;
+        int survivalMin;
+        int survivalMax;
+        int birthMin;
+        int birthMax;
+        Neighborhood neighborhood;
+    };
+
+    /**
+     * Multi-state rule, one byte per cell.
+     * Generations rules (B2/S/C3, Brian's Brain) have one living state: a living cell that does not survive decays
+     * through the states 2 to C - 1, and only dead cells (state 0) can be born. Only state 1 counts as a living neighbor.
+     * LifeHistory runs B3/S23 on the odd states, and records what happened in the even states:
+     * 1 alive, 2 dead and once alive, 3 marked alive, 4 marked dead, 5 alive since the start, 6 dead since the start.
+     * A living cell keeps its state or dies to the next one, a dead cell is born in state 1, or 3 if it was marked.
+     */
+    class GenerationsRule {
+    private:
+        LifeLikeRule lifeLike;
+        int states;
+        bool history;
+
+    public:
+        static constexpr int MAX_STATES = 256;
+
+        GenerationsRule(const LifeLikeRule &lifeLike = {}, int states = 2);
+
+        static GenerationsRule parse(const std::string &notation);
+        static GenerationsRule lifeHistory();
+
+        [[nodiscard]] bool isAlive(const uint8_t state) const { return history ? state & 1 : state == 1; }
+        [[nodiscard]] uint8_t next(uint8_t state, int neighbors) const;
+
+        [[nodiscard]] const LifeLikeRule &getLifeLike() const { return lifeLike; }
+        [[nodiscard]] int getStates() const { return states; }
+        [[nodiscard]] bool isHistory() const { return history; }
+        [[nodiscard]] std::string toString() const;
+
+        bool operator==(const GenerationsRule &other) const = default;
+    };
+
+    /**
+     * Lenia rule, in the notation R=13;T=10;m=0.15;s=0.015;b=1 (Orbium).
+     * Cells are real values in [0, 1]. Each cell weighs the cells within a radius R with a kernel of concentric rings,
+     * one per peak of b, and grows by G(u) / T, G being a Gaussian bump of centre m and width s mapped to [-1, 1].
+     */
+    class LeniaRule {
+    public:
+        static constexpr int MAX_RADIUS = 256;
+        static constexpr int MAX_PEAKS = 8;
+
+        LeniaRule(int radius = 13, int timeScale = 10, float mu = 0.15f, float sigma = 0.015f, std::vector<float> peaks = {1});
+
+        static LeniaRule parse(const std::string &notation);
+
+        [[nodiscard]] float kernel(float distance) const;
+        [[nodiscard]] float growth(float potential) const;
+        [[nodiscard]] float next(float value, float potential) const;
+
+        [[nodiscard]] int getRadius() const { return radius; }
+        [[nodiscard]] int getTimeScale() const { return timeScale; }
+        [[nodiscard]] float getMu() const { return mu; }
+        [[nodiscard]] float getSigma() const { return sigma; }
+        [[nodiscard]] const std::vector<float> &getPeaks() const { return peaks; }
+        [[nodiscard]] std::string toString() const;
+
+        bool operator==(const LeniaRule &other) const = default;
+
+    private:
+        int radius;
+        int timeScale;
+        float mu;
+        float sigma;
+        std::vector<float> peaks;
+    };
+}
+
+#endif //RULES_H
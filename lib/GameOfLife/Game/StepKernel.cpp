@@ -0,0 +1,1456 @@
+#include "StepKernel.h"
+
+#include <initializer_list>
+
+#include "Random.h"
+#include "Rules.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define STEPKERNEL_X86
+#include <immintrin.h>
+#endif
+
+namespace GameOfLife::Game {
+    StepKernel::Variant StepKernel::variant = detectVariant();
+    StepKernel::InteriorFunction StepKernel::interior = getInterior(variant);
+    StepKernel::PackFunction StepKernel::packKernel = getPack(variant);
+    StepKernel::StatesFunction StepKernel::statesKernel = getStates(variant);
+    StepKernel::RandomFunction StepKernel::randomKernel = getRandom(variant);
+    StepKernel::RuleFunction StepKernel::ruleKernel = getRuleKernel(variant);
+    StepKernel::CircuitFunction StepKernel::circuitKernel = getCircuitKernel(variant);
+
+    /**
+     * Computes the next state of 64 cells from the nine words of their neighbourhood (B3/S23).
+     *
+     * @return Next state of the 64 cells
+     */
+    static inline uint64_t lifeWord(const uint64_t aw, const uint64_t ac, const uint64_t ae,
+        const uint64_t mw, const uint64_t mc, const uint64_t me,
+        const uint64_t bw, const uint64_t bc, const uint64_t be) {
+        // Row above and row below: full adders of west, centre and east
+        const uint64_t aSum = aw ^ ac ^ ae;
+        const uint64_t aCarry = (aw & ac) | (ae & (aw ^ ac));
+        const uint64_t bSum = bw ^ bc ^ be;
+        const uint64_t bCarry = (bw & bc) | (be & (bw ^ bc));
+
+        // Current row: half adder of west and east
+        const uint64_t mSum = mw ^ me;
+        const uint64_t mCarry = mw & me;
+
+        // Ones column
+        const uint64_t ones = aSum ^ bSum ^ mSum;
+        const uint64_t onesCarry = (aSum & bSum) | (mSum & (aSum ^ bSum));
+
+        // Twos column: exactly one of the four carries means a total of 2 or 3
+        const uint64_t p1 = aCarry ^ bCarry, q1 = aCarry & bCarry;
+        const uint64_t p2 = mCarry ^ onesCarry, q2 = mCarry & onesCarry;
+        const uint64_t twoOrThree = (p1 ^ p2) & ~(q1 | q2);
+
+        // 3 neighbours, or 2 neighbours and alive
+        return twoOrThree & (ones | mc);
+    }
+
+    /**
+     * Computes the next state of 64 cells from the nine words of their neighbourhood, for any outer-totalistic rule.
+     * The neighbour count is added in four bit planes, then the rule is applied as a tree of multiplexers over the
+     * count bits, whose leaves are the entries of the rule table expanded to full words.
+     *
+     * @param leaves Rule table, leaves[alive][neighbors] is 0 or all ones
+     * @return Next state of the 64 cells
+     */
+    static inline uint64_t ruleWord(const uint64_t (&leaves)[2][9], const uint64_t aw, const uint64_t ac,
+        const uint64_t ae, const uint64_t mw, const uint64_t mc, const uint64_t me,
+        const uint64_t bw, const uint64_t bc, const uint64_t be) {
+        const uint64_t aSum = aw ^ ac ^ ae;
+        const uint64_t aCarry = (aw & ac) | (ae & (aw ^ ac));
+        const uint64_t bSum = bw ^ bc ^ be;
+        const uint64_t bCarry = (bw & bc) | (be & (bw ^ bc));
+        const uint64_t mSum = mw ^ me;
+        const uint64_t mCarry = mw & me;
+
+        const uint64_t ones = aSum ^ bSum ^ mSum;
+        const uint64_t onesCarry = (aSum & bSum) | (mSum & (aSum ^ bSum));
+
+        // Sum of the four carries, each of weight 2
+        const uint64_t p1 = aCarry ^ bCarry, q1 = aCarry & bCarry;
+        const uint64_t p2 = mCarry ^ onesCarry, q2 = mCarry & onesCarry;
+        const uint64_t twos = p1 ^ p2;
+        const uint64_t fours = q1 ^ q2 ^ (p1 & p2);
+        const uint64_t eights = q1 & q2;
+
+        auto mux = [](const uint64_t select, const uint64_t zero, const uint64_t one) {
+            return (zero & ~select) | (one & select);
+        };
+        auto apply = [&](const uint64_t (&table)[9]) {
+            const uint64_t low = mux(twos, mux(ones, table[0], table[1]), mux(ones, table[2], table[3]));
+            const uint64_t high = mux(twos, mux(ones, table[4], table[5]), mux(ones, table[6], table[7]));
+            // A count of 8 is the only one with the eights bit, all the lower bits are then clear
+            return mux(eights, mux(fours, low, high), table[8]);
+        };
+
+        return mux(mc, apply(leaves[0]), apply(leaves[1]));
+    }
+
+    /**
+     * Evaluates the circuit of an isotropic rule on 64 cells.
+     *
+     * @param circuit Circuit of the rule
+     * @param inputs Neighbourhood words, by neighbourhood bit (NW, N, NE, W, centre, E, SW, S, SE)
+     * @return Next state of the 64 cells
+     */
+    static inline uint64_t circuitWord(const std::vector<IsotropicRule::Multiplexer> &circuit, const uint64_t (&inputs)[9]) {
+        if (circuit.empty())
+            return 0;
+
+        uint64_t values[IsotropicRule::MAX_CIRCUIT + 2];
+        values[0] = 0;
+        values[1] = ~uint64_t{0};
+        for (size_t i = 0; i < circuit.size(); i++) {
+            const auto &node = circuit[i];
+            values[i + 2] = values[node.low] ^ ((values[node.low] ^ values[node.high]) & inputs[node.input]);
+        }
+        return values[circuit.size() + 1];
+    }
+
+    /**
+     * Portable kernel, one word at a time.
+     *
+     * @param above Row above
+     * @param current Row to compute
+     * @param below Row below
+     * @param out Destination row
+     * @param begin First word to compute, must be at least 1
+     * @param end Word after the last one to compute, must be at most the number of words minus 1
+     * @return Word after the last one computed
+     */
+    static int interiorScalar(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+        const int begin, const int end) {
+        for (int w = begin; w < end; w++) {
+            out[w] = lifeWord(
+                above[w] << 1 | above[w - 1] >> 63, above[w], above[w] >> 1 | above[w + 1] << 63,
+                current[w] << 1 | current[w - 1] >> 63, current[w], current[w] >> 1 | current[w + 1] << 63,
+                below[w] << 1 | below[w - 1] >> 63, below[w], below[w] >> 1 | below[w + 1] << 63);
+        }
+        return end;
+    }
+
+    /**
+     * Computes a run of words with a word function, one word at a time. The sources give, for each row of the
+     * neighbourhood, the words holding the west carries, the cells and the east carries, which advance together.
+     *
+     * @param word Word function, taking the nine words of the neighbourhood
+     * @param sources Words of the neighbourhood of the first word of the run
+     * @param out Destination of the run
+     * @param begin First word to compute
+     * @param count Number of words of the run
+     */
+    template<typename TWord>
+    static void runScalar(const TWord &word, const uint64_t *const (&sources)[3][3], uint64_t *out, const int begin,
+        const int count) {
+        for (int i = begin; i < count; i++) {
+            uint64_t v[3][3];
+            for (int r = 0; r < 3; r++) {
+                const uint64_t centre = sources[r][1][i];
+                v[r][0] = centre << 1 | sources[r][0][i] >> 63;
+                v[r][1] = centre;
+                v[r][2] = centre >> 1 | sources[r][2][i] << 63;
+            }
+            out[i] = word(v[0][0], v[0][1], v[0][2], v[1][0], v[1][1], v[1][2], v[2][0], v[2][1], v[2][2]);
+        }
+    }
+
+    /**
+     * Scalar outer-totalistic run, returning the first word left to compute.
+     */
+    static int ruleScalar(const uint64_t *const (&)[3][3], uint64_t *, int, const uint64_t (&)[2][9]) {
+        return 0;
+    }
+
+    /**
+     * Scalar isotropic run, returning the first word left to compute.
+     */
+    static int circuitScalar(const uint64_t *const (&)[3][3], uint64_t *, int, const IsotropicRule &) {
+        return 0;
+    }
+
+    /**
+     * Next state of a multi-state cell, given whether its living form is alive on the next generation.
+     *
+     * @param state State of the cell
+     * @param alive Next state of the living plane
+     * @param count Number of states
+     * @param history LifeHistory instead of Generations
+     * @return Next state
+     */
+    static inline uint8_t nextState(const uint8_t state, const bool alive, const int count, const bool history) {
+        if (history) {
+            if (state & 1)
+                return alive ? state : state + 1;
+            return alive ? (state == 4 ? 3 : 1) : state;
+        }
+        if (alive && state <= 1)
+            return 1;
+        return state == 0 || state + 1 == count ? 0 : state + 1;
+    }
+
+    /**
+     * Scalar packing of the living states, returning the first cell left to pack.
+     */
+    static int packScalar(const uint8_t *, uint64_t *, int, uint8_t) {
+        return 0;
+    }
+
+    /**
+     * Scalar multi-state step, returning the first cell left to step.
+     */
+    static int statesScalar(const uint8_t *, const uint64_t *, uint8_t *, int, int, bool) {
+        return 0;
+    }
+
+    /**
+     * Scalar random row, returning the first word left to draw.
+     */
+    static int randomScalar(uint64_t *, uint64_t *, int, uint32_t, uint32_t, uint32_t, uint64_t) {
+        return 0;
+    }
+
+#ifdef STEPKERNEL_X86
+    /**
+     * SSE2 kernel, two words at a time.
+     * The neighbour words are read with unaligned loads shifted by one word.
+     */
+    __attribute__((target("sse2")))
+    static int interiorSSE2(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+        const int begin, const int end) {
+        int w = begin;
+        for (; w + 2 <= end; w += 2) {
+            __m128i v[3][3];
+            const uint64_t *rows[3] = {above, current, below};
+            for (int r = 0; r < 3; r++) {
+                const __m128i centre = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[r] + w));
+                const __m128i previous = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[r] + w - 1));
+                const __m128i following = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[r] + w + 1));
+                v[r][0] = _mm_or_si128(_mm_slli_epi64(centre, 1), _mm_srli_epi64(previous, 63));
+                v[r][1] = centre;
+                v[r][2] = _mm_or_si128(_mm_srli_epi64(centre, 1), _mm_slli_epi64(following, 63));
+            }
+
+            const __m128i aSum = _mm_xor_si128(_mm_xor_si128(v[0][0], v[0][1]), v[0][2]);
+            const __m128i aCarry = _mm_or_si128(_mm_and_si128(v[0][0], v[0][1]), _mm_and_si128(v[0][2], _mm_xor_si128(v[0][0], v[0][1])));
+            const __m128i bSum = _mm_xor_si128(_mm_xor_si128(v[2][0], v[2][1]), v[2][2]);
+            const __m128i bCarry = _mm_or_si128(_mm_and_si128(v[2][0], v[2][1]), _mm_and_si128(v[2][2], _mm_xor_si128(v[2][0], v[2][1])));
+            const __m128i mSum = _mm_xor_si128(v[1][0], v[1][2]);
+            const __m128i mCarry = _mm_and_si128(v[1][0], v[1][2]);
+
+            const __m128i ones = _mm_xor_si128(_mm_xor_si128(aSum, bSum), mSum);
+            const __m128i onesCarry = _mm_or_si128(_mm_and_si128(aSum, bSum), _mm_and_si128(mSum, _mm_xor_si128(aSum, bSum)));
+
+            const __m128i p1 = _mm_xor_si128(aCarry, bCarry), q1 = _mm_and_si128(aCarry, bCarry);
+            const __m128i p2 = _mm_xor_si128(mCarry, onesCarry), q2 = _mm_and_si128(mCarry, onesCarry);
+            const __m128i twoOrThree = _mm_andnot_si128(_mm_or_si128(q1, q2), _mm_xor_si128(p1, p2));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + w), _mm_and_si128(twoOrThree, _mm_or_si128(ones, v[1][1])));
+        }
+        return w;
+    }
+
+    /**
+     * AVX2 kernel, four words at a time.
+     */
+    __attribute__((target("avx2")))
+    static int interiorAVX2(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+        const int begin, const int end) {
+        int w = begin;
+        for (; w + 4 <= end; w += 4) {
+            __m256i v[3][3];
+            const uint64_t *rows[3] = {above, current, below};
+            for (int r = 0; r < 3; r++) {
+                const __m256i centre = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rows[r] + w));
+                const __m256i previous = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rows[r] + w - 1));
+                const __m256i following = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rows[r] + w + 1));
+                v[r][0] = _mm256_or_si256(_mm256_slli_epi64(centre, 1), _mm256_srli_epi64(previous, 63));
+                v[r][1] = centre;
+                v[r][2] = _mm256_or_si256(_mm256_srli_epi64(centre, 1), _mm256_slli_epi64(following, 63));
+            }
+
+            const __m256i aSum = _mm256_xor_si256(_mm256_xor_si256(v[0][0], v[0][1]), v[0][2]);
+            const __m256i aCarry = _mm256_or_si256(_mm256_and_si256(v[0][0], v[0][1]), _mm256_and_si256(v[0][2], _mm256_xor_si256(v[0][0], v[0][1])));
+            const __m256i bSum = _mm256_xor_si256(_mm256_xor_si256(v[2][0], v[2][1]), v[2][2]);
+            const __m256i bCarry = _mm256_or_si256(_mm256_and_si256(v[2][0], v[2][1]), _mm256_and_si256(v[2][2], _mm256_xor_si256(v[2][0], v[2][1])));
+            const __m256i mSum = _mm256_xor_si256(v[1][0], v[1][2]);
+            const __m256i mCarry = _mm256_and_si256(v[1][0], v[1][2]);
+
+            const __m256i ones = _mm256_xor_si256(_mm256_xor_si256(aSum, bSum), mSum);
+            const __m256i onesCarry = _mm256_or_si256(_mm256_and_si256(aSum, bSum), _mm256_and_si256(mSum, _mm256_xor_si256(aSum, bSum)));
+
+            const __m256i p1 = _mm256_xor_si256(aCarry, bCarry), q1 = _mm256_and_si256(aCarry, bCarry);
+            const __m256i p2 = _mm256_xor_si256(mCarry, onesCarry), q2 = _mm256_and_si256(mCarry, onesCarry);
+            const __m256i twoOrThree = _mm256_andnot_si256(_mm256_or_si256(q1, q2), _mm256_xor_si256(p1, p2));
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + w), _mm256_and_si256(twoOrThree, _mm256_or_si256(ones, v[1][1])));
+        }
+        return w;
+    }
+
+    /**
+     * AVX-512 kernel, eight words at a time.
+     * Full adders use ternary logic: 0x96 is the three-input xor, 0xE8 the majority.
+     */
+    __attribute__((target("avx512f")))
+    static int interiorAVX512(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+        const int begin, const int end) {
+        int w = begin;
+        for (; w + 8 <= end; w += 8) {
+            __m512i v[3][3];
+            const uint64_t *rows[3] = {above, current, below};
+            for (int r = 0; r < 3; r++) {
+                const __m512i centre = _mm512_loadu_si512(rows[r] + w);
+                const __m512i previous = _mm512_loadu_si512(rows[r] + w - 1);
+                const __m512i following = _mm512_loadu_si512(rows[r] + w + 1);
+                v[r][0] = _mm512_or_si512(_mm512_slli_epi64(centre, 1), _mm512_srli_epi64(previous, 63));
+                v[r][1] = centre;
+                v[r][2] = _mm512_or_si512(_mm512_srli_epi64(centre, 1), _mm512_slli_epi64(following, 63));
+            }
+
+            const __m512i aSum = _mm512_ternarylogic_epi64(v[0][0], v[0][1], v[0][2], 0x96);
+            const __m512i aCarry = _mm512_ternarylogic_epi64(v[0][0], v[0][1], v[0][2], 0xE8);
+            const __m512i bSum = _mm512_ternarylogic_epi64(v[2][0], v[2][1], v[2][2], 0x96);
+            const __m512i bCarry = _mm512_ternarylogic_epi64(v[2][0], v[2][1], v[2][2], 0xE8);
+            const __m512i mSum = _mm512_xor_si512(v[1][0], v[1][2]);
+            const __m512i mCarry = _mm512_and_si512(v[1][0], v[1][2]);
+
+            const __m512i ones = _mm512_ternarylogic_epi64(aSum, bSum, mSum, 0x96);
+            const __m512i onesCarry = _mm512_ternarylogic_epi64(aSum, bSum, mSum, 0xE8);
+
+            const __m512i p1 = _mm512_xor_si512(aCarry, bCarry), q1 = _mm512_and_si512(aCarry, bCarry);
+            const __m512i p2 = _mm512_xor_si512(mCarry, onesCarry), q2 = _mm512_and_si512(mCarry, onesCarry);
+            const __m512i twoOrThree = _mm512_andnot_si512(_mm512_or_si512(q1, q2), _mm512_xor_si512(p1, p2));
+
+            _mm512_storeu_si512(out + w, _mm512_and_si512(twoOrThree, _mm512_or_si512(ones, v[1][1])));
+        }
+        return w;
+    }
+    /**
+     * Selects, for each bit, one when select is set and zero otherwise.
+     */
+    __attribute__((target("sse2")))
+    static inline __m128i muxSSE2(const __m128i select, const __m128i zero, const __m128i one) {
+        return _mm_or_si128(_mm_andnot_si128(select, zero), _mm_and_si128(select, one));
+    }
+
+    /**
+     * Loads the neighbourhood of two words from the sources of a run.
+     */
+    __attribute__((target("sse2")))
+    static inline void loadSSE2(const uint64_t *const (&sources)[3][3], const int i, __m128i (&v)[9]) {
+        for (int r = 0; r < 3; r++) {
+            const __m128i centre = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sources[r][1] + i));
+            const __m128i west = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sources[r][0] + i));
+            const __m128i east = _mm_loadu_si128(reinterpret_cast<const __m128i *>(sources[r][2] + i));
+            v[3 * r] = _mm_or_si128(_mm_slli_epi64(centre, 1), _mm_srli_epi64(west, 63));
+            v[3 * r + 1] = centre;
+            v[3 * r + 2] = _mm_or_si128(_mm_srli_epi64(centre, 1), _mm_slli_epi64(east, 63));
+        }
+    }
+
+    /**
+     * Applies a rule table to the neighbour counts, as ruleWord.
+     */
+    __attribute__((target("sse2")))
+    static inline __m128i applySSE2(const __m128i (&table)[9], const __m128i ones, const __m128i twos,
+        const __m128i fours, const __m128i eights) {
+        const __m128i low = muxSSE2(twos, muxSSE2(ones, table[0], table[1]), muxSSE2(ones, table[2], table[3]));
+        const __m128i high = muxSSE2(twos, muxSSE2(ones, table[4], table[5]), muxSSE2(ones, table[6], table[7]));
+        return muxSSE2(eights, muxSSE2(fours, low, high), table[8]);
+    }
+
+    /**
+     * SSE2 outer-totalistic kernel, two words at a time, the rule table broadcast to vectors.
+     */
+    __attribute__((target("sse2")))
+    static int ruleSSE2(const uint64_t *const (&sources)[3][3], uint64_t *out, const int count,
+        const uint64_t (&leaves)[2][9]) {
+        __m128i table[2][9];
+        for (int alive = 0; alive < 2; alive++) {
+            for (int n = 0; n <= 8; n++) {
+                table[alive][n] = _mm_set1_epi64x(static_cast<long long>(leaves[alive][n]));
+            }
+        }
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m128i v[9];
+            loadSSE2(sources, i, v);
+            const __m128i aSum = _mm_xor_si128(_mm_xor_si128(v[0], v[1]), v[2]);
+            const __m128i aCarry = _mm_or_si128(_mm_and_si128(v[0], v[1]), _mm_and_si128(v[2], _mm_xor_si128(v[0], v[1])));
+            const __m128i bSum = _mm_xor_si128(_mm_xor_si128(v[6], v[7]), v[8]);
+            const __m128i bCarry = _mm_or_si128(_mm_and_si128(v[6], v[7]), _mm_and_si128(v[8], _mm_xor_si128(v[6], v[7])));
+            const __m128i mSum = _mm_xor_si128(v[3], v[5]);
+            const __m128i mCarry = _mm_and_si128(v[3], v[5]);
+
+            const __m128i ones = _mm_xor_si128(_mm_xor_si128(aSum, bSum), mSum);
+            const __m128i onesCarry = _mm_or_si128(_mm_and_si128(aSum, bSum), _mm_and_si128(mSum, _mm_xor_si128(aSum, bSum)));
+
+            const __m128i p1 = _mm_xor_si128(aCarry, bCarry), q1 = _mm_and_si128(aCarry, bCarry);
+            const __m128i p2 = _mm_xor_si128(mCarry, onesCarry), q2 = _mm_and_si128(mCarry, onesCarry);
+            const __m128i twos = _mm_xor_si128(p1, p2);
+            const __m128i fours = _mm_xor_si128(_mm_xor_si128(q1, q2), _mm_and_si128(p1, p2));
+            const __m128i eights = _mm_and_si128(q1, q2);
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), muxSSE2(v[4],
+                applySSE2(table[0], ones, twos, fours, eights), applySSE2(table[1], ones, twos, fours, eights)));
+        }
+        return i;
+    }
+
+    /**
+     * SSE2 isotropic kernel, evaluating the circuit of the rule on two words at a time.
+     */
+    __attribute__((target("sse2")))
+    static int circuitSSE2(const uint64_t *const (&sources)[3][3], uint64_t *out, const int count,
+        const IsotropicRule &rule) {
+        const auto &circuit = rule.getCircuit();
+        __m128i values[IsotropicRule::MAX_CIRCUIT + 2];
+        values[0] = _mm_setzero_si128();
+        values[1] = _mm_set1_epi64x(-1);
+
+        int i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m128i v[9];
+            loadSSE2(sources, i, v);
+            for (size_t k = 0; k < circuit.size(); k++) {
+                const auto &node = circuit[k];
+                values[k + 2] = muxSSE2(v[node.input], values[node.low], values[node.high]);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), values[circuit.size() + 1]);
+        }
+        return i;
+    }
+
+    /**
+     * Selects, for each bit, one when select is set and zero otherwise.
+     */
+    __attribute__((target("avx2")))
+    static inline __m256i muxAVX2(const __m256i select, const __m256i zero, const __m256i one) {
+        return _mm256_or_si256(_mm256_andnot_si256(select, zero), _mm256_and_si256(select, one));
+    }
+
+    /**
+     * Loads the neighbourhood of four words from the sources of a run.
+     */
+    __attribute__((target("avx2")))
+    static inline void loadAVX2(const uint64_t *const (&sources)[3][3], const int i, __m256i (&v)[9]) {
+        for (int r = 0; r < 3; r++) {
+            const __m256i centre = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sources[r][1] + i));
+            const __m256i west = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sources[r][0] + i));
+            const __m256i east = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(sources[r][2] + i));
+            v[3 * r] = _mm256_or_si256(_mm256_slli_epi64(centre, 1), _mm256_srli_epi64(west, 63));
+            v[3 * r + 1] = centre;
+            v[3 * r + 2] = _mm256_or_si256(_mm256_srli_epi64(centre, 1), _mm256_slli_epi64(east, 63));
+        }
+    }
+
+    /**
+     * Applies a rule table to the neighbour counts, as ruleWord.
+     */
+    __attribute__((target("avx2")))
+    static inline __m256i applyAVX2(const __m256i (&table)[9], const __m256i ones, const __m256i twos,
+        const __m256i fours, const __m256i eights) {
+        const __m256i low = muxAVX2(twos, muxAVX2(ones, table[0], table[1]), muxAVX2(ones, table[2], table[3]));
+        const __m256i high = muxAVX2(twos, muxAVX2(ones, table[4], table[5]), muxAVX2(ones, table[6], table[7]));
+        return muxAVX2(eights, muxAVX2(fours, low, high), table[8]);
+    }
+
+    /**
+     * AVX2 outer-totalistic kernel, four words at a time.
+     */
+    __attribute__((target("avx2")))
+    static int ruleAVX2(const uint64_t *const (&sources)[3][3], uint64_t *out, const int count,
+        const uint64_t (&leaves)[2][9]) {
+        __m256i table[2][9];
+        for (int alive = 0; alive < 2; alive++) {
+            for (int n = 0; n <= 8; n++) {
+                table[alive][n] = _mm256_set1_epi64x(static_cast<long long>(leaves[alive][n]));
+            }
+        }
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256i v[9];
+            loadAVX2(sources, i, v);
+            const __m256i aSum = _mm256_xor_si256(_mm256_xor_si256(v[0], v[1]), v[2]);
+            const __m256i aCarry = _mm256_or_si256(_mm256_and_si256(v[0], v[1]), _mm256_and_si256(v[2], _mm256_xor_si256(v[0], v[1])));
+            const __m256i bSum = _mm256_xor_si256(_mm256_xor_si256(v[6], v[7]), v[8]);
+            const __m256i bCarry = _mm256_or_si256(_mm256_and_si256(v[6], v[7]), _mm256_and_si256(v[8], _mm256_xor_si256(v[6], v[7])));
+            const __m256i mSum = _mm256_xor_si256(v[3], v[5]);
+            const __m256i mCarry = _mm256_and_si256(v[3], v[5]);
+
+            const __m256i ones = _mm256_xor_si256(_mm256_xor_si256(aSum, bSum), mSum);
+            const __m256i onesCarry = _mm256_or_si256(_mm256_and_si256(aSum, bSum), _mm256_and_si256(mSum, _mm256_xor_si256(aSum, bSum)));
+
+            const __m256i p1 = _mm256_xor_si256(aCarry, bCarry), q1 = _mm256_and_si256(aCarry, bCarry);
+            const __m256i p2 = _mm256_xor_si256(mCarry, onesCarry), q2 = _mm256_and_si256(mCarry, onesCarry);
+            const __m256i twos = _mm256_xor_si256(p1, p2);
+            const __m256i fours = _mm256_xor_si256(_mm256_xor_si256(q1, q2), _mm256_and_si256(p1, p2));
+            const __m256i eights = _mm256_and_si256(q1, q2);
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), muxAVX2(v[4],
+                applyAVX2(table[0], ones, twos, fours, eights), applyAVX2(table[1], ones, twos, fours, eights)));
+        }
+
+        // Two words left are computed by the SSE2 kernel
+        const uint64_t *const rest[3][3] = {
+            {sources[0][0] + i, sources[0][1] + i, sources[0][2] + i},
+            {sources[1][0] + i, sources[1][1] + i, sources[1][2] + i},
+            {sources[2][0] + i, sources[2][1] + i, sources[2][2] + i}
+        };
+        return i + ruleSSE2(rest, out + i, count - i, leaves);
+    }
+
+    /**
+     * AVX2 isotropic kernel, evaluating the circuit of the rule on four words at a time.
+     */
+    __attribute__((target("avx2")))
+    static int circuitAVX2(const uint64_t *const (&sources)[3][3], uint64_t *out, const int count,
+        const IsotropicRule &rule) {
+        const auto &circuit = rule.getCircuit();
+        __m256i values[IsotropicRule::MAX_CIRCUIT + 2];
+        values[0] = _mm256_setzero_si256();
+        values[1] = _mm256_set1_epi64x(-1);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256i v[9];
+            loadAVX2(sources, i, v);
+            for (size_t k = 0; k < circuit.size(); k++) {
+                const auto &node = circuit[k];
+                values[k + 2] = muxAVX2(v[node.input], values[node.low], values[node.high]);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), values[circuit.size() + 1]);
+        }
+
+        // Two words left are computed by the SSE2 kernel
+        const uint64_t *const rest[3][3] = {
+            {sources[0][0] + i, sources[0][1] + i, sources[0][2] + i},
+            {sources[1][0] + i, sources[1][1] + i, sources[1][2] + i},
+            {sources[2][0] + i, sources[2][1] + i, sources[2][2] + i}
+        };
+        return i + circuitSSE2(rest, out + i, count - i, rule);
+    }
+
+    /**
+     * Selects, for each bit, one when select is set and zero otherwise (0xCA is the bitwise select).
+     */
+    __attribute__((target("avx512f")))
+    static inline __m512i muxAVX512(const __m512i select, const __m512i zero, const __m512i one) {
+        return _mm512_ternarylogic_epi64(select, one, zero, 0xCA);
+    }
+
+    /**
+     * Loads the neighbourhood of up to eight words from the sources of a run, the words out of the mask being zero.
+     */
+    __attribute__((target("avx512f")))
+    static inline void loadAVX512(const uint64_t *const (&sources)[3][3], const int i, const __mmask8 mask, __m512i (&v)[9]) {
+        for (int r = 0; r < 3; r++) {
+            const __m512i centre = _mm512_maskz_loadu_epi64(mask, sources[r][1] + i);
+            const __m512i west = _mm512_maskz_loadu_epi64(mask, sources[r][0] + i);
+            const __m512i east = _mm512_maskz_loadu_epi64(mask, sources[r][2] + i);
+            v[3 * r] = _mm512_or_si512(_mm512_slli_epi64(centre, 1), _mm512_srli_epi64(west, 63));
+            v[3 * r + 1] = centre;
+            v[3 * r + 2] = _mm512_or_si512(_mm512_srli_epi64(centre, 1), _mm512_slli_epi64(east, 63));
+        }
+    }
+
+    /**
+     * Applies a rule table to the neighbour counts, as ruleWord.
+     */
+    __attribute__((target("avx512f")))
+    static inline __m512i applyAVX512(const __m512i (&table)[9], const __m512i ones, const __m512i twos,
+        const __m512i fours, const __m512i eights) {
+        const __m512i low = muxAVX512(twos, muxAVX512(ones, table[0], table[1]), muxAVX512(ones, table[2], table[3]));
+        const __m512i high = muxAVX512(twos, muxAVX512(ones, table[4], table[5]), muxAVX512(ones, table[6], table[7]));
+        return muxAVX512(eights, muxAVX512(fours, low, high), table[8]);
+    }
+
+    /**
+     * AVX-512 outer-totalistic kernel, eight words at a time, with the ternary logic adders of interiorAVX512.
+     */
+    __attribute__((target("avx512f")))
+    static int ruleAVX512(const uint64_t *const (&sources)[3][3], uint64_t *out, const int count,
+        const uint64_t (&leaves)[2][9]) {
+        __m512i table[2][9];
+        for (int alive = 0; alive < 2; alive++) {
+            for (int n = 0; n <= 8; n++) {
+                table[alive][n] = _mm512_set1_epi64(static_cast<long long>(leaves[alive][n]));
+            }
+        }
+
+        // The last words of the run are computed with masked loads and stores
+        for (int i = 0; i < count; i += 8) {
+            const auto mask = static_cast<__mmask8>(count - i >= 8 ? 0xFF : (1 << (count - i)) - 1);
+            __m512i v[9];
+            loadAVX512(sources, i, mask, v);
+            const __m512i aSum = _mm512_ternarylogic_epi64(v[0], v[1], v[2], 0x96);
+            const __m512i aCarry = _mm512_ternarylogic_epi64(v[0], v[1], v[2], 0xE8);
+            const __m512i bSum = _mm512_ternarylogic_epi64(v[6], v[7], v[8], 0x96);
+            const __m512i bCarry = _mm512_ternarylogic_epi64(v[6], v[7], v[8], 0xE8);
+            const __m512i mSum = _mm512_xor_si512(v[3], v[5]);
+            const __m512i mCarry = _mm512_and_si512(v[3], v[5]);
+
+            const __m512i ones = _mm512_ternarylogic_epi64(aSum, bSum, mSum, 0x96);
+            const __m512i onesCarry = _mm512_ternarylogic_epi64(aSum, bSum, mSum, 0xE8);
+
+            const __m512i p1 = _mm512_xor_si512(aCarry, bCarry), q1 = _mm512_and_si512(aCarry, bCarry);
+            const __m512i p2 = _mm512_xor_si512(mCarry, onesCarry), q2 = _mm512_and_si512(mCarry, onesCarry);
+            const __m512i twos = _mm512_xor_si512(p1, p2);
+            // q1 ^ q2 ^ (p1 & p2)
+            const __m512i fours = _mm512_ternarylogic_epi64(q1, q2, _mm512_and_si512(p1, p2), 0x96);
+            const __m512i eights = _mm512_and_si512(q1, q2);
+
+            _mm512_mask_storeu_epi64(out + i, mask, muxAVX512(v[4],
+                applyAVX512(table[0], ones, twos, fours, eights), applyAVX512(table[1], ones, twos, fours, eights)));
+        }
+        return count;
+    }
+
+    /**
+     * AVX-512 isotropic kernel, evaluating the circuit of the rule on eight words at a time, one ternary logic
+     * instruction per multiplexer.
+     */
+    __attribute__((target("avx512f")))
+    static int circuitAVX512(const uint64_t *const (&sources)[3][3], uint64_t *out, const int count,
+        const IsotropicRule &rule) {
+        const auto &circuit = rule.getCircuit();
+        __m512i values[IsotropicRule::MAX_CIRCUIT + 2];
+        values[0] = _mm512_setzero_si512();
+        values[1] = _mm512_set1_epi64(-1);
+
+        // The last words of the run are computed with masked loads and stores
+        for (int i = 0; i < count; i += 8) {
+            const auto mask = static_cast<__mmask8>(count - i >= 8 ? 0xFF : (1 << (count - i)) - 1);
+            __m512i v[9];
+            loadAVX512(sources, i, mask, v);
+            for (size_t k = 0; k < circuit.size(); k++) {
+                const auto &node = circuit[k];
+                values[k + 2] = muxAVX512(v[node.input], values[node.low], values[node.high]);
+            }
+            _mm512_mask_storeu_epi64(out + i, mask, values[circuit.size() + 1]);
+        }
+        return count;
+    }
+
+    /**
+     * SSE2 packing of the living states, 16 cells per compare.
+     */
+    __attribute__((target("sse2")))
+    static int packSSE2(const uint8_t *states, uint64_t *plane, const int cols, const uint8_t mask) {
+        const __m128i masks = _mm_set1_epi8(static_cast<char>(mask));
+        const __m128i one = _mm_set1_epi8(1);
+        int j = 0;
+        for (; j + 64 <= cols; j += 64) {
+            uint64_t word = 0;
+            for (int k = 0; k < 64; k += 16) {
+                const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(states + j + k));
+                const __m128i alive = _mm_cmpeq_epi8(_mm_and_si128(s, masks), one);
+                word |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(alive))) << k;
+            }
+            plane[j / 64] = word;
+        }
+        return j;
+    }
+
+    /**
+     * SSE2 multi-state step, 16 cells at a time.
+     * The bits of the next living plane are spread to bytes, then each state is updated with byte compares and masks.
+     */
+    __attribute__((target("sse2")))
+    static int statesSSE2(const uint8_t *states, const uint64_t *next, uint8_t *out, const int cols, const int count,
+        const bool history) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi8(1);
+        const __m128i last = _mm_set1_epi8(static_cast<char>(count));
+        const __m128i bits = _mm_set1_epi64x(static_cast<long long>(0x8040201008040201));
+        int j = 0;
+        for (; j + 16 <= cols; j += 16) {
+            const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(states + j));
+
+            // Byte k gets bit k of the plane, as 0x00 or 0xFF
+            __m128i n = _mm_cvtsi32_si128(static_cast<int>(next[j / 64] >> (j % 64) & 0xFFFF));
+            n = _mm_unpacklo_epi8(n, n);
+            n = _mm_unpacklo_epi16(n, n);
+            n = _mm_unpacklo_epi32(n, n);
+            n = _mm_cmpeq_epi8(_mm_and_si128(n, bits), bits);
+
+            __m128i result;
+            if (history) {
+                const __m128i alive = _mm_cmpeq_epi8(_mm_and_si128(s, one), one);
+                const __m128i aliveNext = _mm_add_epi8(s, _mm_andnot_si128(n, one));
+                const __m128i born = _mm_or_si128(one, _mm_and_si128(_mm_cmpeq_epi8(s, _mm_set1_epi8(4)), _mm_set1_epi8(2)));
+                const __m128i deadNext = _mm_or_si128(_mm_and_si128(n, born), _mm_andnot_si128(n, s));
+                result = _mm_or_si128(_mm_and_si128(alive, aliveNext), _mm_andnot_si128(alive, deadNext));
+            }
+            else {
+                // Born or survived if the plane is set on state 0 or 1, else dead cells stay dead and the others decay
+                const __m128i kept = _mm_and_si128(n, _mm_cmpeq_epi8(_mm_min_epu8(s, one), s));
+                __m128i decay = _mm_add_epi8(s, one);
+                decay = _mm_andnot_si128(_mm_cmpeq_epi8(decay, last), decay);
+                result = _mm_or_si128(_mm_and_si128(kept, one), _mm_andnot_si128(_mm_or_si128(kept, _mm_cmpeq_epi8(s, zero)), decay));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + j), result);
+        }
+        return j;
+    }
+
+    /**
+     * AVX2 packing of the living states, 32 cells per compare.
+     */
+    __attribute__((target("avx2")))
+    static int packAVX2(const uint8_t *states, uint64_t *plane, const int cols, const uint8_t mask) {
+        const __m256i masks = _mm256_set1_epi8(static_cast<char>(mask));
+        const __m256i one = _mm256_set1_epi8(1);
+        int j = 0;
+        for (; j + 64 <= cols; j += 64) {
+            const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states + j));
+            const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states + j + 32));
+            const uint32_t lowBits = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(low, masks), one));
+            const uint32_t highBits = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(high, masks), one));
+            plane[j / 64] = lowBits | static_cast<uint64_t>(highBits) << 32;
+        }
+        return j;
+    }
+
+    /**
+     * AVX2 multi-state step, 32 cells at a time.
+     */
+    __attribute__((target("avx2")))
+    static int statesAVX2(const uint8_t *states, const uint64_t *next, uint8_t *out, const int cols, const int count,
+        const bool history) {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i one = _mm256_set1_epi8(1);
+        const __m256i last = _mm256_set1_epi8(static_cast<char>(count));
+        const __m256i bits = _mm256_set1_epi64x(static_cast<long long>(0x8040201008040201));
+        const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+            2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+        int j = 0;
+        for (; j + 32 <= cols; j += 32) {
+            const __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(states + j));
+
+            // Byte k gets bit k of the plane, as 0x00 or 0xFF
+            __m256i n = _mm256_set1_epi32(static_cast<int>(next[j / 64] >> (j % 64) & 0xFFFFFFFF));
+            n = _mm256_shuffle_epi8(n, spread);
+            n = _mm256_cmpeq_epi8(_mm256_and_si256(n, bits), bits);
+
+            __m256i result;
+            if (history) {
+                const __m256i alive = _mm256_cmpeq_epi8(_mm256_and_si256(s, one), one);
+                const __m256i aliveNext = _mm256_add_epi8(s, _mm256_andnot_si256(n, one));
+                const __m256i born = _mm256_or_si256(one, _mm256_and_si256(_mm256_cmpeq_epi8(s, _mm256_set1_epi8(4)), _mm256_set1_epi8(2)));
+                const __m256i deadNext = _mm256_or_si256(_mm256_and_si256(n, born), _mm256_andnot_si256(n, s));
+                result = _mm256_or_si256(_mm256_and_si256(alive, aliveNext), _mm256_andnot_si256(alive, deadNext));
+            }
+            else {
+                const __m256i kept = _mm256_and_si256(n, _mm256_cmpeq_epi8(_mm256_min_epu8(s, one), s));
+                __m256i decay = _mm256_add_epi8(s, one);
+                decay = _mm256_andnot_si256(_mm256_cmpeq_epi8(decay, last), decay);
+                result = _mm256_or_si256(_mm256_and_si256(kept, one), _mm256_andnot_si256(_mm256_or_si256(kept, _mm256_cmpeq_epi8(s, zero)), decay));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + j), result);
+        }
+        return j;
+    }
+
+    /**
+     * SSE2 random row, four Philox blocks at a time.
+     * Each 32-bit product is split into the even and odd lanes, multiplied as 64-bit lanes and merged back.
+     */
+    __attribute__((target("sse2")))
+    static int randomSSE2(uint64_t *low, uint64_t *high, const int words, const uint32_t row, const uint32_t generation,
+        const uint32_t stream, const uint64_t key) {
+        const __m128i multiplier0 = _mm_set1_epi32(static_cast<int>(0xD2511F53));
+        const __m128i multiplier1 = _mm_set1_epi32(static_cast<int>(0xCD9E8D57));
+        const __m128i lowHalves = _mm_set1_epi64x(0xFFFFFFFF);
+        int w = 0;
+        for (; w + 4 <= words; w += 4) {
+            __m128i c0 = _mm_add_epi32(_mm_set1_epi32(w), _mm_setr_epi32(0, 1, 2, 3));
+            __m128i c1 = _mm_set1_epi32(static_cast<int>(row));
+            __m128i c2 = _mm_set1_epi32(static_cast<int>(generation));
+            __m128i c3 = _mm_set1_epi32(static_cast<int>(stream));
+            auto k0 = static_cast<uint32_t>(key);
+            auto k1 = static_cast<uint32_t>(key >> 32);
+            for (int round = 0; round < 10; round++) {
+                const __m128i even0 = _mm_mul_epu32(c0, multiplier0);
+                const __m128i odd0 = _mm_mul_epu32(_mm_srli_epi64(c0, 32), multiplier0);
+                const __m128i even1 = _mm_mul_epu32(c2, multiplier1);
+                const __m128i odd1 = _mm_mul_epu32(_mm_srli_epi64(c2, 32), multiplier1);
+                const __m128i low0 = _mm_or_si128(_mm_and_si128(even0, lowHalves), _mm_slli_epi64(odd0, 32));
+                const __m128i high0 = _mm_or_si128(_mm_srli_epi64(even0, 32), _mm_andnot_si128(lowHalves, odd0));
+                const __m128i low1 = _mm_or_si128(_mm_and_si128(even1, lowHalves), _mm_slli_epi64(odd1, 32));
+                const __m128i high1 = _mm_or_si128(_mm_srli_epi64(even1, 32), _mm_andnot_si128(lowHalves, odd1));
+                c0 = _mm_xor_si128(_mm_xor_si128(high1, c1), _mm_set1_epi32(static_cast<int>(k0)));
+                c1 = low1;
+                c2 = _mm_xor_si128(_mm_xor_si128(high0, c3), _mm_set1_epi32(static_cast<int>(k1)));
+                c3 = low0;
+                k0 += 0x9E3779B9;
+                k1 += 0xBB67AE85;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(low + w), _mm_unpacklo_epi32(c0, c1));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(low + w + 2), _mm_unpackhi_epi32(c0, c1));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(high + w), _mm_unpacklo_epi32(c2, c3));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(high + w + 2), _mm_unpackhi_epi32(c2, c3));
+        }
+        return w;
+    }
+
+    /**
+     * AVX2 random row, eight Philox blocks at a time.
+     */
+    __attribute__((target("avx2")))
+    static int randomAVX2(uint64_t *low, uint64_t *high, const int words, const uint32_t row, const uint32_t generation,
+        const uint32_t stream, const uint64_t key) {
+        const __m256i multiplier0 = _mm256_set1_epi32(static_cast<int>(0xD2511F53));
+        const __m256i multiplier1 = _mm256_set1_epi32(static_cast<int>(0xCD9E8D57));
+        int w = 0;
+        for (; w + 8 <= words; w += 8) {
+            __m256i c0 = _mm256_add_epi32(_mm256_set1_epi32(w), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            __m256i c1 = _mm256_set1_epi32(static_cast<int>(row));
+            __m256i c2 = _mm256_set1_epi32(static_cast<int>(generation));
+            __m256i c3 = _mm256_set1_epi32(static_cast<int>(stream));
+            auto k0 = static_cast<uint32_t>(key);
+            auto k1 = static_cast<uint32_t>(key >> 32);
+            for (int round = 0; round < 10; round++) {
+                const __m256i even0 = _mm256_mul_epu32(c0, multiplier0);
+                const __m256i odd0 = _mm256_mul_epu32(_mm256_srli_epi64(c0, 32), multiplier0);
+                const __m256i even1 = _mm256_mul_epu32(c2, multiplier1);
+                const __m256i odd1 = _mm256_mul_epu32(_mm256_srli_epi64(c2, 32), multiplier1);
+                const __m256i low0 = _mm256_blend_epi32(even0, _mm256_slli_epi64(odd0, 32), 0xAA);
+                const __m256i high0 = _mm256_blend_epi32(_mm256_srli_epi64(even0, 32), odd0, 0xAA);
+                const __m256i low1 = _mm256_blend_epi32(even1, _mm256_slli_epi64(odd1, 32), 0xAA);
+                const __m256i high1 = _mm256_blend_epi32(_mm256_srli_epi64(even1, 32), odd1, 0xAA);
+                c0 = _mm256_xor_si256(_mm256_xor_si256(high1, c1), _mm256_set1_epi32(static_cast<int>(k0)));
+                c1 = low1;
+                c2 = _mm256_xor_si256(_mm256_xor_si256(high0, c3), _mm256_set1_epi32(static_cast<int>(k1)));
+                c3 = low0;
+                k0 += 0x9E3779B9;
+                k1 += 0xBB67AE85;
+            }
+
+            // The unpacks work within each 128-bit half, so the halves are put back in order
+            const __m256i lowFirst = _mm256_unpacklo_epi32(c0, c1);
+            const __m256i lowSecond = _mm256_unpackhi_epi32(c0, c1);
+            const __m256i highFirst = _mm256_unpacklo_epi32(c2, c3);
+            const __m256i highSecond = _mm256_unpackhi_epi32(c2, c3);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(low + w), _mm256_permute2x128_si256(lowFirst, lowSecond, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(low + w + 4), _mm256_permute2x128_si256(lowFirst, lowSecond, 0x31));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(high + w), _mm256_permute2x128_si256(highFirst, highSecond, 0x20));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(high + w + 4), _mm256_permute2x128_si256(highFirst, highSecond, 0x31));
+        }
+        return w;
+    }
+
+    /**
+     * AVX-512 random row, sixteen Philox blocks at a time.
+     */
+    __attribute__((target("avx512f")))
+    static int randomAVX512(uint64_t *low, uint64_t *high, const int words, const uint32_t row, const uint32_t generation,
+        const uint32_t stream, const uint64_t key) {
+        const __m512i multiplier0 = _mm512_set1_epi32(static_cast<int>(0xD2511F53));
+        const __m512i multiplier1 = _mm512_set1_epi32(static_cast<int>(0xCD9E8D57));
+        const __m512i first = _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11);
+        const __m512i second = _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15);
+        int w = 0;
+        for (; w + 16 <= words; w += 16) {
+            __m512i c0 = _mm512_add_epi32(_mm512_set1_epi32(w),
+                _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+            __m512i c1 = _mm512_set1_epi32(static_cast<int>(row));
+            __m512i c2 = _mm512_set1_epi32(static_cast<int>(generation));
+            __m512i c3 = _mm512_set1_epi32(static_cast<int>(stream));
+            auto k0 = static_cast<uint32_t>(key);
+            auto k1 = static_cast<uint32_t>(key >> 32);
+            for (int round = 0; round < 10; round++) {
+                const __m512i even0 = _mm512_mul_epu32(c0, multiplier0);
+                const __m512i odd0 = _mm512_mul_epu32(_mm512_srli_epi64(c0, 32), multiplier0);
+                const __m512i even1 = _mm512_mul_epu32(c2, multiplier1);
+                const __m512i odd1 = _mm512_mul_epu32(_mm512_srli_epi64(c2, 32), multiplier1);
+                const __m512i low0 = _mm512_mask_blend_epi32(0xAAAA, even0, _mm512_slli_epi64(odd0, 32));
+                const __m512i high0 = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even0, 32), odd0);
+                const __m512i low1 = _mm512_mask_blend_epi32(0xAAAA, even1, _mm512_slli_epi64(odd1, 32));
+                const __m512i high1 = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(even1, 32), odd1);
+                c0 = _mm512_xor_si512(_mm512_xor_si512(high1, c1), _mm512_set1_epi32(static_cast<int>(k0)));
+                c1 = low1;
+                c2 = _mm512_xor_si512(_mm512_xor_si512(high0, c3), _mm512_set1_epi32(static_cast<int>(k1)));
+                c3 = low0;
+                k0 += 0x9E3779B9;
+                k1 += 0xBB67AE85;
+            }
+
+            const __m512i lowFirst = _mm512_unpacklo_epi32(c0, c1);
+            const __m512i lowSecond = _mm512_unpackhi_epi32(c0, c1);
+            const __m512i highFirst = _mm512_unpacklo_epi32(c2, c3);
+            const __m512i highSecond = _mm512_unpackhi_epi32(c2, c3);
+            _mm512_storeu_si512(low + w, _mm512_permutex2var_epi64(lowFirst, first, lowSecond));
+            _mm512_storeu_si512(low + w + 8, _mm512_permutex2var_epi64(lowFirst, second, lowSecond));
+            _mm512_storeu_si512(high + w, _mm512_permutex2var_epi64(highFirst, first, highSecond));
+            _mm512_storeu_si512(high + w + 8, _mm512_permutex2var_epi64(highFirst, second, highSecond));
+        }
+        return w;
+    }
+#endif
+
+    /**
+     * Computes the next generation of a packed row with a word function, handling the edge words.
+     *
+     * @param word Word function, taking the nine words of the neighbourhood
+     * @param interiorWords Kernel for the interior words, returning the word after the last one computed
+     */
+    template<typename TWord, typename TInterior>
+    static void packedRow(const TWord &word, const TInterior &interiorWords, const uint64_t *above,
+        const uint64_t *current, const uint64_t *below, uint64_t *out, const int words, const int cols,
+        const bool wrap) {
+        const int last = words - 1;
+        const int lastBit = (cols - 1) % 64;
+
+        // West neighbour of a cell is the bit before it, east neighbour is the bit after it
+        auto west = [&](const uint64_t *row, const int w) {
+            const uint64_t carry = w > 0 ? row[w - 1] >> 63 : wrap ? row[last] >> lastBit & 1 : 0;
+            return row[w] << 1 | carry;
+        };
+        auto east = [&](const uint64_t *row, const int w) {
+            uint64_t value = row[w] >> 1 | (w < last ? row[w + 1] << 63 : 0);
+            if (wrap && w == last)
+                value |= (row[0] & 1) << lastBit;
+            return value;
+        };
+        auto edge = [&](const int w) {
+            out[w] = word(west(above, w), above[w], east(above, w),
+                west(current, w), current[w], east(current, w),
+                west(below, w), below[w], east(below, w));
+        };
+
+        edge(0);
+        if (last > 0) {
+            interiorWords(1, last);
+            edge(last);
+        }
+
+        out[last] &= cols % 64 == 0 ? ~uint64_t{0} : (uint64_t{1} << (cols % 64)) - 1;
+    }
+
+    /**
+     * Expands a rule table to full words, for ruleWord.
+     *
+     * @param rule Rule
+     * @param leaves Expanded table
+     */
+    static void expandRule(const LifeLikeRule &rule, uint64_t (&leaves)[2][9]) {
+        for (int alive = 0; alive < 2; alive++) {
+            for (int n = 0; n <= 8; n++) {
+                leaves[alive][n] = rule.next(alive, n) ? ~uint64_t{0} : 0;
+            }
+        }
+    }
+
+    /**
+     * Computes the next generation of one packed row.
+     * The first and last words are computed by the scalar code, which handles the edges and wrapping,
+     * the words in between by the selected vectorized kernel.
+     *
+     * @param above Row above (zero row if out of the grid)
+     * @param current Row to compute
+     * @param below Row below (zero row if out of the grid)
+     * @param out Destination row
+     * @param words Number of words per row
+     * @param cols Number of columns (valid bits) in the row
+     * @param wrap If true, the first and last columns are adjacent
+     */
+    void StepKernel::stepRow(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+        const int words, const int cols, const bool wrap) {
+        packedRow(lifeWord, [&](const int begin, const int end) {
+            const int done = interior(above, current, below, out, begin, end);
+            interiorScalar(above, current, below, out, done, end);
+        }, above, current, below, out, words, cols, wrap);
+    }
+
+    /**
+     * Computes the next generation of a packed row under any outer-totalistic rule.
+     * Conway's rule uses its dedicated kernel, other rules the vectorized kernel of the rule table.
+     *
+     * @param above Row above (zero row if out of the grid)
+     * @param current Row to compute
+     * @param below Row below (zero row if out of the grid)
+     * @param out Destination row
+     * @param words Number of words per row
+     * @param cols Number of columns (valid bits) in the row
+     * @param wrap If true, the first and last columns are adjacent
+     * @param rule Rule
+     */
+    void StepKernel::stepRow(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+        const int words, const int cols, const bool wrap, const LifeLikeRule &rule) {
+        if (rule.isConway()) {
+            stepRow(above, current, below, out, words, cols, wrap);
+            return;
+        }
+
+        uint64_t leaves[2][9];
+        expandRule(rule, leaves);
+        auto word = [&](const uint64_t aw, const uint64_t ac, const uint64_t ae, const uint64_t mw, const uint64_t mc,
+            const uint64_t me, const uint64_t bw, const uint64_t bc, const uint64_t be) {
+            return ruleWord(leaves, aw, ac, ae, mw, mc, me, bw, bc, be);
+        };
+        packedRow(word, [&](const int begin, const int end) {
+            const uint64_t *const sources[3][3] = {
+                {above + begin - 1, above + begin, above + begin + 1},
+                {current + begin - 1, current + begin, current + begin + 1},
+                {below + begin - 1, below + begin, below + begin + 1}
+            };
+            runScalar(word, sources, out + begin, ruleKernel(sources, out + begin, end - begin, leaves), end - begin);
+        }, above, current, below, out, words, cols, wrap);
+    }
+
+    /**
+     * Computes the next generation of a column of words, one word per row.
+     * Each input column holds a halo row above and below the computed rows.
+     *
+     * @param west Column of words to the west (rows + 2 words)
+     * @param centre Column of words to compute (rows + 2 words)
+     * @param east Column of words to the east (rows + 2 words)
+     * @param out Destination column (rows words)
+     * @param rows Number of rows to compute
+     */
+    void StepKernel::stepBlock(const uint64_t *west, const uint64_t *centre, const uint64_t *east, uint64_t *out,
+        const int rows) {
+        for (int r = 0; r < rows; r++) {
+            out[r] = lifeWord(
+                centre[r] << 1 | west[r] >> 63, centre[r], centre[r] >> 1 | east[r] << 63,
+                centre[r + 1] << 1 | west[r + 1] >> 63, centre[r + 1], centre[r + 1] >> 1 | east[r + 1] << 63,
+                centre[r + 2] << 1 | west[r + 2] >> 63, centre[r + 2], centre[r + 2] >> 1 | east[r + 2] << 63);
+        }
+    }
+
+    /**
+     * Computes the next generation of a column of words under any outer-totalistic rule.
+     *
+     * @param west Column of words to the west (rows + 2 words)
+     * @param centre Column of words to compute (rows + 2 words)
+     * @param east Column of words to the east (rows + 2 words)
+     * @param out Destination column (rows words)
+     * @param rows Number of rows to compute
+     * @param rule Rule
+     */
+    void StepKernel::stepBlock(const uint64_t *west, const uint64_t *centre, const uint64_t *east, uint64_t *out,
+        const int rows, const LifeLikeRule &rule) {
+        if (rule.isConway()) {
+            stepBlock(west, centre, east, out, rows);
+            return;
+        }
+
+        // The rows of a column are consecutive words, so the run kernels step several rows at a time
+        uint64_t leaves[2][9];
+        expandRule(rule, leaves);
+        const uint64_t *const sources[3][3] = {{west, centre, east}, {west + 1, centre + 1, east + 1}, {west + 2, centre + 2, east + 2}};
+        runScalar([&](const uint64_t aw, const uint64_t ac, const uint64_t ae, const uint64_t mw, const uint64_t mc,
+            const uint64_t me, const uint64_t bw, const uint64_t bc, const uint64_t be) {
+            return ruleWord(leaves, aw, ac, ae, mw, mc, me, bw, bc, be);
+        }, sources, out, ruleKernel(sources, out, rows, leaves), rows);
+    }
+
+    /**
+     * Computes the next generation of a packed row under an isotropic rule.
+     * Outer-totalistic rules use the counting kernels, the others evaluate the circuit of the rule on 64 cells per
+     * word, several words at a time with the vectorized kernels.
+     *
+     * @param above Row above (zero row if out of the grid)
+     * @param current Row to compute
+     * @param below Row below (zero row if out of the grid)
+     * @param out Destination row
+     * @param words Number of words per row
+     * @param cols Number of columns (valid bits) in the row
+     * @param wrap If true, the first and last columns are adjacent
+     * @param rule Rule
+     */
+    void StepKernel::stepRow(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+        const int words, const int cols, const bool wrap, const IsotropicRule &rule) {
+        if (rule.isTotalistic()) {
+            stepRow(above, current, below, out, words, cols, wrap, *rule.getTotalistic());
+            return;
+        }
+
+        const auto &circuit = rule.getCircuit();
+        auto word = [&](const uint64_t aw, const uint64_t ac, const uint64_t ae, const uint64_t mw, const uint64_t mc,
+            const uint64_t me, const uint64_t bw, const uint64_t bc, const uint64_t be) {
+            const uint64_t inputs[9] = {aw, ac, ae, mw, mc, me, bw, bc, be};
+            return circuitWord(circuit, inputs);
+        };
+        packedRow(word, [&](const int begin, const int end) {
+            const uint64_t *const sources[3][3] = {
+                {above + begin - 1, above + begin, above + begin + 1},
+                {current + begin - 1, current + begin, current + begin + 1},
+                {below + begin - 1, below + begin, below + begin + 1}
+            };
+            const int done = circuit.empty() ? 0 : circuitKernel(sources, out + begin, end - begin, rule);
+            runScalar(word, sources, out + begin, done, end - begin);
+        }, above, current, below, out, words, cols, wrap);
+    }
+
+    /**
+     * Computes the next generation of a column of words under an isotropic rule.
+     *
+     * @param west Column of words to the west (rows + 2 words)
+     * @param centre Column of words to compute (rows + 2 words)
+     * @param east Column of words to the east (rows + 2 words)
+     * @param out Destination column (rows words)
+     * @param rows Number of rows to compute
+     * @param rule Rule
+     */
+    void StepKernel::stepBlock(const uint64_t *west, const uint64_t *centre, const uint64_t *east, uint64_t *out,
+        const int rows, const IsotropicRule &rule) {
+        if (rule.isTotalistic()) {
+            stepBlock(west, centre, east, out, rows, *rule.getTotalistic());
+            return;
+        }
+
+        const auto &circuit = rule.getCircuit();
+        const uint64_t *const sources[3][3] = {{west, centre, east}, {west + 1, centre + 1, east + 1}, {west + 2, centre + 2, east + 2}};
+        const int done = circuit.empty() ? 0 : circuitKernel(sources, out, rows, rule);
+        runScalar([&](const uint64_t aw, const uint64_t ac, const uint64_t ae, const uint64_t mw, const uint64_t mc,
+            const uint64_t me, const uint64_t bw, const uint64_t bc, const uint64_t be) {
+            const uint64_t inputs[9] = {aw, ac, ae, mw, mc, me, bw, bc, be};
+            return circuitWord(circuit, inputs);
+        }, sources, out, done, rows);
+    }
+
+    /**
+     * Computes the next generation of a bit-sliced row, one word per cell and one universe per bit.
+     * The neighbours of a cell are whole words, so the adders take them without shifting, and the loop over the
+     * interior cells is left to the compiler to vectorize.
+     *
+     * @param word Function computing 64 cells from their neighbourhood words
+     * @param above Row above (zero row if out of the grid)
+     * @param current Row to compute
+     * @param below Row below (zero row if out of the grid)
+     * @param out Destination row
+     * @param cols Number of cells in the row
+     * @param wrap If true, the first and last cells are adjacent
+     * @param active Universes to step, the others keep their cells
+     * @return Universes whose row changed
+     */
+    template<typename TWord>
+    static uint64_t lanesRow(const TWord &word, const uint64_t *above, const uint64_t *current, const uint64_t *below,
+        uint64_t *out, const int cols, const bool wrap, const uint64_t active) {
+        uint64_t changed = 0;
+        for (int c = 1; c < cols - 1; c++) {
+            const uint64_t next = word(above[c - 1], above[c], above[c + 1], current[c - 1], current[c], current[c + 1],
+                below[c - 1], below[c], below[c + 1]);
+            out[c] = (next & active) | (current[c] & ~active);
+            changed |= out[c] ^ current[c];
+        }
+
+        // First and last cells, whose neighbours past the edges wrap or are dead
+        const auto edge = [&](const int c) {
+            const int w = c > 0 ? c - 1 : wrap ? cols - 1 : -1;
+            const int e = c < cols - 1 ? c + 1 : wrap ? 0 : -1;
+            const auto at = [](const uint64_t *row, const int i) { return i < 0 ? 0 : row[i]; };
+            const uint64_t next = word(at(above, w), above[c], at(above, e), at(current, w), current[c], at(current, e),
+                at(below, w), below[c], at(below, e));
+            out[c] = (next & active) | (current[c] & ~active);
+            changed |= out[c] ^ current[c];
+        };
+        if (cols > 0)
+            edge(0);
+        if (cols > 1)
+            edge(cols - 1);
+        return changed;
+    }
+
+    /**
+     * Computes the next generation of a bit-sliced row under an isotropic rule: bit k of each word is a cell of the
+     * universe k, so one pass steps 64 independent universes.
+     *
+     * @param above Row above (zero row if out of the grid)
+     * @param current Row to compute
+     * @param below Row below (zero row if out of the grid)
+     * @param out Destination row
+     * @param cols Number of cells in the row
+     * @param wrap If true, the first and last cells are adjacent
+     * @param active Universes to step, the others keep their cells
+     * @param rule Rule
+     * @return Universes whose row changed
+     */
+    uint64_t StepKernel::stepLanes(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+        const int cols, const bool wrap, const uint64_t active, const IsotropicRule &rule) {
+        if (rule.isTotalistic() && rule.getTotalistic()->isConway())
+            return lanesRow(lifeWord, above, current, below, out, cols, wrap, active);
+
+        if (rule.isTotalistic()) {
+            uint64_t leaves[2][9];
+            expandRule(*rule.getTotalistic(), leaves);
+            return lanesRow([&](const uint64_t aw, const uint64_t ac, const uint64_t ae, const uint64_t mw,
+                const uint64_t mc, const uint64_t me, const uint64_t bw, const uint64_t bc, const uint64_t be) {
+                return ruleWord(leaves, aw, ac, ae, mw, mc, me, bw, bc, be);
+            }, above, current, below, out, cols, wrap, active);
+        }
+
+        const auto &circuit = rule.getCircuit();
+        return lanesRow([&](const uint64_t aw, const uint64_t ac, const uint64_t ae, const uint64_t mw,
+            const uint64_t mc, const uint64_t me, const uint64_t bw, const uint64_t bc, const uint64_t be) {
+            const uint64_t inputs[9] = {aw, ac, ae, mw, mc, me, bw, bc, be};
+            return circuitWord(circuit, inputs);
+        }, above, current, below, out, cols, wrap, active);
+    }
+
+    /**
+     * Packs the living states of a multi-state row into a bitplane.
+     *
+     * @param states Row of states
+     * @param plane Destination row, one bit per cell
+     * @param cols Number of columns
+     * @param rule Rule, telling which states are alive
+     */
+    void StepKernel::packStates(const uint8_t *states, uint64_t *plane, const int cols, const GenerationsRule &rule) {
+        const uint8_t mask = rule.isHistory() ? 1 : 0xFF;
+        for (int j = packKernel(states, plane, cols, mask); j < cols; j++) {
+            if (j % 64 == 0)
+                plane[j / 64] = 0;
+            plane[j / 64] |= static_cast<uint64_t>((states[j] & mask) == 1) << (j % 64);
+        }
+    }
+
+    /**
+     * Computes the next states of a multi-state row, from the next generation of its living plane.
+     * Where the plane is set, dead cells are born and living cells survive. Elsewhere, living cells die or decay.
+     *
+     * @param states Row of states
+     * @param next Next generation of the living plane of the row
+     * @param out Destination row of states
+     * @param cols Number of columns
+     * @param rule Rule
+     */
+    void StepKernel::stepStates(const uint8_t *states, const uint64_t *next, uint8_t *out, const int cols,
+        const GenerationsRule &rule) {
+        for (int j = statesKernel(states, next, out, cols, rule.getStates(), rule.isHistory()); j < cols; j++) {
+            out[j] = nextState(states[j], next[j / 64] >> (j % 64) & 1, rule.getStates(), rule.isHistory());
+        }
+    }
+
+    /**
+     * Draws the random words of a packed row, two words per cell word.
+     * Word w is drawn from the Philox block of counter (w, row, generation, stream), whatever the kernel.
+     *
+     * @param low Destination of the first word of each block
+     * @param high Destination of the second word of each block
+     * @param words Number of words
+     * @param row Row
+     * @param generation Generation
+     * @param stream Stream
+     * @param key Key (seed)
+     */
+    void StepKernel::randomRow(uint64_t *low, uint64_t *high, const int words, const uint32_t row,
+        const uint32_t generation, const uint32_t stream, const uint64_t key) {
+        for (int w = randomKernel(low, high, words, row, generation, stream, key); w < words; w++) {
+            const auto block = Random::philox({static_cast<uint32_t>(w), row, generation, stream}, key);
+            low[w] = block[0] | static_cast<uint64_t>(block[1]) << 32;
+            high[w] = block[2] | static_cast<uint64_t>(block[3]) << 32;
+        }
+    }
+
+    /**
+     * Forces a kernel variant, if the CPU supports it.
+     *
+     * @param variant Kernel variant
+     * @return True if the variant is now in use, false otherwise
+     */
+    bool StepKernel::setVariant(const Variant variant) {
+        if (!isSupported(variant))
+            return false;
+        StepKernel::variant = variant;
+        interior = getInterior(variant);
+        packKernel = getPack(variant);
+        statesKernel = getStates(variant);
+        randomKernel = getRandom(variant);
+        ruleKernel = getRuleKernel(variant);
+        circuitKernel = getCircuitKernel(variant);
+        return true;
+    }
+
+    /**
+     * Checks if the CPU (and the build) supports a kernel variant.
+     *
+     * @param variant Kernel variant
+     * @return True if supported, false otherwise
+     */
+    bool StepKernel::isSupported(const Variant variant) {
+        switch (variant) {
+            case Variant::SCALAR:
+                return true;
+#ifdef STEPKERNEL_X86
+            case Variant::SSE2:
+                return __builtin_cpu_supports("sse2");
+            case Variant::AVX2:
+                return __builtin_cpu_supports("avx2");
+            case Variant::AVX512:
+                return __builtin_cpu_supports("avx512f");
+#endif
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Gets the display name of a kernel variant.
+     *
+     * @param variant Kernel variant
+     * @return Name of the variant
+     */
+    const char *StepKernel::getVariantName(const Variant variant) {
+        switch (variant) {
+            case Variant::SSE2:
+                return "SSE2";
+            case Variant::AVX2:
+                return "AVX2";
+            case Variant::AVX512:
+                return "AVX-512";
+            default:
+                return "scalar";
+        }
+    }
+
+    /**
+     * Picks the widest kernel supported by the CPU.
+     *
+     * @return Kernel variant
+     */
+    StepKernel::Variant StepKernel::detectVariant() {
+#ifdef STEPKERNEL_X86
+        __builtin_cpu_init();
+#endif
+        for (const auto candidate : {Variant::AVX512, Variant::AVX2, Variant::SSE2}) {
+            if (isSupported(candidate))
+                return candidate;
+        }
+        return Variant::SCALAR;
+    }
+
+    /**
+     * Gets the interior kernel of a variant.
+     *
+     * @param variant Kernel variant
+     * @return Interior kernel
+     */
+    StepKernel::InteriorFunction StepKernel::getInterior(const Variant variant) {
+        switch (variant) {
+#ifdef STEPKERNEL_X86
+            case Variant::SSE2:
+                return interiorSSE2;
+            case Variant::AVX2:
+                return interiorAVX2;
+            case Variant::AVX512:
+                return interiorAVX512;
+#endif
+            default:
+                return interiorScalar;
+        }
+    }
+
+    /**
+     * Gets the packing kernel of a variant.
+     * Byte masks of 64 cells need AVX-512BW, so the AVX-512 variant keeps the AVX2 byte kernels.
+     *
+     * @param variant Kernel variant
+     * @return Packing kernel
+     */
+    StepKernel::PackFunction StepKernel::getPack(const Variant variant) {
+        switch (variant) {
+#ifdef STEPKERNEL_X86
+            case Variant::SSE2:
+                return packSSE2;
+            case Variant::AVX2:
+            case Variant::AVX512:
+                return packAVX2;
+#endif
+            default:
+                return packScalar;
+        }
+    }
+
+    /**
+     * Gets the multi-state kernel of a variant.
+     *
+     * @param variant Kernel variant
+     * @return Multi-state kernel
+     */
+    StepKernel::StatesFunction StepKernel::getStates(const Variant variant) {
+        switch (variant) {
+#ifdef STEPKERNEL_X86
+            case Variant::SSE2:
+                return statesSSE2;
+            case Variant::AVX2:
+            case Variant::AVX512:
+                return statesAVX2;
+#endif
+            default:
+                return statesScalar;
+        }
+    }
+
+    /**
+     * Gets the random number kernel of a variant.
+     *
+     * @param variant Kernel variant
+     * @return Random number kernel
+     */
+    StepKernel::RandomFunction StepKernel::getRandom(const Variant variant) {
+        switch (variant) {
+#ifdef STEPKERNEL_X86
+            case Variant::SSE2:
+                return randomSSE2;
+            case Variant::AVX2:
+                return randomAVX2;
+            case Variant::AVX512:
+                return randomAVX512;
+#endif
+            default:
+                return randomScalar;
+        }
+    }
+
+    /**
+     * Gets the outer-totalistic kernel of a variant.
+     *
+     * @param variant Kernel variant
+     * @return Outer-totalistic kernel
+     */
+    StepKernel::RuleFunction StepKernel::getRuleKernel(const Variant variant) {
+        switch (variant) {
+#ifdef STEPKERNEL_X86
+            case Variant::SSE2:
+                return ruleSSE2;
+            case Variant::AVX2:
+                return ruleAVX2;
+            case Variant::AVX512:
+                return ruleAVX512;
+#endif
+            default:
+                return ruleScalar;
+        }
+    }
+
+    /**
+     * Gets the isotropic kernel of a variant.
+     *
+     * @param variant Kernel variant
+     * @return Isotropic kernel
+     */
+    StepKernel::CircuitFunction StepKernel::getCircuitKernel(const Variant variant) {
+        switch (variant) {
+#ifdef STEPKERNEL_X86
+            case Variant::SSE2:
+                return circuitSSE2;
+            case Variant::AVX2:
+                return circuitAVX2;
+            case Variant::AVX512:
+                return circuitAVX512;
+#endif
+            default:
+                return circuitScalar;
+        }
+    }
+}
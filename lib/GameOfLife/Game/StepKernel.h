@@ -0,0 +1,79 @@
+#ifndef STEPKERNEL_H
+#define STEPKERNEL_H
+#include <cstdint>
+
+namespace GameOfLife::Game {
+    class LifeLikeRule;
+    class IsotropicRule;
+    class GenerationsRule;
+
+    /**
+     * Life step kernels for packed rows (one bit per cell, 64 cells per word) and bit-sliced rows (one word per cell,
+     * one bit per universe), byte kernels for multi-state rows, and random number kernels filling packed rows.
+     * The vectorized variant is picked at startup from the CPU features, the scalar variant is always available.
+     */
+    class StepKernel {
+    public:
+        enum class Variant {
+            SCALAR,
+            SSE2,
+            AVX2,
+            AVX512
+        };
+
+        static void stepRow(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+            int words, int cols, bool wrap);
+        static void stepRow(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+            int words, int cols, bool wrap, const LifeLikeRule &rule);
+        static void stepBlock(const uint64_t *west, const uint64_t *centre, const uint64_t *east, uint64_t *out, int rows);
+        static void stepBlock(const uint64_t *west, const uint64_t *centre, const uint64_t *east, uint64_t *out, int rows,
+            const LifeLikeRule &rule);
+        static void stepRow(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+            int words, int cols, bool wrap, const IsotropicRule &rule);
+        static void stepBlock(const uint64_t *west, const uint64_t *centre, const uint64_t *east, uint64_t *out, int rows,
+            const IsotropicRule &rule);
+        static uint64_t stepLanes(const uint64_t *above, const uint64_t *current, const uint64_t *below, uint64_t *out,
+            int cols, bool wrap, uint64_t active, const IsotropicRule &rule);
+        static void packStates(const uint8_t *states, uint64_t *plane, int cols, const GenerationsRule &rule);
+        static void stepStates(const uint8_t *states, const uint64_t *next, uint8_t *out, int cols, const GenerationsRule &rule);
+        static void randomRow(uint64_t *low, uint64_t *high, int words, uint32_t row, uint32_t generation, uint32_t stream,
+            uint64_t key);
+
+        [[nodiscard]] static Variant getVariant() { return variant; }
+        static bool setVariant(Variant variant);
+        [[nodiscard]] static bool isSupported(Variant variant);
+        [[nodiscard]] static const char *getVariantName(Variant variant);
+
+    private:
+        using InteriorFunction = int (*)(const uint64_t *above, const uint64_t *current, const uint64_t *below,
+            uint64_t *out, int begin, int end);
+
+        using PackFunction = int (*)(const uint8_t *states, uint64_t *plane, int cols, uint8_t mask);
+        using StatesFunction = int (*)(const uint8_t *states, const uint64_t *next, uint8_t *out, int cols, int count,
+            bool history);
+        using RandomFunction = int (*)(uint64_t *low, uint64_t *high, int words, uint32_t row, uint32_t generation,
+            uint32_t stream, uint64_t key);
+        using RuleFunction = int (*)(const uint64_t *const (&sources)[3][3], uint64_t *out, int count,
+            const uint64_t (&leaves)[2][9]);
+        using CircuitFunction = int (*)(const uint64_t *const (&sources)[3][3], uint64_t *out, int count,
+            const IsotropicRule &rule);
+
+        static Variant variant;
+        static InteriorFunction interior;
+        static PackFunction packKernel;
+        static StatesFunction statesKernel;
+        static RandomFunction randomKernel;
+        static RuleFunction ruleKernel;
+        static CircuitFunction circuitKernel;
+
+        static Variant detectVariant();
+        static InteriorFunction getInterior(Variant variant);
+        static PackFunction getPack(Variant variant);
+        static StatesFunction getStates(Variant variant);
+        static RandomFunction getRandom(Variant variant);
+        static RuleFunction getRuleKernel(Variant variant);
+        static CircuitFunction getCircuitKernel(Variant variant);
+    };
+}
+
+#endif //STEPKERNEL_H
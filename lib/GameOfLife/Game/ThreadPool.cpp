@@ -0,0 +1,140 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace GameOfLife::Game {
+    /**
+     * Starts the worker threads.
+     *
+     * @param workers Number of workers including the calling thread, 0 for one per hardware thread
+     */
+    ThreadPool::ThreadPool(int workers) {
+        if (workers <= 0)
+            workers = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+        for (int i = 0; i < workers; i++) {
+            queues.push_back(std::make_unique<Queue>());
+        }
+        for (int i = 1; i < workers; i++) {
+            threads.emplace_back(&ThreadPool::work, this, i);
+        }
+    }
+
+    /**
+     * Stops and joins the worker threads.
+     */
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    /**
+     * Runs a task over [0, count) split in chunks, and waits for every chunk to be done.
+     *
+     * @param count Number of items
+     * @param chunk Number of items per range
+     * @param task Task to run on each range
+     */
+    void ThreadPool::parallelFor(const size_t count, size_t chunk, const Task &task) {
+        if (count == 0)
+            return;
+        chunk = std::max<size_t>(chunk, 1);
+
+        std::lock_guard runLock(runMutex);
+
+        // Publish the task before any range, a worker may still be looking for ranges of the previous batch
+        const size_t ranges = (count + chunk - 1) / chunk;
+        {
+            std::lock_guard lock(mutex);
+            this->task = &task;
+            remaining = ranges;
+            batch++;
+        }
+
+        // Deal the ranges to the workers, in contiguous blocks so each worker starts on neighboring items
+        const size_t perWorker = (ranges + queues.size() - 1) / queues.size();
+        for (size_t i = 0; i < ranges; i++) {
+            Queue &queue = *queues[i / perWorker];
+            std::lock_guard lock(queue.mutex);
+            queue.ranges.emplace_back(i * chunk, std::min(count, (i + 1) * chunk));
+        }
+        wake.notify_all();
+
+        runRanges(0);
+
+        std::unique_lock lock(mutex);
+        done.wait(lock, [this] { return remaining == 0; });
+        this->task = nullptr;
+    }
+
+    /**
+     * Worker thread loop.
+     *
+     * @param worker Worker index
+     */
+    void ThreadPool::work(const int worker) {
+        uint64_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock lock(mutex);
+                wake.wait(lock, [&] { return stopping || batch != seen; });
+                if (stopping)
+                    return;
+                seen = batch;
+            }
+            runRanges(worker);
+        }
+    }
+
+    /**
+     * Runs ranges until none is left to take.
+     *
+     * @param worker Worker index
+     */
+    void ThreadPool::runRanges(const int worker) {
+        std::pair<size_t, size_t> range;
+        while (takeRange(worker, range)) {
+            (*task)(range.first, range.second, worker);
+            if (--remaining == 0) {
+                std::lock_guard lock(mutex);
+                done.notify_all();
+            }
+        }
+    }
+
+    /**
+     * Takes a range from the worker's own deque, or steals one from another worker.
+     *
+     * @param worker Worker index
+     * @param range Taken range
+     * @return True if a range was taken, false if all deques are empty
+     */
+    bool ThreadPool::takeRange(const int worker, std::pair<size_t, size_t> &range) {
+        {
+            Queue &own = *queues[worker];
+            std::lock_guard lock(own.mutex);
+            if (!own.ranges.empty()) {
+                range = own.ranges.back();
+                own.ranges.pop_back();
+                return true;
+            }
+        }
+
+        for (size_t i = 1; i < queues.size(); i++) {
+            Queue &victim = *queues[(worker + i) % queues.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.ranges.empty()) {
+                range = victim.ranges.front();
+                victim.ranges.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+}
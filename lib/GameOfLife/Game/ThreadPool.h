@@ -0,0 +1,60 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace GameOfLife::Game {
+    /**
+     * Long-lived pool of worker threads running chunked ranges of a loop.
+     * Each worker owns a deque of ranges, takes work from its back, and steals from the front of the others.
+     * The calling thread takes part as worker 0.
+     */
+    class ThreadPool {
+    public:
+        /**
+         * Task run on a range [begin, end) by a worker.
+         */
+        using Task = std::function<void(size_t begin, size_t end, int worker)>;
+
+        explicit ThreadPool(int workers = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        void parallelFor(size_t count, size_t chunk, const Task &task);
+
+        [[nodiscard]] int getWorkerCount() const { return static_cast<int>(queues.size()); }
+
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<std::pair<size_t, size_t>> ranges;
+        };
+
+        std::vector<std::thread> threads;
+        std::vector<std::unique_ptr<Queue>> queues;
+
+        std::mutex mutex;
+        std::mutex runMutex;
+        std::condition_variable wake;
+        std::condition_variable done;
+        const Task *task = nullptr;
+        uint64_t batch = 0;
+        std::atomic<size_t> remaining = 0;
+        bool stopping = false;
+
+        void work(int worker);
+        void runRanges(int worker);
+        bool takeRange(int worker, std::pair<size_t, size_t> &range);
+    };
+}
+
+#endif //THREADPOOL_H
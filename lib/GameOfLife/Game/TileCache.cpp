@@ -0,0 +1,139 @@
+#include "TileCache.h"
+
+#include <bit>
+
+namespace GameOfLife::Game {
+    /**
+     * Creates a cache.
+     *
+     * @param capacity Maximum number of tiles, 0 disables the cache
+     */
+    TileCache::TileCache(const size_t capacity) : capacity(capacity) {}
+
+    /**
+     * Makes the key of a tile from the columns of words used to step it, each with a row above and below the tile.
+     * Only the last bit of the west words and the first bit of the east words border the tile, so only these are kept.
+     *
+     * @param west Column of words west of the tile
+     * @param centre Column of words of the tile
+     * @param east Column of words east of the tile
+     * @return Key of the padded tile
+     */
+    TileCache::Key TileCache::makeKey(const uint64_t *west, const uint64_t *centre, const uint64_t *east) {
+        Key key{};
+        for (int r = 0; r < TILE_SIZE + 2; r++) {
+            key[r] = centre[r];
+            key[TILE_SIZE + 2 + r / 64] |= (west[r] >> 63) << (r % 64);
+            key[TILE_SIZE + 4 + r / 64] |= (east[r] & 1) << (r % 64);
+        }
+        return key;
+    }
+
+    /**
+     * Hashes a key, mixing its words in four independent lanes so the multiplications overlap, then combining the
+     * lanes with a SplitMix64 finalizer.
+     *
+     * @param key Key of a padded tile
+     * @return Hash of the key
+     */
+    uint64_t TileCache::hashKey(const Key &key) {
+        uint64_t lanes[4] = {0, 1, 2, 3};
+        int w = 0;
+        for (; w + 4 <= KEY_WORDS; w += 4) {
+            for (int l = 0; l < 4; l++) {
+                lanes[l] = (std::rotl(lanes[l], 23) ^ key[w + l]) * 0x9E3779B97F4A7C15;
+            }
+        }
+        for (; w < KEY_WORDS; w++) {
+            lanes[w % 4] = (std::rotl(lanes[w % 4], 23) ^ key[w]) * 0x9E3779B97F4A7C15;
+        }
+        uint64_t hash = lanes[0] ^ std::rotl(lanes[1], 16) ^ std::rotl(lanes[2], 32) ^ std::rotl(lanes[3], 48);
+        hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9;
+        hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EB;
+        return hash ^ (hash >> 31);
+    }
+
+    /**
+     * Looks up the next state of a padded tile. The whole key is compared, so a hash collision is only a miss.
+     *
+     * @param key Key of the padded tile
+     * @param hash Hash of the key
+     * @return Next state of the tile, or nullptr if it is not cached
+     */
+    const TileCache::Tile *TileCache::find(const Key &key, const uint64_t hash) {
+        const auto it = index.find(hash);
+        if (it == index.end() || entries[it->second].key != key) {
+            misses++;
+            return nullptr;
+        }
+        Entry &entry = entries[it->second];
+        entry.referenced = true;
+        hits++;
+        return &entry.next;
+    }
+
+    /**
+     * Stores the next state of a padded tile. Once the cache is full, the hand sweeps the entries, clearing their
+     * reference bits, and replaces the first one that was not hit since the last sweep.
+     *
+     * @param key Key of the padded tile
+     * @param hash Hash of the key
+     * @param next Next state of the tile
+     */
+    void TileCache::insert(const Key &key, const uint64_t hash, const Tile &next) {
+        if (capacity == 0)
+            return;
+
+        // A key with the same hash is replaced
+        size_t slot;
+        if (const auto it = index.find(hash); it != index.end())
+            slot = it->second;
+        else if (entries.size() < capacity) {
+            slot = entries.size();
+            entries.emplace_back();
+        }
+        else {
+            while (entries[hand].referenced) {
+                entries[hand].referenced = false;
+                hand = (hand + 1) % entries.size();
+            }
+            slot = hand;
+            hand = (hand + 1) % entries.size();
+            index.erase(entries[slot].hash);
+        }
+
+        entries[slot] = {key, next, hash, false};
+        index[hash] = static_cast<uint32_t>(slot);
+    }
+
+    /**
+     * Removes every tile and resets the statistics, as when the rule changes.
+     */
+    void TileCache::clear() {
+        entries.clear();
+        index.clear();
+        hand = 0;
+        hits = 0;
+        misses = 0;
+    }
+
+    /**
+     * Sets the maximum number of tiles, clearing the cache.
+     *
+     * @param capacity Maximum number of tiles, 0 disables the cache
+     */
+    void TileCache::setCapacity(const size_t capacity) {
+        this->capacity = capacity;
+        clear();
+        entries.shrink_to_fit();
+    }
+
+    /**
+     * Gets the share of the lookups that found their tile.
+     *
+     * @return Hit rate, between 0 and 1
+     */
+    double TileCache::getHitRate() const {
+        return hits + misses == 0 ? 0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+    }
+}
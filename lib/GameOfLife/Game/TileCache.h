@@ -0,0 +1,63 @@
+#ifndef TILECACHE_H
+#define TILECACHE_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#define TILE_SIZE 64
+
+namespace GameOfLife::Game {
+    /**
+     * Bounded cache of tile transitions: the next state of a 64x64 bit-packed tile, keyed by the tile and the border of
+     * one cell around it. Oscillators and still lifes give the same padded tiles generation after generation, so their
+     * next states are looked up instead of computed.
+     * Entries are evicted with the CLOCK algorithm: a hit gives an entry a second chance, so the tiles that were seen
+     * once are evicted first.
+     */
+    class TileCache {
+    public:
+        // Rows of the tile with the row above and below, then the west and east border columns as bits
+        static constexpr int KEY_WORDS = TILE_SIZE + 2 + 4;
+
+        using Key = std::array<uint64_t, KEY_WORDS>;
+        using Tile = std::array<uint64_t, TILE_SIZE>;
+
+    private:
+        struct Entry {
+            Key key;
+            Tile next;
+            uint64_t hash;
+            bool referenced;
+        };
+
+        std::vector<Entry> entries;
+        std::unordered_map<uint64_t, uint32_t> index;
+        size_t capacity;
+        size_t hand = 0;
+
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+
+    public:
+        explicit TileCache(size_t capacity = 0);
+
+        static Key makeKey(const uint64_t *west, const uint64_t *centre, const uint64_t *east);
+        static uint64_t hashKey(const Key &key);
+
+        const Tile *find(const Key &key, uint64_t hash);
+        void insert(const Key &key, uint64_t hash, const Tile &next);
+        void clear();
+
+        void setCapacity(size_t capacity);
+        [[nodiscard]] size_t getCapacity() const { return capacity; }
+        [[nodiscard]] bool isEnabled() const { return capacity > 0; }
+        [[nodiscard]] size_t getSize() const { return entries.size(); }
+        [[nodiscard]] uint64_t getHits() const { return hits; }
+        [[nodiscard]] uint64_t getMisses() const { return misses; }
+        [[nodiscard]] double getHitRate() const;
+    };
+}
+
+#endif //TILECACHE_H
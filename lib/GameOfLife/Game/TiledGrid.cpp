@@ -0,0 +1,413 @@
+#include "TiledGrid.h"
+
+#include <algorithm>
+#include <bit>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#include "StepKernel.h"
+
+namespace GameOfLife::Game {
+    /**
+     * Constructs an empty universe with a visible window of the specified size.
+     *
+     * @param rows Number of visible rows
+     * @param cols Number of visible columns
+     */
+    TiledGrid::TiledGrid(const int rows, const int cols) : rows(rows), cols(cols) {}
+
+    /**
+     * Constructs a universe from existing cells, placed at the top left of the visible window.
+     *
+     * @param cells Cells
+     * @param rows Number of rows
+     * @param cols Number of columns
+     */
+    TiledGrid::TiledGrid(const std::vector<std::vector<bool>> &cells, const int rows, const int cols) :
+    TiledGrid(rows, cols) {
+        insert(cells, 0, 0, true);
+    }
+
+    /**
+     * Gets the key of a tile in the tile map.
+     *
+     * @param tileRow Tile row
+     * @param tileCol Tile column
+     * @return Tile key
+     */
+    int64_t TiledGrid::tileKey(const int64_t tileRow, const int64_t tileCol) {
+        return static_cast<int64_t>(static_cast<uint64_t>(tileRow) << 32 | static_cast<uint32_t>(tileCol));
+    }
+
+    /**
+     * Finds a tile by tile coordinate.
+     *
+     * @param tileRow Tile row
+     * @param tileCol Tile column
+     * @return The tile, or nullptr if it is empty
+     */
+    const TiledGrid::Tile *TiledGrid::findTile(const int64_t tileRow, const int64_t tileCol) const {
+        const auto it = tiles.find(tileKey(tileRow, tileCol));
+        return it == tiles.end() ? nullptr : &it->second;
+    }
+
+    /**
+     * Marks a tile to be stepped on the next generation, along with its neighbors.
+     *
+     * @param key Tile key
+     */
+    void TiledGrid::activate(const int64_t key) {
+        if (activeTiles.empty() || activeTiles.back() != key)
+            activeTiles.push_back(key);
+    }
+
+    /**
+     * Sets the cell at the specified row and column to be alive or dead.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param alive Alive status
+     */
+    void TiledGrid::setAlive(const int row, const int col, const bool alive) {
+        const int64_t y = originRow + row;
+        const int64_t x = originCol + col;
+        const int64_t key = tileKey(y >> 6, x >> 6);
+        const uint64_t bit = uint64_t{1} << (x & 63);
+
+        if (alive) {
+            uint64_t &word = tiles[key][y & 63];
+            if (word & bit)
+                return;
+            word |= bit;
+            population++;
+        } else {
+            const auto it = tiles.find(key);
+            if (it == tiles.end() || !(it->second[y & 63] & bit))
+                return;
+            it->second[y & 63] &= ~bit;
+            population--;
+
+            // Free the tile if it is now empty
+            if (std::all_of(it->second.begin(), it->second.end(), [](const uint64_t w) { return w == 0; }))
+                tiles.erase(it);
+        }
+        activate(key);
+    }
+
+    /**
+     * Checks if the cell at the specified row and column is alive.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @return True if the cell is alive, false otherwise
+     */
+    bool TiledGrid::isAlive(const int row, const int col) const {
+        const int64_t y = originRow + row;
+        const int64_t x = originCol + col;
+        const Tile *tile = findTile(y >> 6, x >> 6);
+        return tile && (*tile)[y & 63] >> (x & 63) & 1;
+    }
+
+    /**
+     * Counts the number of living neighbors around the cell at the specified row and column.
+     * The universe is unbounded, so it never wraps.
+     *
+     * @param row Cell row
+     * @param col Cell column
+     * @param wrap Unused
+     * @return Number of living neighbors
+     */
+    int TiledGrid::countNeighbors(const int row, const int col, [[maybe_unused]] const bool wrap) const {
+        int count = 0;
+        for (int i = row - 1; i <= row + 1; i++) {
+            for (int j = col - 1; j <= col + 1; j++) {
+                if (i != row || j != col)
+                    count += isAlive(i, j);
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Steps the universe by one generation.
+     * A tile can only change if itself or one of its neighbors changed during the previous generation,
+     * so only these tiles are computed, or looked up in the tile cache when it is enabled.
+     */
+    void TiledGrid::step() {
+        // Tiles to compute: the active tiles and their neighbors
+        std::vector<int64_t> candidates;
+        candidates.reserve(activeTiles.size() * 9);
+        for (const int64_t key : activeTiles) {
+            const int64_t tileRow = key >> 32;
+            const int64_t tileCol = static_cast<int32_t>(key);
+            for (int i = -1; i <= 1; i++) {
+                for (int j = -1; j <= 1; j++) {
+                    candidates.push_back(tileKey(tileRow + i, tileCol + j));
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        // Compute the next state of the candidates, keeping only the tiles that changed
+        static const Tile emptyTile{};
+        std::vector<std::pair<int64_t, Tile>> changedTiles;
+        for (const int64_t key : candidates) {
+            const int64_t tileRow = key >> 32;
+            const int64_t tileCol = static_cast<int32_t>(key);
+
+            const Tile *neighborhood[3][3];
+            bool empty = true;
+            for (int i = 0; i < 3; i++) {
+                for (int j = 0; j < 3; j++) {
+                    neighborhood[i][j] = findTile(tileRow + i - 1, tileCol + j - 1);
+                    empty &= neighborhood[i][j] == nullptr;
+                }
+            }
+            if (empty)
+                continue;
+
+            // Columns of words with a halo row above and below
+            std::array<uint64_t, TILE_SIZE + 2> columns[3];
+            for (int j = 0; j < 3; j++) {
+                const Tile &above = neighborhood[0][j] ? *neighborhood[0][j] : emptyTile;
+                const Tile &centre = neighborhood[1][j] ? *neighborhood[1][j] : emptyTile;
+                const Tile &below = neighborhood[2][j] ? *neighborhood[2][j] : emptyTile;
+                columns[j][0] = above[TILE_SIZE - 1];
+                std::copy(centre.begin(), centre.end(), columns[j].begin() + 1);
+                columns[j][TILE_SIZE + 1] = below[0];
+            }
+
+            // Look the padded tile up in the cache, else compute it
+            Tile result;
+            if (cache.isEnabled()) {
+                const TileCache::Key cacheKey = TileCache::makeKey(columns[0].data(), columns[1].data(), columns[2].data());
+                const uint64_t hash = TileCache::hashKey(cacheKey);
+                if (const Tile *cached = cache.find(cacheKey, hash))
+                    result = *cached;
+                else {
+                    StepKernel::stepBlock(columns[0].data(), columns[1].data(), columns[2].data(), result.data(), TILE_SIZE, rule);
+                    cache.insert(cacheKey, hash, result);
+                }
+            }
+            else
+                StepKernel::stepBlock(columns[0].data(), columns[1].data(), columns[2].data(), result.data(), TILE_SIZE, rule);
+
+            const Tile &current = neighborhood[1][1] ? *neighborhood[1][1] : emptyTile;
+            if (result != current)
+                changedTiles.emplace_back(key, result);
+        }
+
+        // Apply the changes, freeing the tiles that became empty
+        activeTiles.clear();
+        for (const auto &[key, result] : changedTiles) {
+            const auto it = tiles.find(key);
+            for (int r = 0; r < TILE_SIZE; r++) {
+                population += std::popcount(result[r]);
+                if (it != tiles.end())
+                    population -= std::popcount(it->second[r]);
+            }
+
+            if (result == emptyTile)
+                tiles.erase(key);
+            else
+                tiles[key] = result;
+            activeTiles.push_back(key);
+        }
+
+        generation++;
+    }
+
+    /**
+     * Steps the universe by one generation.
+     *
+     * @param wrap Unused, the universe is unbounded
+     */
+    void TiledGrid::step([[maybe_unused]] const bool wrap) {
+        step();
+    }
+
+    /**
+     * Steps the universe by one generation.
+     *
+     * @param wrap Unused, the universe is unbounded
+     * @param dynamic Unused, the universe is unbounded
+     */
+    void TiledGrid::step([[maybe_unused]] const bool wrap, [[maybe_unused]] const bool dynamic) {
+        step();
+    }
+
+    /**
+     * Moves the visible window, adding rows and columns to the north, east, south, and west.
+     *
+     * @param addNorth Number of rows to add to the north
+     * @param addEast Number of columns to add to the east
+     * @param addSouth Number of rows to add to the south
+     * @param addWest Number of columns to add to the west
+     */
+    void TiledGrid::resize(const int addNorth, const int addEast, const int addSouth, const int addWest) {
+        // Argument check
+        if (addNorth < 0 || addEast < 0 || addSouth < 0 || addWest < 0) {
+            throw std::invalid_argument("The number of rows and columns to add must be positive.");
+        }
+
+        originRow -= addNorth;
+        originCol -= addWest;
+        rows += addNorth + addSouth;
+        cols += addEast + addWest;
+    }
+
+    /**
+     * Inserts a pattern into the universe.
+     *
+     * @param cells The pattern to insert
+     * @param row The row to insert the pattern at
+     * @param col The column to insert the pattern at
+     * @param hollow If true, only the living cells will be inserted
+     */
+    void TiledGrid::insert(const std::vector<std::vector<bool>> &cells, const int row, const int col, const bool hollow) {
+        for (int i = 0; i < static_cast<int>(cells.size()); ++i) {
+            for (int j = 0; j < static_cast<int>(cells[i].size()); ++j) {
+                if (!hollow || cells[i][j])
+                    setAlive(row + i, col + j, cells[i][j]);
+            }
+        }
+    }
+
+    /**
+     * Randomizes the visible window with the specified probability of a cell being alive.
+     *
+     * @param aliveProbability Probability of a cell being alive
+     */
+    void TiledGrid::randomize(const float aliveProbability) {
+        if (aliveProbability < 0 || aliveProbability > 1)
+            return;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                if ((rand() % 100) < aliveProbability * 100)
+                    setAlive(i, j, true);
+            }
+        }
+    }
+
+    /**
+     * Clears the universe.
+     */
+    void TiledGrid::clear() {
+        tiles.clear();
+        activeTiles.clear();
+        population = 0;
+    }
+
+    /**
+     * Prints the visible window to the console.
+     */
+    void TiledGrid::print() const {
+        print(0, 0, rows, cols);
+    }
+
+    /**
+     * Prints a section of the universe to the console.
+     *
+     * @param fromRow The starting row
+     * @param fromCol The starting column
+     * @param toRow The ending row
+     * @param toCol The ending column
+     */
+    void TiledGrid::print(const int fromRow, const int fromCol, const int toRow, const int toCol) const {
+        for (int i = fromRow; i < toRow; i++) {
+            for (int j = fromCol; j < toCol; j++) {
+                std::cout << (isAlive(i, j) ? 'O' : '.') << ' ';
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    /**
+     * Gets the visible window as a 2D vector.
+     *
+     * @return Visible cells
+     */
+    std::vector<std::vector<bool>> TiledGrid::getCells() const {
+        std::vector visible(rows, std::vector<bool>(cols));
+        for (const auto &[row, col] : getLivingCells()) {
+            visible[row][col] = true;
+        }
+        return visible;
+    }
+
+    /**
+     * Gets the coordinates of the living cells in the visible window.
+     *
+     * @return Set of living cells
+     */
+    CoordinateSet TiledGrid::getLivingCells() const {
+        CoordinateSet living;
+        for (const auto &[key, tile] : tiles) {
+            const int64_t top = (key >> 32) * TILE_SIZE - originRow;
+            const int64_t left = static_cast<int32_t>(key) * int64_t{TILE_SIZE} - originCol;
+            if (top >= rows || left >= cols || top + TILE_SIZE <= 0 || left + TILE_SIZE <= 0)
+                continue;
+
+            for (int r = 0; r < TILE_SIZE; r++) {
+                for (uint64_t word = tile[r]; word; word &= word - 1) {
+                    const int64_t row = top + r;
+                    const int64_t col = left + std::countr_zero(word);
+                    if (row >= 0 && row < rows && col >= 0 && col < cols)
+                        living.emplace(row, col);
+                }
+            }
+        }
+        return living;
+    }
+
+    /**
+     * Gets the coordinates of every living cell of the universe, inside the visible window or not.
+     *
+     * @return Living cells, relative to the visible window
+     */
+    std::vector<std::pair<int64_t, int64_t>> TiledGrid::getUniverseCells() const {
+        std::vector<std::pair<int64_t, int64_t>> living;
+        living.reserve(population);
+        for (const auto &[key, tile] : tiles) {
+            const int64_t top = (key >> 32) * TILE_SIZE - originRow;
+            const int64_t left = static_cast<int32_t>(key) * int64_t{TILE_SIZE} - originCol;
+            for (int r = 0; r < TILE_SIZE; r++) {
+                for (uint64_t word = tile[r]; word; word &= word - 1) {
+                    living.emplace_back(top + r, left + std::countr_zero(word));
+                }
+            }
+        }
+        return living;
+    }
+
+    /**
+     * Moves the whole pattern relative to the visible window, by moving the window the other way.
+     *
+     * @param dRow Rows to move the pattern by, positive to the south
+     * @param dCol Columns to move the pattern by, positive to the east
+     */
+    void TiledGrid::translate(const int64_t dRow, const int64_t dCol) {
+        originRow -= dRow;
+        originCol -= dCol;
+    }
+
+    /**
+     * IWritable implementation.
+     * Gets the visible window as a string.
+     *
+     * @return The visible window as a string
+     */
+    std::string TiledGrid::getText() const {
+        const auto visible = getCells();
+        std::stringstream ss;
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                ss << (visible[i][j] ? formatConfig.getAliveChar() : formatConfig.getDeadChar()) << formatConfig.getDelimiterChar();
+            }
+            ss << '\n';
+        }
+        return ss.str();
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef TILEDGRID_H
+#define TILEDGRID_H
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "BaseGrid.h"
+#include "CoordinateSet.h"
+#include "Rules.h"
+#include "TileCache.h"
+#include "File/FormatConfig.h"
+
+namespace GameOfLife::Game {
+    /**
+     * Sparse implementation of an unbounded grid, divided in 64x64 bit-packed tiles stored by tile coordinate.
+     * Only the tiles that changed during the last generation, and their neighbors, are stepped.
+     * Rows and columns only define the visible window.
+     * An optional cache of tile transitions replaces the computation of the tiles that were already seen with the same
+     * border, such as the tiles of oscillators.
+     */
+    class TiledGrid : public BaseGrid<std::vector<std::vector<bool>>, bool> {
+    private:
+        using Tile = std::array<uint64_t, TILE_SIZE>;
+
+        std::unordered_map<int64_t, Tile> tiles;
+        std::vector<int64_t> activeTiles;
+
+        int rows;
+        int cols;
+        int64_t originRow = 0;
+        int64_t originCol = 0;
+
+        uint64_t generation = 0;
+        size_t population = 0;
+        IsotropicRule rule;
+        TileCache cache;
+
+        File::FormatConfig formatConfig = File::FormatConfig('O', '.', '\0');
+
+        static int64_t tileKey(int64_t tileRow, int64_t tileCol);
+        [[nodiscard]] const Tile *findTile(int64_t tileRow, int64_t tileCol) const;
+        void activate(int64_t key);
+
+    public:
+        TiledGrid() = delete;
+        TiledGrid(int rows, int cols);
+        TiledGrid(const std::vector<std::vector<bool>> &cells, int rows, int cols);
+        ~TiledGrid() override = default;
+
+        void setAlive(int row, int col, bool alive) override;
+        [[nodiscard]] bool isAlive(int row, int col) const override;
+        [[nodiscard]] int countNeighbors(int row, int col, bool wrap) const override;
+
+        void step() override;
+        void step(bool wrap) override;
+        void step(bool wrap, bool dynamic);
+        void randomize(float aliveProbability) override;
+        void clear() override;
+
+        void resize(int addNorth, int addEast, int addSouth, int addWest);
+        void insert(const std::vector<std::vector<bool>> &cells, int row, int col, bool hollow = false);
+
+        void print() const override;
+        void print(int fromRow, int fromCol, int toRow, int toCol) const override;
+
+        [[nodiscard]] std::vector<std::vector<bool>> getCells() const override;
+
+        [[nodiscard]] int getRows() const override { return rows; }
+        [[nodiscard]] int getCols() const override { return cols; }
+
+        [[nodiscard]] CoordinateSet getLivingCells() const;
+        [[nodiscard]] std::vector<std::pair<int64_t, int64_t>> getUniverseCells() const;
+        [[nodiscard]] size_t getPopulation() const { return population; }
+        void translate(int64_t dRow, int64_t dCol);
+
+        [[nodiscard]] uint64_t getGeneration() const { return generation; }
+        [[nodiscard]] size_t getTileCount() const { return tiles.size(); }
+        [[nodiscard]] size_t getActiveTileCount() const { return activeTiles.size(); }
+
+        void setRule(const IsotropicRule &rule) { this->rule = rule; cache.clear(); }
+        [[nodiscard]] const IsotropicRule &getRule() const { return rule; }
+
+        void setCacheCapacity(const size_t capacity) { cache.setCapacity(capacity); }
+        [[nodiscard]] const TileCache &getTileCache() const { return cache; }
+
+        void setFormatConfig(const File::FormatConfig &formatConfig) { this->formatConfig = formatConfig; }
+        [[nodiscard]] File::FormatConfig getFormatConfig() const { return formatConfig; }
+
+        [[nodiscard]] std::string getText() const override;
+    };
+}
+
+#endif //TILEDGRID_H
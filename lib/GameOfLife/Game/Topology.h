@@ -0,0 +1,24 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+
+namespace GameOfLife::Game {
+    /**
+     * How the edges of a wrapping grid are joined.
+     * Crossing a twisted seam mirrors the position along it: the Klein bottle twists the seam between the first and
+     * last rows, the cross-surface (real projective plane) twists both seams.
+     */
+    enum class Topology {
+        // Edges are not joined, the cells past them are dead
+        PLANE,
+        // Opposite edges are joined
+        TORUS,
+        // Left and right edges are joined, top and bottom edges are joined with a twist
+        KLEIN_BOTTLE,
+        // Both pairs of edges are joined with a twist
+        CROSS_SURFACE
+    };
+}
+
+
+#endif //TOPOLOGY_H
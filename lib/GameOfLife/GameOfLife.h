@@ -5,6 +5,7 @@
 #include "Game/ExtendedGrid.h"
 #include "Game/Cell.h"
 #include "Game/HighPerformanceGrid.h"
+#include "Game/Rules.h"
 
 #include "File/Parser.h"
 #include "File/Writer.h"
@@ -0,0 +1,215 @@
+#include "Benchmarks.h"
+
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "Game/BatchGrid.h"
+#include "Game/CoordinateSet.h"
+#include "Game/HashFunction.h"
+#include "Game/HighPerformanceGrid.h"
+#include "Game/TiledGrid.h"
+
+namespace GameOfLife::Tests {
+    /**
+     * Coordinate hash used before CoordinateSet, kept for comparison.
+     */
+    struct LegacyHashFunction {
+        std::size_t operator()(const std::pair<int, int>& p) const noexcept {
+            return std::hash<int>()(p.first) ^ (std::hash<int>()(p.second) << 1);
+        }
+    };
+
+    /**
+     * Times a function.
+     *
+     * @param function Function to time
+     * @return Elapsed time in seconds
+     */
+    template<typename TFunction>
+    static double measure(TFunction function) {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * Measures the insert, iterate and erase throughput of a set.
+     *
+     * @tparam TSet Set type
+     * @param name Name to display
+     * @param cells Cells to insert, iterate and erase
+     */
+    template<typename TSet>
+    static void benchmarkSet(const std::string &name, const std::vector<std::pair<int, int>> &cells) {
+        TSet set;
+        volatile long long checksum = 0;
+        const double insertTime = measure([&] {
+            for (const auto &cell : cells)
+                set.insert(cell);
+        });
+        const double iterateTime = measure([&] {
+            for (const auto &cell : set)
+                checksum = checksum + (cell.first ^ cell.second);
+        });
+        const double eraseTime = measure([&] {
+            for (const auto &cell : cells)
+                set.erase(cell);
+        });
+
+        const double count = static_cast<double>(cells.size()) / 1e6;
+        std::cout << "  " << std::left << std::setw(36) << name << std::right
+            << std::setw(10) << count / insertTime << std::setw(10) << count / iterateTime
+            << std::setw(10) << count / eraseTime << std::endl;
+    }
+
+    void Benchmarks::run() {
+        benchmarkCoordinateSet();
+        benchmarkTemporalBlocking();
+        benchmarkTileCache();
+        benchmarkBatchGrid();
+    }
+
+    void Benchmarks::benchmarkCoordinateSet() {
+        // Living cells of a soup: half of the cells of a square are alive
+        std::cout << std::fixed << std::setprecision(2);
+        std::mt19937 random(42);
+        for (const int count : {100000, 1000000, 10000000}) {
+            const int side = static_cast<int>(std::sqrt(2.0 * count));
+            std::vector<std::pair<int, int>> cells;
+            cells.reserve(count);
+            while (cells.size() < static_cast<size_t>(count)) {
+                const int row = static_cast<int>(random() % side);
+                const int col = static_cast<int>(random() % side);
+                cells.emplace_back(row, col);
+            }
+
+            std::cout << count << " cells (million operations per second)" << std::endl;
+            std::cout << "  " << std::left << std::setw(36) << "Set" << std::right
+                << std::setw(10) << "insert" << std::setw(10) << "iterate" << std::setw(10) << "erase" << std::endl;
+            // The legacy hash collides so much that it becomes quadratic on large sets
+            if (count <= 1000000)
+                benchmarkSet<std::unordered_set<std::pair<int, int>, LegacyHashFunction>>("unordered_set (legacy hash)", cells);
+            else
+                std::cout << "  " << std::left << std::setw(36) << "unordered_set (legacy hash)" << "skipped" << std::endl;
+            benchmarkSet<std::unordered_set<std::pair<int, int>, Game::HashFunction>>("unordered_set (HashFunction)", cells);
+            benchmarkSet<Game::CoordinateSet>("CoordinateSet", cells);
+        }
+    }
+
+    void Benchmarks::benchmarkTemporalBlocking() {
+        // Dense soup much larger than the caches, on the packed engine
+        constexpr int side = 8192;
+        constexpr int generations = 32;
+        Game::HighPerformanceGrid soup(side, side, side, side, false);
+        soup.randomize(0.35f, 42);
+        const double gridBytes = static_cast<double>(side) * side / 8;
+
+        std::cout << side << "x" << side << " soup, " << generations << " generations" << std::endl;
+        std::cout << "  " << std::left << std::setw(16) << "Block depth" << std::right << std::setw(16) << "ms/generation"
+            << std::setw(20) << "MB/generation" << std::setw(12) << "GB/s" << std::endl;
+        for (const int blockDepth : {1, 2, 4, 8, 16}) {
+            Game::HighPerformanceGrid grid(soup.getCells(), side, side, side, side, false);
+            grid.setBlockDepth(blockDepth);
+            const double time = measure([&] {
+                while (grid.getGeneration() < generations)
+                    grid.step(true, false);
+            });
+
+            // Each step streams the grid in and out once, with the halo of every band, then once more to record the
+            // changed cells (both generations in, the changes out)
+            const int band = grid.getBandRows(blockDepth);
+            const double halo = blockDepth > 1 ? 2.0 * blockDepth / band : 0;
+            const double bytes = gridBytes * (2 + halo + 3) / blockDepth;
+            const double seconds = time / static_cast<double>(grid.getGeneration());
+            std::cout << "  " << std::left << std::setw(16) << blockDepth << std::right << std::setw(16) << seconds * 1e3
+                << std::setw(20) << bytes / 1e6 << std::setw(12) << bytes / seconds / 1e9 << std::endl;
+        }
+    }
+
+    void Benchmarks::benchmarkTileCache() {
+        // Ash of blinkers and blocks scattered on the tiled engine, every tile oscillating with a period of 2
+        constexpr int side = 2048;
+        constexpr int generations = 200;
+        std::mt19937 random(42);
+        std::vector<std::pair<int, int>> blinkers, blocks;
+        for (int k = 0; k < side * side / 512; k++) {
+            const int row = static_cast<int>(random() % (side / 8)) * 8;
+            const int col = static_cast<int>(random() % (side / 8)) * 8;
+            (random() % 3 == 0 ? blocks : blinkers).emplace_back(row, col);
+        }
+
+        std::cout << side << "x" << side << " ash, " << generations << " generations" << std::endl;
+        std::cout << "  " << std::left << std::setw(24) << "Rule" << std::setw(12) << "Cache" << std::right
+            << std::setw(16) << "ms/generation" << std::setw(12) << "Hit rate" << std::endl;
+        for (const std::string rule : {"B3/S23", "B2n3/S23-q"}) {
+            for (const int capacity : {0, 4096}) {
+                Game::TiledGrid grid(side, side);
+                grid.setRule(Game::IsotropicRule::parse(rule));
+                grid.setCacheCapacity(capacity);
+                for (const auto &[row, col] : blinkers)
+                    grid.insert({{true, true, true}}, row + 1, col);
+                for (const auto &[row, col] : blocks)
+                    grid.insert({{true, true}, {true, true}}, row, col);
+
+                const double time = measure([&] {
+                    for (int i = 0; i < generations; i++)
+                        grid.step();
+                });
+                std::cout << "  " << std::left << std::setw(24) << rule << std::setw(12) << capacity << std::right
+                    << std::setw(16) << time / generations * 1e3 << std::setw(11) << grid.getTileCache().getHitRate() * 100
+                    << "%" << std::endl;
+            }
+        }
+    }
+
+    void Benchmarks::benchmarkBatchGrid() {
+        // Soup search: 16x16 soups in a 64x64 torus, one batch of 64 against the packed engine one soup at a time
+        constexpr int side = 64;
+        constexpr int generations = 1000;
+        Game::BatchGrid soups(side, side);
+        soups.randomize(0.5f, 42, 24, 24, 16, 16);
+
+        std::cout << Game::BatchGrid::LANES << " soups of 16x16 in " << side << "x" << side << ", " << generations
+            << " generations" << std::endl;
+        std::cout << "  " << std::left << std::setw(28) << "Engine" << std::right << std::setw(16) << "ms"
+            << std::setw(24) << "generations/s" << std::endl;
+        const auto print = [](const std::string &name, const double time) {
+            std::cout << "  " << std::left << std::setw(28) << name << std::right << std::setw(16) << time * 1e3
+                << std::setw(24) << Game::BatchGrid::LANES * generations / time << std::endl;
+        };
+
+        print("HighPerformanceGrid", measure([&] {
+            for (int lane = 0; lane < Game::BatchGrid::LANES; lane++) {
+                Game::HighPerformanceGrid grid(soups.extract(lane), side, side, side, side, false);
+                for (int i = 0; i < generations; i++)
+                    grid.step(true, false);
+            }
+        }));
+
+        Game::BatchGrid batch = soups;
+        print("BatchGrid", measure([&] {
+            for (int i = 0; i < generations; i++)
+                batch.step(true);
+        }));
+
+        // Universes that stopped changing are retired, the batch ends once they all settled
+        Game::BatchGrid retiring = soups;
+        uint64_t steps = 0;
+        print("BatchGrid (retiring)", measure([&] {
+            for (int i = 0; i < generations && retiring.getActive() != 0; i++) {
+                retiring.step(true);
+                retiring.setActive(retiring.getActive() & retiring.getChangedLanes());
+                steps++;
+            }
+        }));
+        std::cout << "  " << std::popcount(retiring.getActive()) << " soups still active after " << steps << " steps"
+            << std::endl;
+    }
+}
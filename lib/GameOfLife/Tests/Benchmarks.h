@@ -0,0 +1,17 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+namespace GameOfLife::Tests {
+
+    class Benchmarks {
+    public:
+        static void run();
+
+        static void benchmarkCoordinateSet();
+        static void benchmarkTemporalBlocking();
+        static void benchmarkTileCache();
+        static void benchmarkBatchGrid();
+    };
+}
+
+#endif //BENCHMARKS_H
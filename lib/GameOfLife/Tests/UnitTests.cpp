@@ -1,7 +1,15 @@
 #include "UnitTests.h"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <cmath>
+#include <complex>
+#include <set>
+#include <tuple>
 #include <iostream>
+#include <limits>
+#include <numbers>
 
 #include "CLI/Arguments.h"
 #include "CLI/Main.h"
@@ -9,9 +17,22 @@
 #include "File/Parser.h"
 #include "File/Utils.h"
 #include "File/Writer.h"
+#include "Game/BatchGrid.h"
 #include "Game/Cell.h"
+#include "Game/CoordinateSet.h"
+#include "Game/CycleDetector.h"
 #include "Game/ExtendedGrid.h"
+#include "Game/FFT.h"
+#include "Game/GenerationsGrid.h"
 #include "Game/Grid.h"
+#include "Game/HashLifeGrid.h"
+#include "Game/HighPerformanceGrid.h"
+#include "Game/LargerThanLifeGrid.h"
+#include "Game/LeniaGrid.h"
+#include "Game/Random.h"
+#include "Game/StepKernel.h"
+#include "Game/ThreadPool.h"
+#include "Game/TiledGrid.h"
 #include "GUI/Main.h"
 
 namespace GameOfLife::Tests {
@@ -24,8 +45,20 @@ namespace GameOfLife::Tests {
 
     void UnitTests::run() {
         testCell();
+        testCoordinateSet();
         testGrid();
         testExtendedGrid();
+        testHighPerformanceGrid();
+        testStepKernel();
+        testHashLifeGrid();
+        testTiledGrid();
+        testBatchGrid();
+        testLargerThanLifeGrid();
+        testGenerationsGrid();
+        testRandom();
+        testLeniaGrid();
+        testCycleDetector();
+        testThreadPool();
 
         testParser();
         testExtendedParser();
@@ -83,6 +116,36 @@ namespace GameOfLife::Tests {
         std::cout << "Cell tests passed" << std::endl;
     }
 
+    void UnitTests::testCoordinateSet() {
+        // Test the CoordinateSet class
+        Game::CoordinateSet set;
+        ASSERT(set.empty() && set.begin() == set.end(), "Set should be empty");
+        ASSERT(set.insert({-1, 2}), "Coordinate should be inserted");
+        ASSERT(!set.insert({-1, 2}), "Coordinate should not be inserted twice");
+        ASSERT(set.contains({-1, 2}) && !set.contains({2, -1}), "Only the inserted coordinate should be found");
+        ASSERT(*set.begin() == std::make_pair(-1, 2), "Iterator should yield the coordinate");
+        ASSERT(set.erase({-1, 2}) == 1 && set.erase({-1, 2}) == 0, "Coordinate should be erased once");
+
+        // Random operations should match an ordered set, through growth and tombstone cleanups
+        std::set<std::pair<int, int>> reference;
+        for (int i = 0; i < 200000; i++) {
+            const std::pair cell = {rand() % 512 - 256, rand() % 512 - 256};
+            if (rand() % 3 == 0)
+                ASSERT(set.erase(cell) == reference.erase(cell), "Erase should match");
+            else
+                ASSERT(set.insert(cell) == reference.insert(cell).second, "Insert should match");
+        }
+        ASSERT(set.size() == reference.size(), "Sizes should match");
+        std::set<std::pair<int, int>> iterated(set.begin(), set.end());
+        ASSERT(iterated == reference, "Iteration should yield every coordinate once");
+        ASSERT(Game::CoordinateSet(reference.begin(), reference.end()) == set, "Sets should be equal");
+
+        set.clear();
+        ASSERT(set.empty() && !set.contains(*reference.begin()), "Set should be cleared");
+
+        std::cout << "CoordinateSet tests passed" << std::endl;
+    }
+
     void UnitTests::testGrid() {
         // Test the Grid class
         // Test the constructor
@@ -166,6 +229,42 @@ namespace GameOfLife::Tests {
         ASSERT(grid.isAlive(1, 2), "Cell should be alive");
         ASSERT(grid.isAlive(2, 2), "Cell should be alive");
 
+        // Test dynamic growth, a glider going north-west keeps growing the grid and moving its origin
+        const std::vector<std::vector<bool>> glider = {{true, true, true}, {true, false, false}, {false, true, false}};
+        for (const auto mode : {Game::StepMode::REGULAR, Game::StepMode::FRONTIER, Game::StepMode::INCREMENTAL}) {
+            Game::Grid reference(400, 400, 400, 400, false);
+            reference.insert(glider, 350, 350);
+            Game::Grid growing(glider, 3, 3, std::numeric_limits<int>::max(), std::numeric_limits<int>::max(), true);
+            growing.setStepMode(mode);
+            for (int generation = 0; generation < 300; generation++) {
+                reference.step(false, false);
+                growing.step(false, true);
+                std::set<std::pair<int64_t, int64_t>> expected, actual;
+                for (const auto &[row, col] : reference.getLivingCells()) {
+                    expected.emplace(row - 350, col - 350);
+                }
+                for (const auto &[row, col] : growing.getLivingCells()) {
+                    actual.emplace(growing.getOriginRow() + row, growing.getOriginCol() + col);
+                }
+                ASSERT(actual == expected, "Growing grid should match the reference");
+            }
+            ASSERT(growing.getOriginRow() < -70 && growing.getOriginCol() < -70, "Origin should follow the glider");
+            ASSERT(growing.getRows() < 10 - growing.getOriginRow(), "Grid should mostly grow north");
+            ASSERT(growing.getCells().size() == growing.getRows(), "Cells should not include the padding");
+        }
+
+        // Test growth past the default maximum, and the cap when one is given
+        Game::Grid unbounded(1, 1, std::numeric_limits<int>::max(), std::numeric_limits<int>::max(), true);
+        unbounded.setAlive(0, 0, true);
+        unbounded.resize(1500, 1500, 1500, 1500);
+        ASSERT(unbounded.getRows() == 3001 && unbounded.getCols() == 3001, "Grid should grow past 2048");
+        ASSERT(unbounded.getOriginRow() == -1500 && unbounded.getOriginCol() == -1500, "Origin should move north-west");
+        ASSERT(unbounded.isAlive(1500, 1500) && unbounded.getPopulation() == 1, "Cells should keep their place");
+        ASSERT(unbounded.getLivingCells().contains({1500, 1500}), "Living cells should be in grid coordinates");
+        Game::Grid capped(1, 1, 2048, 2048, true);
+        capped.resize(0, 3000, 0, 0);
+        ASSERT(capped.getCols() == 1, "Capped grid should not grow past its maximum");
+
         // Test wrap step
         grid.clear();
         grid.setAlive(0, 0, true);
@@ -174,6 +273,160 @@ namespace GameOfLife::Tests {
         grid.step(true, false);
         ASSERT(grid.isAlive(0, 1), "Cell should be alive");
 
+        // Test the buffer swap, only the changed cells are copied to the back buffer
+        grid = Game::Grid(64, 64);
+        grid.setAlive(9, 10, true);
+        grid.setAlive(10, 10, true);
+        grid.setAlive(11, 10, true);
+        grid.step(false, false);
+        ASSERT(grid.getBytesCopied() == 4, "Bytes copied should be 4");
+        grid.setAlive(10, 9, false);
+        grid.setAlive(10, 10, false);
+        grid.setAlive(10, 11, false);
+        grid.step(false, false);
+        grid.step(false, false);
+        ASSERT(grid.getPopulation() == 0, "Population should be 0");
+        ASSERT(!grid.isAlive(10, 10), "Cell should not be alive");
+
+        // Test the frontier and incremental modes against the regular step, with and without wrap
+        for (const auto mode : {Game::StepMode::FRONTIER, Game::StepMode::INCREMENTAL}) {
+            for (const bool wrap : {false, true}) {
+                Game::Grid reference(64, 64, 64, 64, false);
+                reference.randomize(0.3f);
+                Game::Grid tracked(reference.getCells(), 64, 64, 64, 64, false);
+                tracked.setStepMode(mode);
+                ASSERT(tracked.getStepMode() == mode, "Step mode should be set");
+                for (int i = 0; i < 40; i++) {
+                    // Edits between generations must reach the frontier too
+                    if (i == 20) {
+                        reference.setAlive(30, 30, !reference.isAlive(30, 30));
+                        tracked.setAlive(30, 30, !tracked.isAlive(30, 30));
+                    }
+                    reference.step(wrap, false);
+                    tracked.step(wrap, false);
+                    ASSERT(tracked.getCells() == reference.getCells(), "Frontier step should match the regular step");
+                    ASSERT(tracked.getChangedCells() == reference.getChangedCells(), "Changed cells should match");
+                }
+            }
+        }
+
+        // A new rule must reach the frontier too: a settled block dies under B3/S
+        for (const auto mode : {Game::StepMode::REGULAR, Game::StepMode::FRONTIER, Game::StepMode::INCREMENTAL}) {
+            Game::Grid block(8, 8, 8, 8, false);
+            block.setStepMode(mode);
+            block.insert({{true, true}, {true, true}}, 3, 3);
+            block.step(false, false);
+            block.setRule(Game::IsotropicRule::parse("B3/S"));
+            block.step(false, false);
+            ASSERT(block.getPopulation() == 0, "Block should die after the rule changes");
+        }
+
+        // Test every preset rule, and a rule without a preset (B36/S125), in the regular and frontier modes
+        const std::pair<Game::LifeLikeRule, std::pair<int, int>> rules[] = {
+            { Game::Rule::CONWAY, { 0b1000, 0b1100 } },
+            { Game::Rule::HIGHLIFE, { 0b1001000, 0b1100 } },
+            { Game::Rule::SEEDS, { 0b100, 0 } },
+            { Game::Rule::DAY_AND_NIGHT, { 0b111001000, 0b111011000 } },
+            { Game::Rule::LIFE_WITHOUT_DEATH, { 0b1000, 0b111111111 } },
+            { Game::Rule::MAZE, { 0b1000, 0b111110 } },
+            { Game::LifeLikeRule(0b1001000, 0b100110), { 0b1001000, 0b100110 } }
+        };
+        for (const auto &[rule, masks] : rules) {
+            for (const auto mode : {Game::StepMode::REGULAR, Game::StepMode::FRONTIER}) {
+                Game::Grid ruled(48, 48, 48, 48, false);
+                ruled.randomize(0.3f);
+                ruled.setRule(rule);
+                ruled.setStepMode(mode);
+                ASSERT(ruled.getRule() == rule, "Rule should be set");
+                for (int generation = 0; generation < 4; generation++) {
+                    const Game::Grid previous = ruled;
+                    ruled.step(true, false);
+                    for (int i = 0; i < 48; i++) {
+                        for (int j = 0; j < 48; j++) {
+                            const int mask = previous.isAlive(i, j) ? masks.second : masks.first;
+                            const bool expected = mask >> previous.countNeighbors(i, j, true) & 1;
+                            ASSERT(ruled.isAlive(i, j) == expected, "Cell should follow the rule");
+                        }
+                    }
+                }
+            }
+        }
+
+        // Isotropic rules read the whole neighbourhood, in every mode and on dense and sparse grids
+        const auto isotropic = Game::IsotropicRule::parse("B2n3/S23-q");
+        for (int index = 0; index < 512; index++) {
+            const int mirrored = (index & 0b001001001) << 2 | (index & 0b010010010) | (index & 0b100100100) >> 2;
+            ASSERT(isotropic.next(index) == isotropic.next(mirrored), "Isotropic rule should be symmetric");
+        }
+        for (const auto mode : {Game::StepMode::REGULAR, Game::StepMode::FRONTIER, Game::StepMode::INCREMENTAL}) {
+            for (const float density : {0.4f, 0.004f}) {
+                Game::Grid ruled(96, 96, 96, 96, false);
+                ruled.randomize(density);
+                ruled.setRule(isotropic);
+                ruled.setStepMode(mode);
+                for (int generation = 0; generation < 4; generation++) {
+                    const Game::Grid previous = ruled;
+                    ruled.step(true, false);
+                    for (int i = 0; i < 96; i++) {
+                        for (int j = 0; j < 96; j++) {
+                            int index = 0;
+                            for (int di = -1; di <= 1; di++) {
+                                for (int dj = -1; dj <= 1; dj++) {
+                                    index |= previous.isAlive((i + di + 96) % 96, (j + dj + 96) % 96) << ((di + 1) * 3 + dj + 1);
+                                }
+                            }
+                            ASSERT(ruled.isAlive(i, j) == isotropic.next(index), "Cell should follow the isotropic rule");
+                        }
+                    }
+                }
+            }
+        }
+
+        // Test the topologies against the neighbors read across their seams, on dense and sparse grids
+        // The last step does not wrap, so the halo must have been cleared
+        for (const auto topology : {Game::Topology::PLANE, Game::Topology::TORUS, Game::Topology::KLEIN_BOTTLE, Game::Topology::CROSS_SURFACE}) {
+            const bool twistRows = topology == Game::Topology::KLEIN_BOTTLE || topology == Game::Topology::CROSS_SURFACE;
+            const bool twistCols = topology == Game::Topology::CROSS_SURFACE;
+            for (const auto mode : {Game::StepMode::REGULAR, Game::StepMode::FRONTIER, Game::StepMode::INCREMENTAL}) {
+                for (const float density : {0.4f, 0.01f}) {
+                    Game::Grid joined(20, 27, 20, 27, false);
+                    joined.randomize(density, 7);
+                    joined.setTopology(topology);
+                    joined.setStepMode(mode);
+                    ASSERT(joined.getTopology() == topology, "Topology should be set");
+                    for (int generation = 0; generation < 5; generation++) {
+                        const bool wrap = generation < 4 && topology != Game::Topology::PLANE;
+                        const Game::Grid previous = joined;
+                        joined.step(generation < 4, false);
+                        for (int i = 0; i < 20; i++) {
+                            for (int j = 0; j < 27; j++) {
+                                int count = 0;
+                                for (int di = -1; di <= 1; di++) {
+                                    for (int dj = -1; dj <= 1; dj++) {
+                                        int row = i + di;
+                                        int col = j + dj;
+                                        if ((di == 0 && dj == 0) || (!wrap && (row < 0 || row >= 20 || col < 0 || col >= 27)))
+                                            continue;
+                                        if (row < 0 || row >= 20) {
+                                            row = (row + 20) % 20;
+                                            col = twistRows ? 26 - col : col;
+                                        }
+                                        if (col < 0 || col >= 27) {
+                                            col = (col + 27) % 27;
+                                            row = twistCols ? 19 - row : row;
+                                        }
+                                        count += previous.isAlive(row, col);
+                                    }
+                                }
+                                const bool expected = previous.isAlive(i, j) ? count == 2 || count == 3 : count == 3;
+                                ASSERT(joined.isAlive(i, j) == expected, "Cell should follow the topology");
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
         std::cout << "Grid tests passed" << std::endl;
     }
 
@@ -268,9 +521,1037 @@ namespace GameOfLife::Tests {
         grid.step(true, false);
         ASSERT(grid.isAlive(0, 1), "Cell should be alive");
 
+        // Test the bitplanes, an inserted obstacle stays across generations
+        grid = Game::ExtendedGrid(64, 64);
+        grid.insert({{Game::Cell(true, true)}}, 20, 20);
+        grid.setAlive(9, 10, true);
+        grid.setAlive(10, 10, true);
+        grid.setAlive(11, 10, true);
+        for (int i = 0; i < 3; i++) {
+            grid.step(false, false);
+            ASSERT(grid.getBytesCopied() == 0, "Nothing should be copied between the buffers");
+        }
+        ASSERT(grid.isAlive(20, 20) && grid.isObstacle(20, 20), "Obstacle should stay alive");
+
         std::cout << "ExtendedGrid tests passed" << std::endl;
     }
 
+    void UnitTests::testHighPerformanceGrid() {
+        // Test the HighPerformanceGrid class
+        // Test the constructor
+        const int rows = 10;
+        const int cols = 70;
+        Game::HighPerformanceGrid grid(rows, cols);
+        ASSERT(grid.getRows() == rows, "Rows should be 10");
+        ASSERT(grid.getCols() == cols, "Cols should be 70");
+
+        // Test the setAlive & isAlive method
+        grid.setAlive(0, 0, true);
+        grid.setAlive(0, 64, true);
+        ASSERT(grid.isAlive(0, 0), "Cell should be alive");
+        ASSERT(grid.isAlive(0, 64), "Cell should be alive");
+        ASSERT(grid.getPopulation() == 2, "Population should be 2");
+
+        // Test the countNeighbors method
+        grid.setAlive(0, 1, true);
+        grid.setAlive(1, 0, true);
+        grid.setAlive(1, 1, true);
+        ASSERT(grid.countNeighbors(0, 0, false) == 3, "Cell should have 3 neighbors");
+        ASSERT(grid.countNeighbors(0, 0, true) == 3, "Cell should have 3 neighbors");
+        ASSERT(grid.countNeighbors(0, 65, false) == 1, "Cell should have 1 neighbor");
+
+        // Test the clear method
+        grid.clear();
+        ASSERT(!grid.isAlive(0, 0), "Cell should not be alive");
+        ASSERT(grid.getPopulation() == 0, "Population should be 0");
+
+        // Test the move method
+        grid.setAlive(0, 0, true);
+        grid.move(0, 0, 1, 1, 1, 1);
+        ASSERT(grid.isAlive(1, 1), "Cell should be alive");
+        ASSERT(!grid.isAlive(0, 0), "Cell should not be alive");
+
+        // Test the resize method, shifting the cells across a word boundary
+        grid.setAlive(1, 63, true);
+        grid.resize(1, 1, 1, 1);
+        ASSERT(grid.getRows() == rows + 2, "Rows should be 12");
+        ASSERT(grid.getCols() == cols + 2, "Cols should be 72");
+        ASSERT(grid.isAlive(2, 2), "Cell should be alive");
+        ASSERT(grid.isAlive(2, 64), "Cell should be alive");
+        grid.clear();
+
+        // Test the insert method
+        std::vector<std::vector<bool>> cells = {{true}};
+        grid.insert(cells, 0, 0);
+        ASSERT(grid.isAlive(0, 0), "Cell should be alive");
+
+        // Test the step method against the standard grid, with and without wrapping
+        for (const bool wrap : {false, true}) {
+            std::vector soup(37, std::vector<bool>(131));
+            for (auto &row : soup) {
+                for (auto &&cell : row) {
+                    cell = rand() % 3 == 0;
+                }
+            }
+            Game::Grid reference(soup, 37, 131, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+            Game::HighPerformanceGrid packed(soup, 37, 131, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+            for (int i = 0; i < 50; i++) {
+                reference.step(wrap, false);
+                packed.step(wrap, false);
+            }
+            ASSERT(packed.getCells() == reference.getCells(), "Packed grid should match the standard grid");
+            ASSERT(packed.getPopulation() == reference.getPopulation(), "Populations should be equal");
+        }
+
+        // Test temporal blocking against single generations, across bands, edges and stochastic draws
+        for (const bool wrap : {false, true}) {
+            for (const int depth : {2, 3, 8}) {
+                for (const bool stochastic : {false, true}) {
+                    Game::HighPerformanceGrid single(41, 131, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+                    single.randomize(0.35f, 11);
+                    Game::HighPerformanceGrid blocked(single.getCells(), 41, 131, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+                    if (stochastic) {
+                        single.setStochastic(0.9f, 0.95f, 5);
+                        blocked.setStochastic(0.9f, 0.95f, 5);
+                    }
+                    blocked.setBlockDepth(depth);
+                    blocked.setBandRows(5);
+                    ASSERT(blocked.getEffectiveBlockDepth() == depth && blocked.getBandRows(depth) == 5, "Blocking should be set");
+                    for (int i = 0; i < 4; i++) {
+                        blocked.step(wrap, false);
+                        for (int generation = 0; generation < depth; generation++) {
+                            single.step(wrap, false);
+                        }
+                        ASSERT(blocked.getCells() == single.getCells(), "Blocked step should match single generations");
+                        ASSERT(blocked.getGeneration() == single.getGeneration(), "Blocked step should advance the generations");
+                    }
+                }
+            }
+        }
+
+        // Automatic blocking only blocks the grids larger than the cache
+        Game::HighPerformanceGrid small(64, 64, 64, 64, false);
+        small.setBlockDepth(0);
+        ASSERT(small.getEffectiveBlockDepth() == 1, "Small grids should not be blocked");
+        Game::HighPerformanceGrid large(4096, 4096, 4096, 4096, false);
+        large.setBlockDepth(0);
+        ASSERT(large.getEffectiveBlockDepth() > 1, "Large grids should be blocked");
+        ASSERT(large.getBandRows(large.getEffectiveBlockDepth()) < 4096, "Bands should be smaller than the grid");
+
+        // Test dynamic step
+        grid = Game::HighPerformanceGrid(rows, rows);
+        grid.setAlive(1, 0, true);
+        grid.setAlive(1, 1, true);
+        grid.setAlive(1, 2, true);
+        grid.step(false, true);
+        ASSERT(grid.getCols() == rows + 1, "Cols should be 11");
+        ASSERT(grid.isAlive(0, 2), "Cell should be alive");
+        ASSERT(grid.isAlive(2, 2), "Cell should be alive");
+        ASSERT(grid.getChangedCells().size() == 4, "Changed cells should be 4");
+
+        std::cout << "HighPerformanceGrid tests passed" << std::endl;
+    }
+
+    void UnitTests::testStepKernel() {
+        // Test the StepKernel class
+        const auto detected = Game::StepKernel::getVariant();
+        ASSERT(Game::StepKernel::isSupported(Game::StepKernel::Variant::SCALAR), "Scalar kernel should be supported");
+
+        // Every supported variant should match the scalar kernel, for all row widths and with or without wrapping,
+        // under Conway's rule, another outer-totalistic rule and an isotropic rule
+        const auto lifeLike = Game::LifeLikeRule::parse("B36/S23");
+        const auto isotropic = Game::IsotropicRule::parse("B2n3/S23-q");
+        for (int words = 1; words <= 21; words++) {
+            std::vector<uint64_t> rows(3 * words);
+            std::vector<uint64_t> columns(3 * (words + 2));
+            for (auto &word : rows) {
+                word = static_cast<uint64_t>(rand()) << 42 ^ static_cast<uint64_t>(rand()) << 21 ^ rand();
+            }
+            for (auto &word : columns) {
+                word = static_cast<uint64_t>(rand()) << 42 ^ static_cast<uint64_t>(rand()) << 21 ^ rand();
+            }
+            const int cols = words * 64 - words % 3;
+            const auto stepAll = [&](const bool wrap) {
+                std::vector<uint64_t> out(5 * words);
+                Game::StepKernel::stepRow(&rows[0], &rows[words], &rows[2 * words], &out[0], words, cols, wrap);
+                Game::StepKernel::stepRow(&rows[0], &rows[words], &rows[2 * words], &out[words], words, cols, wrap,
+                    lifeLike);
+                Game::StepKernel::stepBlock(&columns[0], &columns[words + 2], &columns[2 * (words + 2)], &out[2 * words],
+                    words, lifeLike);
+                Game::StepKernel::stepRow(&rows[0], &rows[words], &rows[2 * words], &out[3 * words], words, cols, wrap,
+                    isotropic);
+                Game::StepKernel::stepBlock(&columns[0], &columns[words + 2], &columns[2 * (words + 2)], &out[4 * words],
+                    words, isotropic);
+                return out;
+            };
+            for (const bool wrap : {false, true}) {
+                Game::StepKernel::setVariant(Game::StepKernel::Variant::SCALAR);
+                const auto expected = stepAll(wrap);
+
+                for (const auto variant : {Game::StepKernel::Variant::SSE2, Game::StepKernel::Variant::AVX2,
+                    Game::StepKernel::Variant::AVX512}) {
+                    if (!Game::StepKernel::setVariant(variant))
+                        continue;
+                    ASSERT(stepAll(wrap) == expected, "Vectorized kernel should match the scalar kernel");
+                }
+            }
+        }
+        Game::StepKernel::setVariant(detected);
+
+        // The generic kernel should compute Conway's rule like the dedicated one
+        for (const bool wrap : {false, true}) {
+            std::vector<uint64_t> rows(3 * 5);
+            for (auto &word : rows) {
+                word = static_cast<uint64_t>(rand()) << 42 ^ static_cast<uint64_t>(rand()) << 21 ^ rand();
+            }
+            std::vector<uint64_t> expected(5), actual(5);
+            Game::StepKernel::stepRow(&rows[0], &rows[5], &rows[10], expected.data(), 5, 300, wrap);
+            Game::StepKernel::stepRow(&rows[0], &rows[5], &rows[10], actual.data(), 5, 300, wrap,
+                Game::LifeLikeRule::parse("B3/S23"));
+            ASSERT(actual == expected, "Generic kernel should match the B3/S23 kernel");
+        }
+
+        // The packed engines should match Grid under other rules
+        for (const auto &name : {"B36/S23", "B3678/S34678", "B2/S", "B1357/S1357", "B35678/S5678", "B2n3/S23-q", "B3/S2-i34q"}) {
+            const auto rule = Game::IsotropicRule::parse(name);
+            Game::Grid soup(30, 30, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+            soup.randomize(0.4);
+
+            Game::Grid reference(70, 130, 70, 130, false);
+            Game::HighPerformanceGrid packed(70, 130, 70, 130, false);
+            Game::ExtendedGrid extended(70, 130, 70, 130, false);
+            Game::TiledGrid tiled(soup.getCells(), 30, 30);
+            for (int i = 0; i < 30; i++) {
+                for (int j = 0; j < 30; j++) {
+                    reference.setAlive(i, j, soup.isAlive(i, j));
+                    packed.setAlive(i, j, soup.isAlive(i, j));
+                    extended.setAlive(i, j, soup.isAlive(i, j));
+                }
+            }
+            reference.setRule(rule);
+            packed.setRule(rule);
+            extended.setRule(rule);
+            tiled.setRule(rule);
+            for (int generation = 0; generation < 8; generation++) {
+                reference.step(true, false);
+                packed.step(true, false);
+                extended.step(true, false);
+                ASSERT(packed.getCells() == reference.getCells(), "HighPerformanceGrid should follow the rule");
+                ASSERT(extended.getLivingCells() == reference.getLivingCells(), "ExtendedGrid should follow the rule");
+            }
+
+            // The tiled grid is unbounded, compare it to a grid large enough for the soup not to reach the edges
+            Game::Grid unbounded(soup.getCells(), 30, 30, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+            unbounded.resize(40, 40, 40, 40);
+            unbounded.setRule(rule);
+            tiled.resize(40, 40, 40, 40);
+            for (int generation = 0; generation < 8; generation++) {
+                unbounded.step(false, false);
+                tiled.step();
+            }
+            ASSERT(tiled.getCells() == unbounded.getCells(), "TiledGrid should follow the rule");
+        }
+
+        // The dense path of Grid::step should follow the rules cell by cell
+        for (const bool wrap : {false, true}) {
+            Game::Grid grid(23, 150, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+            grid.randomize(0.4);
+            const Game::Grid previous = grid;
+            grid.step(wrap, false);
+            for (int i = 0; i < grid.getRows(); i++) {
+                for (int j = 0; j < grid.getCols(); j++) {
+                    const int neighbors = previous.countNeighbors(i, j, wrap);
+                    const bool expected = neighbors == 3 || (previous.isAlive(i, j) && neighbors == 2);
+                    ASSERT(grid.isAlive(i, j) == expected, "Dense step should follow B3/S23");
+                }
+            }
+            ASSERT(grid.getPopulation() == grid.getLivingCells().size(), "Living cells should be up to date");
+        }
+
+        std::cout << "StepKernel tests passed (" << Game::StepKernel::getVariantName(detected) << ")" << std::endl;
+    }
+
+    void UnitTests::testHashLifeGrid() {
+        // Test the HashLifeGrid class
+        Game::HashLifeGrid grid(10, 10);
+        grid.setAlive(1, 1, true);
+        ASSERT(grid.isAlive(1, 1), "Cell should be alive");
+        grid.setAlive(-1000, 5000, true);
+        ASSERT(grid.isAlive(-1000, 5000), "Cell outside of the window should be alive");
+        ASSERT(grid.getPopulation() == 2, "Population should be 2");
+        ASSERT(grid.getLivingCells().size() == 1, "Only visible cells should be listed");
+        grid.clear();
+        ASSERT(grid.getPopulation() == 0, "Grid should be empty");
+
+        // Single steps should match Grid on a board large enough for the soup to never reach the edges
+        Game::Grid soup(16, 16, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+        soup.randomize(0.4);
+        Game::Grid reference(200, 200, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+        reference.insert(soup.getCells(), 92, 92);
+        Game::HashLifeGrid hashLife(soup.getCells(), 16, 16);
+        hashLife.resize(92, 92, 92, 92);
+        for (int i = 0; i < 40; i++) {
+            reference.step(false, false);
+            hashLife.step();
+            ASSERT(hashLife.getCells() == reference.getCells(), "HashLife should match Grid");
+        }
+        ASSERT(hashLife.getGeneration() == 40, "Generation should be 40");
+
+        // A jump of 2^k generations should match 2^k single steps
+        Game::HashLifeGrid jump(soup.getCells(), 16, 16);
+        Game::HashLifeGrid single(soup.getCells(), 16, 16);
+        jump.resize(100, 100, 100, 100);
+        single.resize(100, 100, 100, 100);
+        jump.setStepExponent(6);
+        jump.step();
+        for (int i = 0; i < 64; i++) {
+            single.step();
+        }
+        ASSERT(jump.getCells() == single.getCells(), "Jump should match single steps");
+        ASSERT(jump.getPopulation() == single.getPopulation(), "Populations should match");
+        jump.advance(5);
+        ASSERT(jump.getGeneration() == 69, "Generation should be 69");
+
+        // Garbage collection should keep the universe intact
+        Game::HashLifeGrid collected(single.getCells(), single.getRows(), single.getCols());
+        collected.setMemoryLimit(0);
+        collected.step();
+        single.step();
+        ASSERT(collected.getCollections() == 1, "Garbage should be collected");
+        ASSERT(collected.getCells() == single.getCells(), "Garbage collection should keep the universe");
+
+        // A glider travels one cell diagonally every 4 generations, forever
+        Game::HashLifeGrid glider({{false, true, false}, {false, false, true}, {true, true, true}}, 3, 3);
+        glider.advance(4096);
+        ASSERT(glider.isAlive(1024, 1025) && glider.isAlive(1025, 1026) && glider.isAlive(1026, 1024),
+            "Glider should have moved 1024 cells");
+        glider.advance(1ull << 40);
+        ASSERT(glider.getPopulation() == 5, "Glider should survive");
+
+        // Changing the rule drops the memoized results of the previous rule
+        const auto isotropic = Game::IsotropicRule::parse("B2n3/S23-q");
+        reference.clear();
+        reference.insert(soup.getCells(), 92, 92);
+        reference.setRule(isotropic);
+        hashLife.clear();
+        hashLife.insert(soup.getCells(), 92, 92);
+        hashLife.setRule(isotropic);
+        for (int i = 0; i < 16; i++) {
+            reference.step(false, false);
+        }
+        hashLife.setStepExponent(4);
+        hashLife.step();
+        ASSERT(hashLife.getCells() == reference.getCells(), "HashLife should follow the rule");
+
+        std::cout << "HashLifeGrid tests passed" << std::endl;
+    }
+
+    void UnitTests::testTiledGrid() {
+        // Test the TiledGrid class
+        Game::TiledGrid grid(10, 10);
+        grid.setAlive(1, 1, true);
+        grid.setAlive(-1000, 5000, true);
+        ASSERT(grid.isAlive(1, 1) && grid.isAlive(-1000, 5000), "Cells should be alive");
+        ASSERT(grid.getTileCount() == 2, "Two tiles should be allocated");
+        grid.setAlive(-1000, 5000, false);
+        ASSERT(grid.getTileCount() == 1, "Empty tiles should be freed");
+        grid.clear();
+        ASSERT(grid.getPopulation() == 0, "Grid should be empty");
+
+        // Steps should match Grid, with the soup crossing tile boundaries
+        Game::Grid soup(16, 16, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+        soup.randomize(0.4);
+        Game::Grid reference(200, 200, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+        reference.insert(soup.getCells(), 56, 56);
+        Game::TiledGrid tiled(soup.getCells(), 16, 16);
+        tiled.resize(56, 128, 128, 56);
+        // A cache of a few tiles evicts on most generations
+        Game::TiledGrid cached(soup.getCells(), 16, 16);
+        cached.resize(56, 128, 128, 56);
+        cached.setCacheCapacity(3);
+        for (int i = 0; i < 60; i++) {
+            reference.step(false, false);
+            tiled.step();
+            cached.step();
+            ASSERT(tiled.getCells() == reference.getCells(), "TiledGrid should match Grid");
+            ASSERT(tiled.getPopulation() == reference.getPopulation(), "Populations should match");
+            ASSERT(cached.getCells() == reference.getCells(), "Cached TiledGrid should match Grid");
+        }
+        ASSERT(cached.getTileCache().getSize() <= 3, "Tile cache should stay bounded");
+
+        // Blinkers on the tile borders repeat their padded tiles, so they are looked up after one period
+        Game::TiledGrid blinkers(4, 4);
+        blinkers.setCacheCapacity(64);
+        for (int k = 0; k < 4; k++) {
+            blinkers.insert({{true, true, true}}, 63 + 64 * k, 62 + 64 * k);
+        }
+        for (int i = 0; i < 100; i++) {
+            blinkers.step();
+        }
+        ASSERT(blinkers.isAlive(63, 62) && blinkers.isAlive(63, 64) && !blinkers.isAlive(62, 63), "Blinker should oscillate");
+        ASSERT(blinkers.getPopulation() == 12, "Blinkers should survive");
+        ASSERT(blinkers.getTileCache().getHitRate() > 0.95, "Oscillating tiles should be looked up");
+        blinkers.setRule(Game::IsotropicRule::parse("B3/S"));
+        ASSERT(blinkers.getTileCache().getSize() == 0, "Changing the rule should clear the tile cache");
+        blinkers.step();
+        ASSERT(blinkers.getPopulation() == 8, "Blinkers should follow the new rule");
+
+        // Cached tiles are found by their whole key, and the tiles that were not hit are evicted first
+        Game::TileCache cache(2);
+        Game::TileCache::Key key{};
+        Game::TileCache::Tile next{};
+        cache.insert(key, 0, next);
+        key[0] = 1;
+        ASSERT(cache.find(key, 0) == nullptr, "A colliding key should miss");
+        cache.insert(key, 1, next);
+        ASSERT(cache.find(key, 1) != nullptr, "Inserted key should hit");
+        key[0] = 2;
+        cache.insert(key, 2, next);
+        ASSERT(cache.find(key, 2) != nullptr && cache.getSize() == 2, "Cache should evict");
+        key[0] = 1;
+        ASSERT(cache.find(key, 1) != nullptr, "Hit key should get a second chance");
+
+        // Still lifes are never stepped again, and tiles left behind by a glider are freed
+        Game::TiledGrid quiet(4, 4);
+        quiet.insert({{true, true}, {true, true}}, 63, 63);
+        quiet.step();
+        ASSERT(quiet.getActiveTileCount() == 0, "Still life should not be active");
+        ASSERT(quiet.getTileCount() == 4, "Block should span four tiles");
+        Game::TiledGrid glider({{false, true, false}, {false, false, true}, {true, true, true}}, 3, 3);
+        for (int i = 0; i < 1024; i++) {
+            glider.step();
+        }
+        ASSERT(glider.getPopulation() == 5, "Glider should survive");
+        ASSERT(glider.isAlive(256, 257) && glider.isAlive(257, 258) && glider.isAlive(258, 256), "Glider should have moved");
+        ASSERT(glider.getTileCount() <= 4, "Tiles left behind should be freed");
+
+        std::cout << "TiledGrid tests passed" << std::endl;
+    }
+
+    void UnitTests::testBatchGrid() {
+        // Test the BatchGrid class
+        Game::BatchGrid batch(8, 8);
+        const std::vector<std::vector<bool>> glider = {{false, true, false}, {false, false, true}, {true, true, true}};
+        batch.load(5, glider, 1, 2);
+        ASSERT(batch.isAlive(5, 3, 2) && !batch.isAlive(4, 3, 2), "Only the loaded universe should be alive");
+        ASSERT(batch.getPopulation(5) == 5 && batch.getPopulations()[5] == 5 && batch.getPopulations()[4] == 0,
+            "Populations should be counted by universe");
+        const auto extracted = batch.extract(5);
+        ASSERT(extracted[1][3] && extracted[3][2] && extracted[3][4] && !extracted[1][2], "Extracted cells should match");
+
+        // Each universe should follow its own Grid, on a plane and on a torus, for a totalistic and an isotropic rule
+        for (const std::string name : {"B3/S23", "B36/S23", "B2n3/S23-q"}) {
+            for (const bool wrap : {false, true}) {
+                const auto rule = Game::IsotropicRule::parse(name);
+                Game::BatchGrid soups(20, 24);
+                soups.setRule(rule);
+                soups.randomize(0.4f, 7, 5, 6, 10, 10);
+                std::vector<Game::Grid> references;
+                for (int lane = 0; lane < Game::BatchGrid::LANES; lane++) {
+                    references.emplace_back(soups.extract(lane), 20, 24, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+                    references.back().setRule(rule);
+                }
+                for (int i = 0; i < 30; i++) {
+                    soups.step(wrap);
+                    for (auto &reference : references) {
+                        reference.step(wrap, false);
+                    }
+                }
+                for (int lane = 0; lane < Game::BatchGrid::LANES; lane++) {
+                    ASSERT(soups.extract(lane) == references[lane].getCells(), "Universe should match Grid");
+                }
+            }
+        }
+
+        // Retired universes keep their cells, and settled universes are not reported as changed
+        batch.load(9, {{true, true}, {true, true}});
+        batch.retire(5);
+        batch.step(false);
+        ASSERT(batch.extract(5) == extracted, "Retired glider should not move");
+        ASSERT(batch.getChangedLanes() == 0, "Neither the retired glider nor the block should change");
+        batch.setActive(~uint64_t{0});
+        batch.step(false);
+        ASSERT(batch.getChangedLanes() == uint64_t{1} << 5, "Glider should move once active again");
+        ASSERT(batch.getGeneration() == 2, "Generation should be counted for the batch");
+
+        std::cout << "BatchGrid tests passed" << std::endl;
+    }
+
+    void UnitTests::testLargerThanLifeGrid() {
+        // Test the LargerThanLifeRule class
+        using Neighborhood = Game::LargerThanLifeRule::Neighborhood;
+        const auto bosco = Game::LargerThanLifeRule::parse("R5,C0,M1,S34..58,B34..45,NM");
+        ASSERT(bosco == Game::LargerThanLifeRule(), "Bosco's rule should be the default rule");
+        ASSERT(bosco.toString() == "R5,C0,M1,S34..58,B34..45,NM", "Rule should be normalized");
+        ASSERT(bosco.getNeighborhoodSize() == 121, "Neighbourhood should have 121 cells");
+        const auto diamond = Game::LargerThanLifeRule::parse("r2,c2,s3..5,b4");
+        ASSERT(diamond.toString() == "R2,C0,M0,S3..5,B4..4,NM", "Optional parts should default");
+        ASSERT(Game::LargerThanLifeRule::parse("R3,C0,M0,S2..7,B3..5,NN").getNeighborhoodSize() == 24, "Diamond should have 24 cells");
+        for (const std::string invalid : {"R5,C3,M1,S34..58,B34..45,NM", "R5,M1,S34..58,NM", "R0,S1..2,B1..2", "R1,S1..2,B0..2",
+            "R1,S5..2,B1..2", "R1,S1..10,B1..2", "R1,S1..2,B1..2,NX", "R1,R2,S1..2,B1..2", "R1,S1..2,B1..2,", "B3/S23"}) {
+            bool thrown = false;
+            try {
+                Game::LargerThanLifeRule::parse(invalid);
+            } catch (const std::invalid_argument &) {
+                thrown = true;
+            }
+            ASSERT(thrown, "Rule should be rejected: " + invalid);
+        }
+
+        // Steps should match the counts of the whole neighbourhood, in both shapes, with or without the centre cell
+        for (const std::string notation : {"R2,C0,M1,S5..11,B5..8,NM", "R3,C0,M0,S6..14,B7..10,NM", "R2,C0,M1,S3..7,B3..5,NN",
+            "R4,C0,M0,S8..20,B10..14,NN", "R1,C0,M0,S2..3,B3..3,NM"}) {
+            const auto rule = Game::LargerThanLifeRule::parse(notation);
+            for (const bool wrap : {false, true}) {
+                Game::Grid soup(23, 31, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+                soup.randomize(0.4);
+                Game::LargerThanLifeGrid grid(soup.getCells(), 23, 31, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+                grid.setRule(rule);
+                for (int generation = 0; generation < 4; generation++) {
+                    std::vector expected(23, std::vector<bool>(31));
+                    for (int i = 0; i < 23; i++) {
+                        for (int j = 0; j < 31; j++) {
+                            expected[i][j] = rule.next(grid.isAlive(i, j), grid.countNeighbors(i, j, wrap));
+                        }
+                    }
+                    grid.step(wrap);
+                    ASSERT(grid.getCells() == expected, "LargerThanLifeGrid should match the neighbourhood counts for " + notation);
+                }
+            }
+        }
+
+        // R1 without the centre is Life, and large grids are stepped in parallel bands
+        Game::Grid soup(320, 330, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+        soup.randomize(0.35);
+        Game::LargerThanLifeGrid life(soup.getCells(), 320, 330, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+        life.setRule(Game::LargerThanLifeRule::parse("R1,C0,M0,S2..3,B3..3,NM"));
+        for (int i = 0; i < 3; i++) {
+            soup.step(true, false);
+            life.step(true);
+            ASSERT(life.getCells() == soup.getCells(), "R1 Larger than Life should match Grid");
+        }
+        life.setRule(Game::LargerThanLifeRule::parse("R3,C0,M1,S9..20,B10..14,NN"));
+        const auto before = life.getCells();
+        life.step(false);
+        for (int i = 0; i < 320; i += 7) {
+            for (int j = 0; j < 330; j += 3) {
+                Game::LargerThanLifeGrid single(before, 320, 330, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+                single.setRule(life.getRule());
+                ASSERT(life.isAlive(i, j) == life.getRule().next(before[i][j], single.countNeighbors(i, j, false)),
+                    "Parallel bands should match the neighbourhood counts");
+            }
+        }
+
+        // The grid grows by the range when a living cell is within range of an edge
+        Game::LargerThanLifeGrid growing(12, 12);
+        growing.setRule(Game::LargerThanLifeRule::parse("R2,C0,M1,S1..25,B1..25,NM"));
+        growing.setAlive(1, 6, true);
+        growing.step(false, true);
+        ASSERT(growing.getRows() == 14 && growing.getCols() == 12, "Grid should grow to the north");
+        ASSERT(growing.getPopulation() == 25, "Cell should fill its neighbourhood");
+
+        std::cout << "LargerThanLifeGrid tests passed" << std::endl;
+    }
+
+    void UnitTests::testGenerationsGrid() {
+        // Test the GenerationsRule class
+        const auto brain = Game::GenerationsRule::parse("B2/S/C3");
+        ASSERT(brain == Game::GenerationsRule::parse("/2/3") && brain == Game::GenerationsRule::parse("briansbrain"), "Notations should match");
+        ASSERT(brain.toString() == "B2/S/C3" && brain.getStates() == 3, "Rule should be normalized");
+        ASSERT(Game::GenerationsRule::parse("345/2/4").toString() == "B2/S345/C4", "S/B/C notation should be accepted");
+        ASSERT(Game::GenerationsRule::parse("b2/s345/g4") == Game::GenerationsRule::parse("starwars"), "G prefix should be accepted");
+        ASSERT(Game::GenerationsRule::parse("B3/S23").getStates() == 2, "Two-state rules should be accepted");
+        ASSERT(Game::GenerationsRule::parse("LifeHistory").isHistory(), "LifeHistory should be accepted");
+        for (const std::string invalid : {"B2/S/C1", "B2/S/C300", "B2/S/Cx", "B2/S/", "B02/S/C3"}) {
+            bool thrown = false;
+            try {
+                Game::GenerationsRule::parse(invalid);
+            } catch (const std::invalid_argument &) {
+                thrown = true;
+            }
+            ASSERT(thrown, "Rule should be rejected: " + invalid);
+        }
+
+        // Every kernel variant should match the transition of each cell, on rows that do not fill their last word
+        const auto detected = Game::StepKernel::getVariant();
+        for (const std::string notation : {"B2/S/C3", "B2/S345/C4", "B3/S23/C2", "B34/S0123/C255", "B2/S13/C256", "LifeHistory"}) {
+            const auto rule = Game::GenerationsRule::parse(notation);
+            std::vector soup(37, std::vector<uint8_t>(150));
+            for (auto &row : soup) {
+                for (auto &state : row) {
+                    state = rand() % 3 == 0 ? 1 : rand() % rule.getStates();
+                }
+            }
+            for (const bool wrap : {false, true}) {
+                for (const auto variant : {Game::StepKernel::Variant::SCALAR, Game::StepKernel::Variant::SSE2,
+                    Game::StepKernel::Variant::AVX2, Game::StepKernel::Variant::AVX512}) {
+                    if (!Game::StepKernel::setVariant(variant))
+                        continue;
+                    Game::GenerationsGrid grid(soup, 37, 150, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+                    grid.setRule(rule);
+                    for (int generation = 0; generation < 3; generation++) {
+                        std::vector expected(37, std::vector<uint8_t>(150));
+                        for (int i = 0; i < 37; i++) {
+                            for (int j = 0; j < 150; j++) {
+                                expected[i][j] = rule.next(grid.getState(i, j), grid.countNeighbors(i, j, wrap));
+                            }
+                        }
+                        grid.step(wrap);
+                        ASSERT(grid.getCells() == expected, "GenerationsGrid should match the transitions of " + notation);
+                    }
+                }
+            }
+        }
+        Game::StepKernel::setVariant(detected);
+
+        // Brian's Brain: a living cell dies through the dying state
+        Game::GenerationsGrid brains(5, 5);
+        brains.setRule(brain);
+        brains.setAlive(2, 2, true);
+        brains.step();
+        ASSERT(brains.getState(2, 2) == 2 && brains.getPopulation() == 0, "Cell should be dying");
+        brains.step();
+        ASSERT(brains.getState(2, 2) == 0, "Cell should be dead");
+
+        // LifeHistory: a glider leaves its envelope behind, and marked cells stay marked
+        Game::GenerationsGrid history(12, 12, DEFAULT_MAX_ROWS, DEFAULT_MAX_COLS, false);
+        history.insert({{0, 1, 0}, {0, 0, 1}, {3, 1, 1}}, 1, 1);
+        for (int i = 0; i < 4; i++) {
+            history.step();
+        }
+        ASSERT(history.getPopulation() == 5 && history.getState(4, 3) == 1, "Glider should have moved");
+        ASSERT(history.getState(1, 2) == 2, "Glider should leave history behind");
+        ASSERT(history.getState(3, 1) == 4, "Marked cell should stay marked");
+
+        std::cout << "GenerationsGrid tests passed" << std::endl;
+    }
+
+    void UnitTests::testRandom() {
+        // Known answers of Philox4x32-10
+        ASSERT((Game::Random::philox({0, 0, 0, 0}, 0) == std::array<uint32_t, 4>{0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8}),
+            "Philox should match the reference with zeros");
+        ASSERT((Game::Random::philox({0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344}, 0x299F31D0A4093822) ==
+            std::array<uint32_t, 4>{0xD16CFE09, 0x94FDCCEB, 0x5001E420, 0x24126EA1}), "Philox should match the reference with pi");
+        ASSERT(Game::Random::threshold(0.5f) == Game::Random::ONE / 2 && Game::Random::threshold(2) == Game::Random::ONE,
+            "Probabilities should be rounded and clamped");
+
+        // Every kernel variant should draw the same rows, with the requested density
+        const int cols = 64 * 37 - 5;
+        const auto detected = Game::StepKernel::getVariant();
+        std::vector<uint64_t> reference;
+        for (const auto variant : {Game::StepKernel::Variant::SCALAR, Game::StepKernel::Variant::SSE2,
+            Game::StepKernel::Variant::AVX2, Game::StepKernel::Variant::AVX512}) {
+            if (!Game::StepKernel::setVariant(variant))
+                continue;
+            std::vector<uint64_t> rows(37 * 64);
+            for (int i = 0; i < 64; i++) {
+                Game::Random::bernoulliRow(&rows[i * 37], cols, Game::Random::threshold(0.3f), 42, 7, i,
+                    Game::Random::Stream::BIRTH);
+            }
+            if (reference.empty())
+                reference = rows;
+            ASSERT(rows == reference, std::string("Random rows should not depend on the kernel: ") +
+                Game::StepKernel::getVariantName(variant));
+        }
+        Game::StepKernel::setVariant(detected);
+        size_t population = 0;
+        for (const uint64_t word : reference) {
+            population += std::popcount(word);
+        }
+        ASSERT(population > 0.28 * 64 * cols && population < 0.32 * 64 * cols, "Density should match the probability");
+        ASSERT((reference[36] >> (cols % 64)) == 0, "Bits after the last column should be cleared");
+
+        // A seed gives the same cells on any engine and any number of threads
+        Game::HighPerformanceGrid large(400, 400, 400, 400, false);
+        large.randomize(0.25f, 1234);
+        Game::Grid small(40, 40, 40, 40, false);
+        small.randomize(0.25f, 1234);
+        std::vector<uint64_t> row(7);
+        for (int i = 0; i < 40; i++) {
+            Game::Random::bernoulliRow(row.data(), 400, Game::Random::threshold(0.25f), 1234, 0, i,
+                Game::Random::Stream::RANDOMIZE);
+            for (int j = 0; j < 400; j++) {
+                ASSERT(large.isAlive(i, j) == (row[j / 64] >> (j % 64) & 1), "Packed randomize should match the drawn rows");
+                if (j < 40)
+                    ASSERT(small.isAlive(i, j) == large.isAlive(i, j), "Grid randomize should match the packed engine");
+            }
+        }
+
+        // Stochastic rules: probabilities of 1 run the rule, a birth probability of 0 only lets cells die
+        Game::HighPerformanceGrid deterministic(large.getCells(), 400, 400, 400, 400, false);
+        Game::HighPerformanceGrid certain(large.getCells(), 400, 400, 400, 400, false);
+        certain.setStochastic(1, 1, 99);
+        ASSERT(!certain.isStochastic(), "Probabilities of 1 should be deterministic");
+        Game::HighPerformanceGrid barren(large.getCells(), 400, 400, 400, 400, false);
+        barren.setStochastic(0, 1, 99);
+        for (int generation = 0; generation < 3; generation++) {
+            const auto before = barren.getCells();
+            deterministic.step(true, false);
+            certain.step(true, false);
+            barren.step(true, false);
+            const auto after = barren.getCells();
+            for (int i = 0; i < 400; i++) {
+                for (int j = 0; j < 400; j++) {
+                    ASSERT(before[i][j] || !after[i][j], "No cell should be born");
+                }
+            }
+        }
+        ASSERT(certain.getCells() == deterministic.getCells(), "Probabilities of 1 should run the rule");
+
+        // A stochastic run does not depend on the threads or the kernel
+        std::vector<std::vector<std::vector<bool>>> runs;
+        for (const auto variant : {Game::StepKernel::Variant::SCALAR, detected}) {
+            Game::StepKernel::setVariant(variant);
+            Game::HighPerformanceGrid noisy(large.getCells(), 400, 400, 400, 400, false);
+            noisy.setStochastic(0.75f, 0.9f, 5);
+            Game::HighPerformanceGrid expected(large.getCells(), 400, 400, 400, 400, false);
+            for (int generation = 0; generation < 4; generation++) {
+                // Reference: the rule, then each row masked with the births and survivals drawn for it
+                auto cells = expected.getCells();
+                expected.step(true, false);
+                auto next = expected.getCells();
+                std::vector<uint64_t> births(7), survivals(7);
+                for (int i = 0; i < 400; i++) {
+                    Game::Random::bernoulliRow(births.data(), 400, Game::Random::threshold(0.75f), 5, generation, i,
+                        Game::Random::Stream::BIRTH);
+                    Game::Random::bernoulliRow(survivals.data(), 400, Game::Random::threshold(0.9f), 5, generation, i,
+                        Game::Random::Stream::SURVIVAL);
+                    for (int j = 0; j < 400; j++) {
+                        const bool kept = (cells[i][j] ? survivals[j / 64] : births[j / 64]) >> (j % 64) & 1;
+                        next[i][j] = next[i][j] && kept;
+                    }
+                }
+                expected = Game::HighPerformanceGrid(next, 400, 400, 400, 400, false);
+                noisy.step(true, false);
+            }
+            ASSERT(noisy.getCells() == expected.getCells(), "Stochastic step should match the drawn probabilities");
+            runs.push_back(noisy.getCells());
+        }
+        Game::StepKernel::setVariant(detected);
+        ASSERT(runs[0] == runs[1], "Stochastic runs should not depend on the kernel");
+
+        std::cout << "Random tests passed" << std::endl;
+    }
+
+    void UnitTests::testLeniaGrid() {
+        // The FFT should match the discrete Fourier transform
+        const int size = 64;
+        Game::FFT fft(size);
+        ASSERT(Game::FFT::nextPowerOfTwo(100) == 128 && Game::FFT::nextPowerOfTwo(64) == 64, "Sizes should be rounded up");
+        bool thrown = false;
+        try {
+            Game::FFT invalid(48);
+        } catch (const std::invalid_argument &) {
+            thrown = true;
+        }
+        ASSERT(thrown, "Sizes other than powers of two should be rejected");
+        std::vector<float> first(size), second(size);
+        std::vector<std::complex<float>> data(size);
+        for (int n = 0; n < size; n++) {
+            first[n] = std::sin(0.3f * n) + 0.1f * (n % 7);
+            second[n] = std::cos(0.7f * n) - 0.05f * (n % 5);
+            data[n] = {first[n], second[n]};
+        }
+        const auto signal = data;
+        fft.transform(data.data(), false);
+        for (int k = 0; k < size; k++) {
+            std::complex<double> expected;
+            for (int n = 0; n < size; n++) {
+                expected += std::complex<double>(signal[n]) * std::polar(1.0, -2 * std::numbers::pi * k * n / size);
+            }
+            ASSERT(std::abs(std::complex<double>(data[k]) - expected) < 1e-4, "FFT should match the DFT");
+        }
+
+        // Two real sequences should survive a round trip through their half spectra
+        std::vector<std::complex<float>> firstSpectrum(size / 2 + 1), secondSpectrum(size / 2 + 1), buffer(size);
+        fft.forwardReal(first.data(), second.data(), firstSpectrum.data(), secondSpectrum.data(), buffer.data());
+        std::vector<float> firstBack(size), secondBack(size);
+        fft.inverseReal(firstSpectrum.data(), secondSpectrum.data(), firstBack.data(), secondBack.data(), buffer.data());
+        for (int n = 0; n < size; n++) {
+            ASSERT(std::abs(firstBack[n] / size - first[n]) < 1e-5 && std::abs(secondBack[n] / size - second[n]) < 1e-5,
+                "Real transforms should round trip");
+        }
+
+        // Test the LeniaRule class
+        const Game::LeniaRule orbium;
+        ASSERT(Game::LeniaRule::parse("lenia") == orbium, "Default rule should be Orbium's");
+        ASSERT(Game::LeniaRule::parse("R=13;T=10;m=0.15;s=0.015;b=1") == orbium, "Full notation should be accepted");
+        ASSERT(Game::LeniaRule::parse("r=13;m=0.15;s=0.015") == orbium, "T and b should be optional");
+        const auto rings = Game::LeniaRule::parse("R=20;T=5;m=0.26;s=0.036;b=1,1/3");
+        ASSERT(rings.getPeaks().size() == 2 && std::abs(rings.getPeaks()[1] - 1.0f / 3) < 1e-6f, "Fractions should be accepted");
+        ASSERT(Game::LeniaRule::parse(orbium.toString()) == orbium, "Notation should round trip");
+        for (const std::string invalid : {"R=0;m=0.1;s=0.01", "R=13;m=x;s=0.1", "R=13;m=0.15", "R=13;m=0.1;s=0", "B3/S23", ""}) {
+            thrown = false;
+            try {
+                Game::LeniaRule::parse(invalid);
+            } catch (const std::invalid_argument &) {
+                thrown = true;
+            }
+            ASSERT(thrown, "Rule should be rejected: " + invalid);
+        }
+        ASSERT(orbium.kernel(0) == 0 && orbium.kernel(13) == 0 && std::abs(orbium.kernel(6.5f) - 1) < 1e-6f,
+            "Kernel should peak halfway");
+        ASSERT(orbium.growth(0.15f) == 1 && orbium.growth(1) < -0.99f, "Growth should peak at mu");
+
+        // The potential should match a direct convolution, with and without wrapping
+        const Game::LeniaRule small(4, 10, 0.2f, 0.05f, {1, 0.5f});
+        for (const auto &[rows, cols, wrap] : {std::tuple(16, 32, true), std::tuple(13, 21, true), std::tuple(13, 21, false), std::tuple(6, 5, true)}) {
+            Game::LeniaGrid grid(rows, cols, rows, cols, false);
+            grid.setRule(small);
+            grid.randomize(0.5f, 3);
+            const auto potential = grid.getPotential(wrap);
+            double total = 0;
+            for (int dy = -4; dy <= 4; dy++) {
+                for (int dx = -4; dx <= 4; dx++) {
+                    total += small.kernel(std::sqrt(static_cast<float>(dy * dy + dx * dx)));
+                }
+            }
+            for (int i = 0; i < rows; i++) {
+                for (int j = 0; j < cols; j++) {
+                    double expected = 0;
+                    for (int dy = -4; dy <= 4; dy++) {
+                        for (int dx = -4; dx <= 4; dx++) {
+                            int y = i + dy, x = j + dx;
+                            if (wrap) {
+                                y = (y % rows + rows) % rows;
+                                x = (x % cols + cols) % cols;
+                            }
+                            else if (y < 0 || y >= rows || x < 0 || x >= cols)
+                                continue;
+                            expected += small.kernel(std::sqrt(static_cast<float>(dy * dy + dx * dx))) * grid.getValue(y, x);
+                        }
+                    }
+                    ASSERT(std::abs(potential[i][j] - expected / total) < 1e-5, "Potential should match the convolution");
+                }
+            }
+        }
+
+        // An empty grid stays empty, a uniform grid stays uniform
+        Game::LeniaGrid empty(32, 32, 32, 32, false);
+        empty.step(true, false);
+        ASSERT(empty.getPopulation() == 0 && empty.getMass() == 0, "Empty grid should stay empty");
+        Game::LeniaGrid uniform(std::vector(16, std::vector(16, 0.16f)), 16, 16, 16, 16, false);
+        uniform.step(true, false);
+        const float expected = orbium.next(0.16f, 0.16f);
+        for (int i = 0; i < 16; i++) {
+            for (int j = 0; j < 16; j++) {
+                ASSERT(std::abs(uniform.getValue(i, j) - expected) < 1e-5f, "Uniform grid should follow the rule");
+            }
+        }
+
+        // A dynamic grid grows to keep the kernel around its cells
+        Game::LeniaGrid growing(std::vector(8, std::vector(8, 0.5f)), 8, 8, 100, 100, true);
+        growing.step(false, true);
+        ASSERT(growing.getRows() > 8 && growing.getCols() > 8, "Dynamic grid should grow");
+
+        // A seed gives the same cells, whose levels round trip through multi-state RLE
+        Game::LeniaGrid seeded(40, 40, 40, 40, false), again(40, 40, 40, 40, false);
+        seeded.randomize(0.3f, 8);
+        again.randomize(0.3f, 8);
+        ASSERT(seeded.getCells() == again.getCells() && seeded.getPopulation() > 0, "Randomize should depend on the seed only");
+        const auto levels = seeded.getLevels();
+        const auto values = Game::LeniaGrid::getValues(levels);
+        for (int i = 0; i < 40; i++) {
+            for (int j = 0; j < 40; j++) {
+                ASSERT(Game::LeniaGrid::getLevel(values[i][j]) == levels[i][j], "Levels should round trip");
+            }
+        }
+        ASSERT(Game::LeniaGrid::getValues({{0, 1, 1}})[0][1] == 1, "Two-state patterns should be fully alive");
+
+        std::cout << "LeniaGrid tests passed" << std::endl;
+    }
+
+    void UnitTests::testCycleDetector() {
+        // The hash updated from the changed cells should match the hash of the whole grid, on every engine
+        const auto checkUpdates = [](auto &grid, const bool wrap, const bool dynamic, const std::string &name) {
+            Game::CycleDetector incremental(16);
+            incremental.track(grid);
+            for (int generation = 0; generation < 40; generation++) {
+                grid.step(wrap, dynamic);
+                incremental.update(grid);
+                Game::CycleDetector full(16);
+                full.track(grid);
+                ASSERT(incremental.getHash() == full.getHash(), "Incremental hash should match the grid: " + name);
+            }
+        };
+        Game::Grid grid(48, 48, 80, 80, true);
+        grid.randomize(0.35f, 11);
+        const auto soup = grid.getCells();
+        checkUpdates(grid, false, true, "standard");
+        Game::HighPerformanceGrid packed(soup, 48, 48, 48, 48, false);
+        checkUpdates(packed, true, false, "packed");
+        Game::HashLifeGrid hashLife(soup, 48, 48);
+        checkUpdates(hashLife, false, false, "hashlife");
+        Game::TiledGrid tiled(soup, 48, 48);
+        checkUpdates(tiled, false, false, "tiled");
+        Game::LargerThanLifeGrid range(soup, 48, 48, 48, 48, false);
+        range.setRule(Game::LargerThanLifeRule::parse("R2,C0,M0,S3..5,B4..4,NN"));
+        checkUpdates(range, true, false, "larger than life");
+        Game::GenerationsGrid generations(48, 48, 48, 48, false);
+        generations.setRule(Game::GenerationsRule::parse("starwars"));
+        generations.randomize(0.35f);
+        checkUpdates(generations, true, false, "generations");
+
+        // Keys should not collide between neighbouring cells and states
+        std::set<uint64_t> keys;
+        for (int i = -8; i < 8; i++) {
+            for (int j = -8; j < 8; j++) {
+                for (uint32_t state = 1; state < 8; state++) {
+                    keys.insert(Game::CycleDetector::key(i, j, state));
+                }
+            }
+        }
+        ASSERT(keys.size() == 16 * 16 * 7, "Keys should be distinct");
+
+        // Periods: a block, a blinker, and a glider crossing a torus
+        const auto findPeriod = [](auto &grid, const uint64_t maxPeriod) -> std::optional<std::pair<uint64_t, uint64_t>> {
+            Game::CycleDetector detector(maxPeriod);
+            detector.track(grid);
+            detector.push(0);
+            for (uint64_t generation = 1; generation <= 200; generation++) {
+                grid.step(true, false);
+                detector.update(grid);
+                if (const auto cycle = detector.push(generation))
+                    return std::make_pair(cycle->period, generation);
+            }
+            return std::nullopt;
+        };
+        Game::Grid block(6, 6, 6, 6, false);
+        block.insert({{true, true}, {true, true}}, 2, 2);
+        ASSERT(findPeriod(block, 8) == std::make_pair(uint64_t{1}, uint64_t{1}), "Block should have a period of 1");
+        Game::HighPerformanceGrid blinker(8, 8, 8, 8, false);
+        blinker.insert({{true, true, true}}, 3, 2);
+        ASSERT(findPeriod(blinker, 8) == std::make_pair(uint64_t{2}, uint64_t{2}), "Blinker should have a period of 2");
+        const std::vector<std::vector<bool>> glider = {{false, true, false}, {false, false, true}, {true, true, true}};
+        Game::Grid torus(8, 8, 8, 8, false);
+        torus.insert(glider, 0, 0);
+        ASSERT(findPeriod(torus, 64) == std::make_pair(uint64_t{32}, uint64_t{32}), "Glider should cross the torus in 32 generations");
+        Game::Grid shortRing(8, 8, 8, 8, false);
+        shortRing.insert(glider, 0, 0);
+        ASSERT(!findPeriod(shortRing, 16), "Periods over the limit should not be detected");
+        Game::Grid disabled(6, 6, 6, 6, false);
+        disabled.insert({{true, true}, {true, true}}, 2, 2);
+        ASSERT(!findPeriod(disabled, 0), "A limit of 0 should disable the detection");
+
+        // Steps of several generations only show a multiple of the period
+        Game::HashLifeGrid strided(16, 16);
+        strided.insert({{true, true, true}}, 6, 6);
+        strided.setStepExponent(2);
+        Game::CycleDetector stridedDetector(64, 4);
+        stridedDetector.track(strided);
+        stridedDetector.push(strided.getGeneration());
+        strided.step();
+        stridedDetector.update(strided);
+        const auto multiple = stridedDetector.push(strided.getGeneration());
+        ASSERT((multiple == Game::CycleDetector::Cycle{4, 1, 0, 0, false}), "Blinker stepped by 4 should repeat after 4 generations, not exactly");
+
+        // Spaceships repeat translated on the unbounded engines
+        Game::TiledGrid ship(16, 16);
+        ship.insert(glider, 2, 2);
+        Game::CycleDetector shipDetector(16);
+        shipDetector.track(ship);
+        shipDetector.push(0);
+        std::optional<Game::CycleDetector::Cycle> found;
+        for (uint64_t generation = 1; generation <= 8 && !found; generation++) {
+            ship.step();
+            shipDetector.update(ship);
+            found = shipDetector.push(generation);
+        }
+        ASSERT((found == Game::CycleDetector::Cycle{4, 4, 1, 1}), "Glider should move by (1, 1) every 4 generations");
+
+        // A period is only confirmed once the cells repeat, then whole periods can be skipped
+        shipDetector.expect(ship, Game::CycleDetector::Cycle{4, 4, 0, 1});
+        for (int generation = 0; generation < 4; generation++) {
+            ASSERT(!shipDetector.confirm(ship), "Period should not be confirmed early");
+            ship.step();
+            shipDetector.update(ship);
+            shipDetector.push(9 + generation);
+        }
+        ASSERT(!shipDetector.confirm(ship), "Wrong displacement should not be confirmed");
+        shipDetector.expect(ship, *found);
+        for (int generation = 0; generation < 4; generation++) {
+            ship.step();
+            shipDetector.update(ship);
+            shipDetector.push(13 + generation);
+        }
+        ASSERT(shipDetector.confirm(ship) == found, "Glider period should be confirmed");
+
+        // Skipping periods should match stepping through them, on the unbounded and the bounded engines
+        Game::HashLifeGrid reference(16, 16);
+        reference.insert(glider, 2, 2);
+        reference.advance(ship.getGeneration() + 4000);
+        ASSERT(Game::CycleDetector::skip(ship, *found, 1000) == 4000, "1000 periods should skip 4000 generations");
+        ASSERT(Game::CycleDetector::collect(ship) == Game::CycleDetector::collect(reference), "Skipped glider should match HashLife");
+        Game::Grid oscillator(8, 8, 8, 8, false);
+        oscillator.insert({{true, true, true}}, 3, 2);
+        Game::Grid expectedOscillator = oscillator;
+        expectedOscillator.step(false, false);
+        ASSERT(Game::CycleDetector::skip(oscillator, {2, 2, 0, 0}, 50) == 100, "50 periods should skip 100 generations");
+        oscillator.step(false, false);
+        ASSERT(oscillator.getCells() == expectedOscillator.getCells(), "Skipped blinker should keep its phase");
+
+                std::cout << "CycleDetector tests passed" << std::endl;
+    }
+
+    void UnitTests::testThreadPool() {
+        // Test the ThreadPool class
+        Game::ThreadPool pool(4);
+        ASSERT(pool.getWorkerCount() == 4, "Pool should have 4 workers");
+        std::vector<int> visits(100003);
+        std::vector<long long> sums(pool.getWorkerCount());
+        for (int run = 0; run < 20; run++) {
+            pool.parallelFor(visits.size(), 1000, [&](const size_t begin, const size_t end, const int worker) {
+                for (size_t i = begin; i < end; i++) {
+                    visits[i]++;
+                    sums[worker] += static_cast<long long>(i);
+                }
+            });
+        }
+        ASSERT(std::all_of(visits.begin(), visits.end(), [](const int v) { return v == 20; }), "Every item should be visited once per run");
+        long long total = 0;
+        for (const long long sum : sums)
+            total += sum;
+        ASSERT(total == 20LL * 100002 * 100003 / 2, "Worker buffers should hold every item");
+
+        // Sparse grids above the threshold are stepped by the pool, and should match the packed engine
+        Game::HighPerformanceGrid reference(3500, 3500, 3500, 3500, false);
+        reference.randomize(0.01);
+        Game::Grid grid(reference.getCells(), 3500, 3500, 3500, 3500, false);
+        Game::ExtendedGrid extended(3500, 3500, 3500, 3500, false);
+        for (const auto &[row, col] : reference.getLivingCells())
+            extended.setAlive(row, col, true);
+        ASSERT(grid.getPopulation() > 100000, "Grid should be above the multithreaded threshold");
+        for (int i = 0; i < 3; i++) {
+            const bool wrap = i == 1;
+            reference.step(wrap, false);
+            grid.step(wrap, false);
+            extended.step(wrap, false);
+            ASSERT(grid.getLivingCells() == reference.getLivingCells(), "Multithreaded Grid should match");
+            ASSERT(extended.getLivingCells() == reference.getLivingCells(), "Multithreaded ExtendedGrid should match");
+        }
+
+        // Obstacles keep their state, the other cells follow the rules
+        for (const bool wrap : {false, true}) {
+            Game::ExtendedGrid dense(40, 70, 40, 70, false);
+            dense.randomize(0.4);
+            for (int i = 0; i < 40; i += 3) {
+                dense.insert({{Game::Cell(i % 2 == 0, true)}}, i, (i * 7) % 70);
+            }
+            const Game::ExtendedGrid previous = dense;
+            const auto previousCells = previous.getCells();
+            dense.step(wrap, false);
+            for (int i = 0; i < dense.getRows(); i++) {
+                for (int j = 0; j < dense.getCols(); j++) {
+                    const bool expected = previous.isObstacle(i, j) ? previous.isAlive(i, j) :
+                        previousCells[i][j].willBeAlive(previous.countNeighbors(i, j, wrap));
+                    ASSERT(dense.isAlive(i, j) == expected, "Dense ExtendedGrid step should follow the rules");
+                }
+            }
+        }
+
+        std::cout << "ThreadPool tests passed" << std::endl;
+    }
+
     void UnitTests::testParser() {
         // Test the Parser class
         File::Parser parser2(File::FormatConfig('O', '.', '\0'));
@@ -316,6 +1597,26 @@ namespace GameOfLife::Tests {
         grid2.setAlive(0, 2, true);
         writer.write(grid2, File::Utils::makeAbsolutePath("test_out.txt").string());
 
+        // The rule should survive a round trip through an RLE file
+        const auto rlePath = File::Utils::makeAbsolutePath("test_out.rle").string();
+        File::Writer::writeRLE(grid.getCells(), rlePath, "B36/S23");
+        int rows = 0;
+        int cols = 0;
+        std::string rule;
+        const auto cells = File::Parser::parseRLE(rlePath, rows, cols, rule);
+        ASSERT(rule == "B36/S23", "Rule should be read back");
+        ASSERT(cells[0][2] && !cells[0][3], "Cells should be read back");
+
+        // States should survive a round trip through a multi-state RLE file
+        const std::vector<std::vector<uint8_t>> states = {{0, 1, 1, 2, 24, 25, 48, 49, 255, 0}, {}, {3, 3, 3, 0, 0, 7}};
+        std::vector expected(3, std::vector<uint8_t>(10));
+        for (int i = 0; i < 3; i++) {
+            std::copy(states[i].begin(), states[i].end(), expected[i].begin());
+        }
+        File::Writer::writeStatesRLE(expected, rlePath, "B2/S/C256");
+        ASSERT(File::Parser::parseStatesRLE(rlePath, rows, cols, rule) == expected, "States should be read back");
+        ASSERT(rule == "B2/S/C256" && rows == 3 && cols == 10, "Header should be read back");
+
         std::cout << "Writer tests passed" << std::endl;
     }
 
@@ -331,6 +1632,126 @@ namespace GameOfLife::Tests {
         ASSERT(arguments.getOutputFolder() == "test", "Output file should be test.cells");
         ASSERT(arguments.isVerbose(), "Verbose should be true");
         ASSERT(arguments.getDelay() == 200, "Delay should be 200");
+        ASSERT(!arguments.getRule(), "Rule should be left to the input file");
+        ASSERT(arguments.resolveRule("").getPreset() == Game::Rule::CONWAY, "Rule should default to conway");
+        ASSERT(arguments.resolveRule("LifeHistory").getPreset() == Game::Rule::CONWAY, "Unsupported rules should fall back to conway");
+
+        // Test the rule names and notations
+        Game::IsotropicRule rule;
+        ASSERT(CLI::Arguments::parseRule("highlife", rule) && rule.getPreset() == Game::Rule::HIGHLIFE, "Rule should be highlife");
+        ASSERT(CLI::Arguments::parseRule("B3678/S34678", rule) && rule.getPreset() == Game::Rule::DAY_AND_NIGHT, "Rule should be day and night");
+        ASSERT(CLI::Arguments::parseRule("b3/s23", rule) && rule.getPreset() == Game::Rule::CONWAY, "Lowercase notation should be accepted");
+        ASSERT(CLI::Arguments::parseRule("23/3", rule) && rule.getPreset() == Game::Rule::CONWAY, "S/B notation should be accepted");
+        ASSERT(CLI::Arguments::parseRule("S23/B3", rule) && rule.getPreset() == Game::Rule::CONWAY, "Swapped notation should be accepted");
+        ASSERT(CLI::Arguments::parseRule("Life", rule) && rule.getPreset() == Game::Rule::CONWAY, "Life should be conway");
+        ASSERT(CLI::Arguments::parseRule("B3/S23:T100,100", rule) && rule.getPreset() == Game::Rule::CONWAY, "Topology suffix should be ignored");
+        ASSERT(CLI::Arguments::parseRule("B2/S", rule) && rule.toString() == "B2/S", "Rule should be normalized");
+        ASSERT(CLI::Arguments::parseRule("125/36", rule) && rule.toString() == "B36/S125", "Rule should be normalized");
+        ASSERT(!CLI::Arguments::parseRule("unknown", rule), "Rule should be invalid");
+        ASSERT(!CLI::Arguments::parseRule("B03/S23", rule), "B0 should be rejected");
+        ASSERT(!CLI::Arguments::parseRule("B9/S23", rule), "Counts above 8 should be rejected");
+        ASSERT(CLI::Arguments::parseRule("b2n3/s23-q", rule) && !rule.isTotalistic(), "Hensel notation should be accepted");
+        ASSERT(rule.toString() == "B2n3/S23-q", "Hensel notation should be normalized");
+        ASSERT(CLI::Arguments::parseRule("B2-aceik3/S2ceaikn3ceaiknjry", rule) && rule.toString() == "B2n3/S23-q", "Rule should be normalized");
+        ASSERT(CLI::Arguments::parseRule("B3ceaiknjqry/S23", rule) && rule.getPreset() == Game::Rule::CONWAY, "Rule should be outer-totalistic");
+        ASSERT(!CLI::Arguments::parseRule("B2x/S23", rule), "Unknown letters should be rejected");
+        ASSERT(!CLI::Arguments::parseRule("B1k/S23", rule), "Letters of another count should be rejected");
+        ASSERT(!CLI::Arguments::parseRule("B3/S23-", rule), "Empty exclusions should be rejected");
+
+        // Stochastic mode
+        std::pair<float, float> probabilities;
+        ASSERT(CLI::Arguments::parseStochastic("0.5", probabilities) && probabilities == std::make_pair(0.5f, 1.0f),
+            "Survival probability should default to 1");
+        ASSERT(CLI::Arguments::parseStochastic("0.25,0.75", probabilities) && probabilities == std::make_pair(0.25f, 0.75f),
+            "Both probabilities should be read");
+        for (const std::string invalid : {"", "1.5", "0.5,", "0.5,x", "a", "0.5x"}) {
+            ASSERT(!CLI::Arguments::parseStochastic(invalid, probabilities), "Probabilities should be rejected: " + invalid);
+        }
+        std::vector<std::string> stochasticArgs = {"GameOfLife", "-c", "0.9,0.8", "-z", "77", "test.txt", "test"};
+        std::vector<char*> stochasticCArgs;
+        for (auto &arg : stochasticArgs) {
+            stochasticCArgs.push_back(&arg[0]);
+        }
+        const auto stochasticArguments = CLI::Arguments::parse(stochasticCArgs.size(), stochasticCArgs.data());
+        ASSERT(stochasticArguments.getStochastic() && stochasticArguments.getStochastic()->first == 0.9f, "Stochastic mode should be enabled");
+        ASSERT(stochasticArguments.getSeed() == 77, "Seed should be 77");
+        ASSERT(stochasticArguments.getMaxPeriod() == 64, "Maximum period should default to 64");
+        stochasticArgs = {"GameOfLife", "-l", "500", "test.txt", "test"};
+        stochasticCArgs.clear();
+        for (auto &arg : stochasticArgs) {
+            stochasticCArgs.push_back(&arg[0]);
+        }
+        ASSERT(CLI::Arguments::parse(stochasticCArgs.size(), stochasticCArgs.data()).getMaxPeriod() == 500, "Maximum period should be 500");
+
+        // Multi-state rules select their own engine
+        ASSERT(arguments.resolveGenerationsRule("LifeHistory")->isHistory(), "LifeHistory should use the Generations engine");
+        ASSERT(!arguments.resolveGenerationsRule("B3/S23"), "Two-state rules should not use the Generations engine");
+        Game::GenerationsRule generations;
+        ASSERT(CLI::Arguments::parseRule("briansbrain", generations) && generations.getStates() == 3, "Brian's Brain should be accepted");
+
+        // Larger than Life rules select their own engine
+        ASSERT(!arguments.resolveRangeRule(""), "Life-like rules should not use the Larger than Life engine");
+        ASSERT(arguments.resolveRangeRule("R5,C0,M1,S34..58,B34..45,NM") == Game::LargerThanLifeRule(), "Rule of the file should be used");
+        args = {"GameOfLife", "-r", "R2,C0,M0,S3..5,B4..4,NN", "test.txt", "test"};
+        cstr_args.clear();
+        for (auto& arg : args) {
+            cstr_args.push_back(&arg[0]);
+        }
+        arguments = CLI::Arguments::parse(cstr_args.size(), cstr_args.data());
+        ASSERT(arguments.isValid() && arguments.getRangeRule(), "Larger than Life rule should be accepted");
+        ASSERT(arguments.resolveRangeRule("B3/S23")->getNeighborhood() == Game::LargerThanLifeRule::Neighborhood::VON_NEUMANN,
+            "Command line rule should override the file");
+
+        // Lenia rules select their own engine
+        ASSERT(!arguments.resolveLeniaRule("lenia"), "Command line rule should override the file");
+        args = {"GameOfLife", "-r", "R=13;T=10;m=0.15;s=0.015;b=1", "test.txt", "test"};
+        cstr_args.clear();
+        for (auto& arg : args) {
+            cstr_args.push_back(&arg[0]);
+        }
+        arguments = CLI::Arguments::parse(cstr_args.size(), cstr_args.data());
+        ASSERT(arguments.isValid() && arguments.getLeniaRule() == Game::LeniaRule(), "Lenia rule should be accepted");
+        ASSERT(!arguments.getRule() && !arguments.getRangeRule() && !arguments.getGenerationsRule(), "Lenia rule should be the only rule");
+        ASSERT(!arguments.resolveGenerationsRule("LifeHistory") && arguments.resolveLeniaRule("B3/S23"), "Lenia rule should be used");
+        Game::LeniaRule lenia;
+        ASSERT(!CLI::Arguments::parseRule("B3/S23", lenia), "Life-like rules should not be Lenia rules");
+
+        // Topologies
+        Game::Topology topology;
+        ASSERT(CLI::Arguments::parseTopology("klein", topology) && topology == Game::Topology::KLEIN_BOTTLE, "Topology should be klein");
+        ASSERT(!CLI::Arguments::parseTopology("sphere", topology), "Topology should be invalid");
+        ASSERT(!arguments.doWarp() && arguments.getTopology() == Game::Topology::TORUS, "Warp should default to a torus");
+        args = {"GameOfLife", "-o", "cross", "test.txt", "test"};
+        cstr_args.clear();
+        for (auto& arg : args) {
+            cstr_args.push_back(&arg[0]);
+        }
+        arguments = CLI::Arguments::parse(cstr_args.size(), cstr_args.data());
+        ASSERT(arguments.doWarp() && arguments.getTopology() == Game::Topology::CROSS_SURFACE, "Topology should wrap");
+        args = {"GameOfLife", "-w", "--topology", "plane", "test.txt", "test"};
+        cstr_args.clear();
+        for (auto& arg : args) {
+            cstr_args.push_back(&arg[0]);
+        }
+        ASSERT(!CLI::Arguments::parse(cstr_args.size(), cstr_args.data()).doWarp(), "Plane should not wrap");
+
+        // Temporal blocking
+        ASSERT(arguments.getBlockDepth() == 1, "Block depth should default to 1");
+        args = {"GameOfLife", "-j", "auto", "test.txt", "test"};
+        cstr_args.clear();
+        for (auto& arg : args) {
+            cstr_args.push_back(&arg[0]);
+        }
+        ASSERT(CLI::Arguments::parse(cstr_args.size(), cstr_args.data()).getBlockDepth() == 0, "Automatic block depth should be 0");
+
+        // Tile cache
+        ASSERT(arguments.getTileCache() == 0, "Tile cache should be disabled by default");
+        args = {"GameOfLife", "-q", "4096", "test.txt", "test"};
+        cstr_args.clear();
+        for (auto& arg : args) {
+            cstr_args.push_back(&arg[0]);
+        }
+        ASSERT(CLI::Arguments::parse(cstr_args.size(), cstr_args.data()).getTileCache() == 4096, "Tile cache size should be parsed");
 
         std::cout << "Arguments tests passed" << std::endl;
     }
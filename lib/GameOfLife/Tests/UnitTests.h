@@ -13,8 +13,20 @@ namespace GameOfLife::Tests {
         static void run();
 
         static void testCell();
+        static void testCoordinateSet();
         static void testGrid();
         static void testExtendedGrid();
+        static void testHighPerformanceGrid();
+        static void testStepKernel();
+        static void testHashLifeGrid();
+        static void testTiledGrid();
+        static void testBatchGrid();
+        static void testLargerThanLifeGrid();
+        static void testGenerationsGrid();
+        static void testRandom();
+        static void testLeniaGrid();
+        static void testCycleDetector();
+        static void testThreadPool();
 
         static void testParser();
         static void testExtendedParser();
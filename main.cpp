@@ -1,5 +1,6 @@
 #include "CLI/Main.h"
 #include "GUI/Main.h"
+#include "Tests/Benchmarks.h"
 #include "Tests/UnitTests.h"
 
 
@@ -11,6 +12,8 @@ int main(int argc, char *argv[]) {
         gui.start();
     } else if (args.doUnitTests())
         GameOfLife::Tests::UnitTests::run();
+    else if (args.doBenchmarks())
+        GameOfLife::Tests::Benchmarks::run();
     else
         GameOfLife::CLI::Main::start(args);
 